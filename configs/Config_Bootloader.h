@@ -38,5 +38,11 @@
  #define BOOTLOADER_BAUD						19200					/**< USART baud rate used by the bootloader. */
 
  #define BOOTLOADER_FILE_FORMAT					HEX_FORMAT_INTEL		/**< Use the Intel Hex-Format as input file. */
+ #define BOOTLOADER_WINDOW						2						/**< Number of page buffers and unacknowledged packets for the binary format. */
+ #define BOOTLOADER_TIMEOUT						50000					/**< Receive timeout in polling loops for the binary format. */
+ #undef BOOTLOADER_USE_COMPRESSION										/**< Define this symbol to receive LZSS compressed images with the binary format. */
+ #define BOOTLOADER_LZSS_WINDOW_BITS			8						/**< Size of the LZSS history window in bits. Must match the packer. */
+ #define BOOTLOADER_LZSS_LENGTH_BITS			4						/**< Size of the LZSS length field in bits. Must match the packer. */
+ #undef BOOTLOADER_USE_DELTA											/**< Define this symbol to apply page patches to the installed application with the binary format. */
 
 #endif /* CONFIG_BOOTLOADER_H_ */
\ No newline at end of file
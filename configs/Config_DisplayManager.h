@@ -49,6 +49,24 @@
  #define DISPLAY_HEIGHT								32							/**< Height of the display in pixel. */
  #define DISPLAY_PIXEL_PER_BYTE						8							/**< Number of pixel which can fit into one byte. */
 
+ // Display manager definitions
+ #undef DISPLAYMANAGER_USE_DEFERRED												/**< Set to draw into the frame buffer only. \n
+																				 NOTE: Call #DisplayManager_Flush to update the display */
+ #undef DISPLAYMANAGER_USE_DMA													/**< Set to enable the DMA refresh of the display. \n
+																				 NOTE: Only available for XMega architecture */
+ #define DISPLAYMANAGER_DMA_CHANNEL					DMA.CH0						/**< DMA channel used by the display manager. \n
+																				 NOTE: Only used when #DISPLAYMANAGER_USE_DMA is set */
+ #define DISPLAYMANAGER_DMA_TRIGGER					DMA_TRIGGER_USARTD0_DRE		/**< DMA trigger source for the display interface. \n
+																				 NOTE: Only used when #DISPLAYMANAGER_USE_DMA is set */
+ #define DISPLAYMANAGER_DMA_INT_LEVEL				INT_LVL_LO					/**< Interrupt level for the DMA channel. \n
+																				 NOTE: Only used when #DISPLAYMANAGER_USE_DMA is set */
+ #undef DISPLAYMANAGER_DMA_DOUBLE_BUFFER										/**< Set to use a second buffer for the DMA transmission. \n
+																				 NOTE: Only used when #DISPLAYMANAGER_USE_DMA is set */
+ #undef DISPLAYMANAGER_USE_GLYPH_CACHE											/**< Set to cache pre-shifted characters for the text output. */
+ #define DISPLAYMANAGER_GLYPH_CACHE_SIZE			8							/**< Number of characters in the glyph cache. \n
+																				 NOTE: Only used when #DISPLAYMANAGER_USE_GLYPH_CACHE is set */
+ #undef DISPLAYMANAGER_USE_STATISTICS											/**< Set to count the bytes and commands sent to the display. */
+
 /*
  #define USE_ST7565R
 
@@ -37,8 +37,33 @@
 																					 won't exclude the clock selection part. */
 
  #define USART_BUFFER_SIZE							32							/**< Size of USART buffer in bytes. */
+ #undef USART_USE_RX_BUFFER														/**< Define this symbol to store the received bytes in a ring buffer. */
+ #define USART_RX_BUFFER_SIZE						64							/**< Size of USART receive buffer in bytes. Must be a power of two (max. 128). \n
+																				 NOTE: Only used when #USART_USE_RX_BUFFER is set. */
+ #undef USART_PRINTF_DIVIDE_FREE												/**< Define this symbol to convert decimal numbers without divisions in #USART_Printf. */
+ #undef USART_USE_DMA															/**< Define this symbol to enable the DMA transmission and reception. */
+ #define USART_DMA_TX_CHANNEL						DMA.CH0						/**< DMA channel for the transmission. \n
+																				 NOTE: Only used when #USART_USE_DMA is set. */
+ #define USART_DMA_RX_CHANNEL						DMA.CH1						/**< DMA channel for the reception. \n
+																				 NOTE: Only used when #USART_USE_DMA is set. */
+ #define USART_DMA_INT_LEVEL						INT_LVL_LO					/**< Interrupt level for the DMA and the idle timer. \n
+																				 NOTE: Only used when #USART_USE_DMA is set. */
+ #define USART_DMA_RX_BUFFER_SIZE					128							/**< Size of the DMA receive buffer in bytes. \n
+																				 NOTE: Only used when #USART_USE_DMA is set. */
  #define DMA_BUFFER_SIZE							32							/**< Size of the DMA buffer. */
  #define SPI_BUFFER_SIZE							32							/**< Size of SPI buffer in bytes. */
+ #undef SPIM_USE_QUEUE															/**< Define this symbol to enable the transaction queue for the SPI master. */
+ #undef SPIM_USE_DMA															/**< Define this symbol to enable the DMA transmission for the SPI transaction queue. */
+ #define SPIM_DMA_CHANNEL							DMA.CH1						/**< DMA channel for the SPI transmission. \n
+																				 NOTE: Only used when #SPIM_USE_DMA is set. */
+ #define SPIM_DMA_INT_LEVEL							INT_LVL_LO					/**< Interrupt level for the DMA. \n
+																				 NOTE: Only used when #SPIM_USE_DMA is set. */
+ #define SPIM_DMA_THRESHOLD							16							/**< Min. length of a write transaction for the DMA transmission. \n
+																				 NOTE: Only used when #SPIM_USE_DMA is set. */
  #define TWI_BUFFER_SIZE							32							/**< Size of TWI buffer in bytes. */
+ #undef I2CM_USE_QUEUE															/**< Define this symbol to enable the transaction queue for the TWI master. */
+ #define KVS_FIRST_PAGE								0							/**< First EEPROM page for the key/value store. */
+ #define KVS_PAGES									8							/**< Number of EEPROM pages for the key/value store. */
+ #define KVS_MAX_KEYS								16							/**< Max. number of keys in the key/value store. */
 
 #endif /* CONFIG_LIBXMEHA384C3_H_ */
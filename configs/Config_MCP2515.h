@@ -58,4 +58,11 @@
  #undef MCP2515_EXT_TX2														/**< Pin used for external transmission request for buffer 2. \n
 																				 NOTE: Only used when #MCP2515_USE_EXT_TX is set */
 
+ #undef MCP2515_USE_RX_FIFO												/**< Set to copy all received messages into a FIFO in the interrupt handler. */
+ #define MCP2515_RX_FIFO_SIZE					16							/**< Number of messages in the receive FIFO. \n
+																				 NOTE: Must be a power of two. */
+ #undef MCP2515_USE_TX_QUEUE												/**< Set to use a transmit queue which is refilled by the transmit interrupt. */
+ #define MCP2515_TX_QUEUE_SIZE					16							/**< Number of messages in the transmit queue. */
+ #undef MCP2515_USE_STATISTICS												/**< Set to count the SPI traffic and the transmitted and received frames. */
+
 #endif /* CONFIG_MCP2515_H_ */
\ No newline at end of file
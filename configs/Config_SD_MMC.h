@@ -56,5 +56,28 @@
 	SD/MMC settings
  */
  #define SD_BLOCK_SIZE							512							/**< Block size for the SD card. */
+ #define SD_CLOCK								8000000UL					/**< SPI clock for the SD card after the initialization. \n
+																				 NOTE: The clock of the interface configuration is used when not defined. */
+ #define SD_BUSY_TIMEOUT						250000UL					/**< Maximum number of busy polls after a write before #SD_TIMEOUT is returned. \n
+																				 NOTE: One poll takes 8 SPI clock cycles (250 ms at 8 MHz). */
+ #undef SD_USE_STATISTICS													/**< Set to enable the write statistics. */
+ #undef SD_USE_CRC															/**< Set to enable the CRC check for commands and data blocks. */
+
+ #undef SD_USE_DMA															/**< Set to enable the asynchronous block transfers with the DMA. \n
+																				 NOTE: Only supported for XMega devices with an USART-SPI interface. */
+ #define SD_DMA_TX_CHANNEL						DMA.CH2						/**< DMA channel for the transmission. */
+ #define SD_DMA_RX_CHANNEL						DMA.CH3						/**< DMA channel for the reception. */
+ #define SD_DMA_TX_TRIGGER						DMA_TRIGGER_USARTD0_DRE		/**< DMA trigger source for the transmission. */
+ #define SD_DMA_RX_TRIGGER						DMA_TRIGGER_USARTD0_RXC		/**< DMA trigger source for the reception. */
+ #define SD_DMA_INT_LEVEL						INT_LVL_LO					/**< Interrupt level for the DMA transfer complete interrupt. */
+
+ /*
+	FatFs disk cache
+ */
+ #undef FATFS_USE_CACHE														/**< Set to enable the write-back sector cache between FatFs and the SD card. \n
+																				 NOTE: Use CTRL_SYNC (f_sync, f_close) to write the modified sectors to the card. */
+ #define FATFS_CACHE_SECTORS					4							/**< Number of cached sectors. */
+ #undef FATFS_CACHE_ADDRESS													/**< Set to the address of an external SRAM for the cache memory. \n
+																				 NOTE: A static buffer is used when not defined. */
 
 #endif /* CONFIG_SD_MMC_H_ */
\ No newline at end of file
@@ -0,0 +1,77 @@
+import sys
+import zlib
+import struct
+import argparse
+
+from Packer import ReadHex
+
+# Create the patch for one page. The rest of the page is copied from the old page when the patch ends
+def CreatePatch(Old, New):
+	Patch = bytearray()
+	Position = 0
+
+	# Remove the unchanged bytes at the end of the page
+	End = len(New)
+	while((End > 0) and (Old[End - 1] == New[End - 1])):
+		End -= 1
+
+	while(Position < End):
+		# Copy the unchanged bytes from the old page
+		Start = Position
+		while((Position < End) and (Old[Position] == New[Position]) and (Position - Start < 128)):
+			Position += 1
+
+		if(Position > Start):
+			Patch.append(Position - Start - 1)
+			continue
+
+		# Replace the changed bytes. Short unchanged gaps are cheaper as data bytes
+		Start = Position
+		while((Position < End) and (Position - Start < 128)):
+			if(Old[Position:Position + 3] == New[Position:Position + 3]):
+				break
+			Position += 1
+
+		Patch.append(0x80 | (Position - Start - 1))
+		Patch.extend(New[Start:Position])
+
+	return Patch
+
+if(__name__ == "__main__"):
+	Parser = argparse.ArgumentParser(description = "Create the page patches for a differential update with the binary bootloader format.")
+	Parser.add_argument("Old", help = "Intel HEX file of the installed application")
+	Parser.add_argument("New", help = "Intel HEX file of the new application")
+	Parser.add_argument("Output", help = "Patch file")
+	Parser.add_argument("-p", "--page", type = int, default = 512, help = "Flash page size in bytes (APP_SECTION_PAGE_SIZE)")
+	Args = Parser.parse_args()
+
+	Old = ReadHex(Args.Old)
+	New = ReadHex(Args.New)
+	Pages = 0
+
+	# The patch file contains one record per changed page: | Page (2) | Length (2) | Patch (Length) |
+	with open(Args.Output, "wb") as File:
+		for Page in range((len(New) + Args.page - 1) // Args.page):
+			Start = Page * Args.page
+			NewPage = New[Start:Start + Args.page]
+			NewPage.extend(b"\xFF" * (Args.page - len(NewPage)))
+
+			# Only the bytes of the old image are known. Everything behind the old image is replaced
+			OldPage = bytearray(Old[Start:Start + Args.page])
+			Known = len(OldPage)
+			OldPage.extend(b"\x00" * (Args.page - len(OldPage)))
+			for i in range(Known, Args.page):
+				OldPage[i] = NewPage[i] ^ 0xFF
+
+			if(OldPage == NewPage):
+				continue
+
+			Patch = CreatePatch(OldPage, NewPage)
+			File.write(struct.pack("<HH", Page, len(Patch)) + Patch)
+			Pages += 1
+			print("[DEBUG] Page {}: {} bytes".format(Page, len(Patch)))
+
+	# The base packet contains the length and the CRC-32 of the installed application
+	print("[DEBUG] Changed pages: {} of {}".format(Pages, (len(New) + Args.page - 1) // Args.page))
+	print("[DEBUG] Base packet data: {}".format((len(Old).to_bytes(4, "little") + (zlib.crc32(Old) & 0xFFFFFFFF).to_bytes(4, "little")).hex()))
+	print("[DEBUG] End packet data: {}".format((len(New).to_bytes(4, "little") + (zlib.crc32(New) & 0xFFFFFFFF).to_bytes(4, "little")).hex()))
@@ -0,0 +1,137 @@
+import sys
+import zlib
+import argparse
+
+# Read an Intel HEX file and return the binary image
+def ReadHex(File):
+	Image = bytearray()
+	Offset = 0
+
+	with open(File, "r") as Hex:
+		for Line in Hex:
+			Line = Line.strip()
+			if(not(Line.startswith(":"))):
+				continue
+
+			Record = bytes.fromhex(Line[1:])
+			if((sum(Record) & 0xFF) != 0):
+				raise ValueError("Invalid checksum in line '{}'".format(Line))
+
+			Length = Record[0]
+			Address = (Record[1] << 8) | Record[2]
+			Type = Record[3]
+			Data = Record[4:4 + Length]
+
+			if(Type == 0x00):
+				Address += Offset
+				if(len(Image) < Address + Length):
+					Image.extend(b"\xFF" * (Address + Length - len(Image)))
+				Image[Address:Address + Length] = Data
+			elif(Type == 0x01):
+				break
+			elif(Type == 0x02):
+				Offset = ((Data[0] << 8) | Data[1]) << 4
+			elif(Type == 0x04):
+				Offset = ((Data[0] << 8) | Data[1]) << 16
+
+	# The flash is programmed with words
+	if(len(Image) & 0x01):
+		Image.append(0xFF)
+
+	return Image
+
+# Write a bit stream with the MSB first
+class BitWriter:
+	def __init__(self):
+		self.Data = bytearray()
+		self.Byte = 0
+		self.Bits = 0
+
+	def Write(self, Value, Bits):
+		for i in reversed(range(Bits)):
+			self.Byte = (self.Byte << 1) | ((Value >> i) & 0x01)
+			self.Bits += 1
+			if(self.Bits == 8):
+				self.Data.append(self.Byte)
+				self.Byte = 0
+				self.Bits = 0
+
+	def Flush(self):
+		# Fill the last byte with zeros. The decoder stops with an incomplete back reference
+		if(self.Bits > 0):
+			self.Data.append(self.Byte << (8 - self.Bits))
+			self.Byte = 0
+			self.Bits = 0
+
+		return self.Data
+
+# Compress the image with LZSS. Matches are searched with a hash chain over the last two bytes
+def Compress(Image, WindowBits, LengthBits):
+	WindowSize = 1 << WindowBits
+	MaxLength = (1 << LengthBits) + 1
+	Chains = {}
+	Writer = BitWriter()
+	Position = 0
+
+	def Insert(Index):
+		if(Index + 1 < len(Image)):
+			Chains.setdefault(bytes(Image[Index:Index + 2]), []).append(Index)
+
+	while(Position < len(Image)):
+		BestLength = 0
+		BestOffset = 0
+
+		for Candidate in reversed(Chains.get(bytes(Image[Position:Position + 2]), [])):
+			Offset = Position - Candidate
+			if(Offset > WindowSize):
+				break
+
+			Length = 0
+			while((Length < MaxLength) and (Position + Length < len(Image)) and (Image[Candidate + Length] == Image[Position + Length])):
+				Length += 1
+
+			if(Length > BestLength):
+				BestLength = Length
+				BestOffset = Offset
+				if(Length == MaxLength):
+					break
+
+		if(BestLength >= 2):
+			Writer.Write(0, 1)
+			Writer.Write(BestOffset - 1, WindowBits)
+			Writer.Write(BestLength - 2, LengthBits)
+		else:
+			BestLength = 1
+			Writer.Write(1, 1)
+			Writer.Write(Image[Position], 8)
+
+		for i in range(BestLength):
+			Insert(Position + i)
+
+		Position += BestLength
+
+	return Writer.Flush()
+
+if(__name__ == "__main__"):
+	Parser = argparse.ArgumentParser(description = "Compress an Intel HEX file for the binary bootloader format.")
+	Parser.add_argument("Input", help = "Intel HEX file")
+	Parser.add_argument("Output", help = "Compressed image")
+	Parser.add_argument("-w", "--window", type = int, default = 8, help = "History window in bits (BOOTLOADER_LZSS_WINDOW_BITS)")
+	Parser.add_argument("-l", "--length", type = int, default = 4, help = "Length field in bits (BOOTLOADER_LZSS_LENGTH_BITS)")
+	Args = Parser.parse_args()
+
+	if(Args.length > 7):
+		print("[DEBUG] The length field must not be larger than 7 bits!")
+		sys.exit(-1)
+
+	Image = ReadHex(Args.Input)
+	Compressed = Compress(Image, Args.window, Args.length)
+
+	with open(Args.Output, "wb") as File:
+		File.write(Compressed)
+
+	# The end packet contains the image length and the CRC-32 of the image
+	print("[DEBUG] Image length: {} bytes".format(len(Image)))
+	print("[DEBUG] Compressed length: {} bytes ({:.1f} %)".format(len(Compressed), 100.0 * len(Compressed) / max(len(Image), 1)))
+	print("[DEBUG] Image CRC-32: 0x{:08X}".format(zlib.crc32(Image) & 0xFFFFFFFF))
+	print("[DEBUG] End packet data: {}".format((len(Image).to_bytes(4, "little") + (zlib.crc32(Image) & 0xFFFFFFFF).to_bytes(4, "little")).hex()))
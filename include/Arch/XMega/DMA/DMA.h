@@ -441,4 +441,44 @@
   */
  void DMA_Channel_RepeatTransfer(DMA_CH_t* Channel);
 
+ /** @brief				Check if two drivers use the same DMA channel.
+  *  @param ChannelA	First DMA channel
+  *  @param ChannelB	Second DMA channel
+  */
+ #define DMA_SAME_CHANNEL(ChannelA, ChannelB)				(&(ChannelA) == &(ChannelB))
+
+ /*
+	 Each DMA channel can only be used by one driver
+ */
+ #if(defined USART_USE_DMA)
+	 _Static_assert(!DMA_SAME_CHANNEL(USART_DMA_TX_CHANNEL, USART_DMA_RX_CHANNEL), "The USART transmission and reception use the same DMA channel!");
+
+	 #if(defined DISPLAYMANAGER_USE_DMA)
+		 _Static_assert(!DMA_SAME_CHANNEL(USART_DMA_TX_CHANNEL, DISPLAYMANAGER_DMA_CHANNEL) && !DMA_SAME_CHANNEL(USART_DMA_RX_CHANNEL, DISPLAYMANAGER_DMA_CHANNEL), "The USART and the display manager use the same DMA channel!");
+	 #endif
+
+	 #if(defined SD_USE_DMA)
+		 _Static_assert(!DMA_SAME_CHANNEL(USART_DMA_TX_CHANNEL, SD_DMA_TX_CHANNEL) && !DMA_SAME_CHANNEL(USART_DMA_TX_CHANNEL, SD_DMA_RX_CHANNEL) &&
+						!DMA_SAME_CHANNEL(USART_DMA_RX_CHANNEL, SD_DMA_TX_CHANNEL) && !DMA_SAME_CHANNEL(USART_DMA_RX_CHANNEL, SD_DMA_RX_CHANNEL), "The USART and the SD card use the same DMA channel!");
+	 #endif
+ #endif
+
+ #if((defined SPIM_USE_QUEUE) && (defined SPIM_USE_DMA))
+	 #if(defined USART_USE_DMA)
+		 _Static_assert(!DMA_SAME_CHANNEL(SPIM_DMA_CHANNEL, USART_DMA_TX_CHANNEL) && !DMA_SAME_CHANNEL(SPIM_DMA_CHANNEL, USART_DMA_RX_CHANNEL), "The SPI master and the USART use the same DMA channel!");
+	 #endif
+
+	 #if(defined DISPLAYMANAGER_USE_DMA)
+		 _Static_assert(!DMA_SAME_CHANNEL(SPIM_DMA_CHANNEL, DISPLAYMANAGER_DMA_CHANNEL), "The SPI master and the display manager use the same DMA channel!");
+	 #endif
+
+	 #if(defined SD_USE_DMA)
+		 _Static_assert(!DMA_SAME_CHANNEL(SPIM_DMA_CHANNEL, SD_DMA_TX_CHANNEL) && !DMA_SAME_CHANNEL(SPIM_DMA_CHANNEL, SD_DMA_RX_CHANNEL), "The SPI master and the SD card use the same DMA channel!");
+	 #endif
+ #endif
+
+ #if((defined DISPLAYMANAGER_USE_DMA) && (defined SD_USE_DMA))
+	 _Static_assert(!DMA_SAME_CHANNEL(DISPLAYMANAGER_DMA_CHANNEL, SD_DMA_TX_CHANNEL) && !DMA_SAME_CHANNEL(DISPLAYMANAGER_DMA_CHANNEL, SD_DMA_RX_CHANNEL), "The display manager and the SD card use the same DMA channel!");
+ #endif
+
 #endif /* DMA_H_ */
\ No newline at end of file
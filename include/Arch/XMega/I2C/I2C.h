@@ -230,6 +230,40 @@
 	 volatile I2C_MasterStatus_t Status;		/**< Device status */
  } I2C_Message_t;
 
+ #if(defined I2CM_USE_QUEUE)
+	 /** @brief I2C transaction status for the transaction queue.
+	  */
+	 typedef enum
+	 {
+		 I2CM_TRANSACTION_PENDING = 0x00,		/**< Transaction is queued or active */
+		 I2CM_TRANSACTION_COMPLETE = 0x01,		/**< Transaction successfully completed */
+		 I2CM_TRANSACTION_ERROR = 0xFF,			/**< Transaction aborted with an error */
+	 } I2CM_TransactionStatus_t;
+
+	 typedef struct I2CM_Transaction I2CM_Transaction_t;
+
+	 /** @brief				Transaction complete callback definition.
+	  *  @param Transaction	Pointer to completed transaction
+	  */
+	 typedef void (*I2CM_TransactionCallback_t)(I2CM_Transaction_t* Transaction);
+
+	 /** @brief I2C transaction object for the transaction queue.
+				NOTE: The object and the buffers are owned by the caller and have to be valid until the transaction is complete.
+	  */
+	 struct I2CM_Transaction
+	 {
+		 uint8_t Address;							/**< Slave address */
+		 const uint8_t* WriteData;					/**< Pointer to write buffer */
+		 uint8_t WriteLength;						/**< Bytes to write */
+		 uint8_t* ReadData;							/**< Pointer to read buffer */
+		 uint8_t ReadLength;						/**< Bytes to read after the write phase (with repeated start) */
+		 I2CM_TransactionCallback_t Callback;		/**< Function pointer to transaction complete callback. Can be #NULL */
+		 volatile I2CM_TransactionStatus_t Status;	/**< Transaction status */
+		 volatile I2C_Error_t Error;				/**< Error code when the transaction fails */
+		 I2CM_Transaction_t* Next;					/**< Next queued transaction. Only used by the driver */
+	 };
+ #endif
+
  /*
 	Common functions
  */
@@ -470,6 +504,24 @@
   */
  void I2CM_Receive(TWI_t* Device, const uint8_t DeviceAddress, const uint8_t Command, const uint8_t Bytes, uint8_t* Data);
 
+ #if(defined I2CM_USE_QUEUE)
+	 /** @brief				Add a write-then-read transaction to the transaction queue of a TWI master.
+							NOTE: You have to enable the interrupt support and the global interrupts to use it!
+								  Queued transactions are chained with a repeated start and the bus is only released
+								  when the queue is empty. The callback is called from the TWI interrupt.
+	  *  @param Device		Pointer to TWI object
+	  *  @param Transaction	Pointer to transaction object
+	  *  @return			I2C error
+	  */
+	 I2C_Error_t I2CM_Enqueue(TWI_t* Device, I2CM_Transaction_t* Transaction);
+
+	 /** @brief			Check if the transaction queue of a TWI master is empty.
+	  *  @param Device	Pointer to TWI object
+	  *  @return		#true if no transaction is queued or active
+	  */
+	 bool I2CM_QueueIsIdle(const TWI_t* Device);
+ #endif
+
  /** @brief			Get the status of an ongoing transaction.
   *  @param Device	Pointer to TWI object
   *  @return		Master device status
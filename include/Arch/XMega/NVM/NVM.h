@@ -205,6 +205,16 @@
   */
  void NVM_EEPROMWritePage(const uint8_t Page, const uint8_t Length, const uint8_t* Data);
 
+ /** @brief			Write bytes into an erased part of an EEPROM page without erasing the page.
+  *					NOTE: The function doesn't wait for the end of the write. Only the given bytes are changed and an
+  *					EEPROM cell can only be changed from 1 to 0 without an erase!
+  *  @param Page	Page address
+  *  @param Offset	Page offset
+  *  @param Length	Length of data
+  *  @param Data	Pointer to data
+  */
+ void NVM_EEPROMWriteBytes(const uint8_t Page, const uint8_t Offset, const uint8_t Length, const uint8_t* Data);
+
  /** @brief			Read one byte from the EEPROM.
   *  @param Page	Page address
   *  @param Offset	Page offset
@@ -40,6 +40,10 @@
  #include "Arch/XMega/GPIO/GPIO.h"
  #include "Arch/XMega/PMIC/PMIC.h"
 
+ #if(defined SPIM_USE_DMA)
+	 #include "Arch/XMega/DMA/DMA.h"
+ #endif
+
  /** @brief	ID declaration for the different MCU types.
   */
  #define SPIC_ID			0									/**< SPI C ID */
@@ -176,11 +180,47 @@
 	 uint8_t Pin;												/**< Pin for slave select */
 	 uint8_t* BufferOut;										/**< Pointer to output buffer */
 	 uint8_t* BufferIn;											/**< Pointer to input buffer */
-	 volatile uint8_t BytesProcessed;							/**< Counter for processed bytes */
-	 uint8_t Length;											/**< Message length */
+	 volatile uint16_t BytesProcessed;							/**< Counter for processed bytes */
+	 uint16_t Length;											/**< Message length */
 	 volatile SPI_Status_t Status;								/**< Transmission status */
  } SPI_Message_t;
 
+ #if(defined SPIM_USE_QUEUE)
+	 /** @brief SPI bus device object for the transaction queue.
+				NOTE: The settings are applied to the SPI interface when the bus switches to this device.
+	  */
+	 typedef struct
+	 {
+		 PORT_t* Port;											/**< Port for slave select */
+		 uint8_t Pin;											/**< Pin for slave select */
+		 SPI_Mode_t Mode;										/**< SPI mode */
+		 SPI_DataOrder_t DataOrder;								/**< Data order */
+		 SPI_ClockPrescaler_t Prescaler;						/**< Clock prescaler */
+	 } SPIM_BusDevice_t;
+
+	 typedef struct SPIM_Transaction SPIM_Transaction_t;
+
+	 /** @brief				Transaction complete callback definition.
+	  *  @param Transaction	Pointer to completed transaction
+	  */
+	 typedef void (*SPIM_TransactionCallback_t)(SPIM_Transaction_t* Transaction);
+
+	 /** @brief SPI transaction object for the transaction queue.
+				NOTE: The object and the buffers are owned by the caller and have to be valid until the transaction is complete.
+	  */
+	 struct SPIM_Transaction
+	 {
+		 const SPIM_BusDevice_t* BusDevice;						/**< Pointer to target bus device */
+		 const uint8_t* WriteData;								/**< Pointer to transmit buffer. Set to #NULL to transmit 0xFF */
+		 uint8_t* ReadData;										/**< Pointer to receive buffer. Set to #NULL to discard the received data */
+		 uint16_t Length;										/**< Transaction length */
+		 bool KeepSelected;										/**< Set to #true to keep the device selected for the next transaction of the same device */
+		 SPIM_TransactionCallback_t Callback;					/**< Function pointer to transaction complete callback. Can be #NULL */
+		 volatile SPI_Status_t Status;							/**< Transaction status */
+		 SPIM_Transaction_t* Next;								/**< Next queued transaction. Only used by the driver */
+	 };
+ #endif
+
  /*
 	Common functions
  */
@@ -239,7 +279,7 @@
  static inline void SPI_SetMode(SPI_t* Device, const SPI_Mode_t Mode) __attribute__((always_inline));
  static inline void SPI_SetMode(SPI_t* Device, const SPI_Mode_t Mode)
  {
-	 Device->CTRL = (Device->CTRL & (~(0x01 << 0x02))) | (Mode << 0x02);
+	 Device->CTRL = (Device->CTRL & (~(0x03 << 0x02))) | (Mode << 0x02);
  }
 
  /** @brief			Set the data order of the SPI interface.
@@ -305,7 +345,7 @@
 		 SPIM_SwitchDoubleSpeed(Device, true);
 	 }
 	
-	 Device->CTRL = (Device->CTRL & (~(0x01 << 0x01))) | (Prescaler & 0x03);
+	 Device->CTRL = (Device->CTRL & (~0x03)) | (Prescaler & 0x03);
  }
 
  /** @brief			Get the prescaler of the SPI interface.
@@ -355,7 +395,31 @@
   *  @param Port		Slave select pin number
   *  @return			Status code
   */
- SPI_Status_t SPIM_Transmit(SPI_t* Device, const uint8_t Bytes, uint8_t* WriteBuffer, uint8_t* ReadBuffer, PORT_t* Port, const uint8_t Pin);
+ SPI_Status_t SPIM_Transmit(SPI_t* Device, const uint16_t Bytes, uint8_t* WriteBuffer, uint8_t* ReadBuffer, PORT_t* Port, const uint8_t Pin);
+
+ #if(defined SPIM_USE_QUEUE)
+	 /** @brief				Initialize the slave select pin of a bus device.
+	  *  @param BusDevice	Pointer to bus device object
+	  */
+	 void SPIM_InitBusDevice(const SPIM_BusDevice_t* BusDevice);
+
+	 /** @brief				Add a transaction to the transaction queue of a SPI master.
+							NOTE: You have to enable the interrupt support and the global interrupts to use it!
+								  The clock settings of the bus device are applied when the bus switches between two devices.
+								  Write only transactions with at least #SPIM_DMA_THRESHOLD bytes are transmitted with the DMA
+								  when #SPIM_USE_DMA is set. The callback is called from the interrupt.
+	  *  @param Device		Pointer to SPI object
+	  *  @param Transaction	Pointer to transaction object
+	  *  @return			Status code
+	  */
+	 SPI_Status_t SPIM_Enqueue(SPI_t* Device, SPIM_Transaction_t* Transaction);
+
+	 /** @brief			Check if the transaction queue of a SPI master is empty.
+	  *  @param Device	Pointer to SPI object
+	  *  @return		#true if no transaction is queued or active
+	  */
+	 bool SPIM_QueueIsIdle(const SPI_t* Device);
+ #endif
 
  /** @brief			Get the status of an ongoing transaction.
   *  @param Device	Pointer to SPI object
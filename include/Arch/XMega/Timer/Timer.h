@@ -144,6 +144,7 @@
  typedef enum
  {
 	 TIMER_INPUT_CAPTURE = 0x01,					/**< Input capture mode */
+	 TIMER_EVENT_RESTART = 0x04,					/**< Restart the timer with each event */
 	 TIMER_FRQ_CAPTURE = 0x05,						/**< Frequency capture mode */
 	 TIMER_PW_CAPTURE = 0x06,						/**< Pulse width capture mode */
  } Timer0_CaptureMode_t;
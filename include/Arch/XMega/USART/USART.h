@@ -39,12 +39,18 @@
 
  #include "Common/Common.h"
  #include "Common/RingBuffer/RingBuffer.h"
+ #include "Common/Ringbuffer/SPSCRingBuffer.h"
 
  #include "Arch/XMega/SPI/SPI.h"
  #include "Arch/XMega/GPIO/GPIO.h"
  #include "Arch/XMega/PMIC/PMIC.h"
  #include "Arch/XMega/ClockManagement/SysClock.h"
 
+ #if(defined USART_USE_DMA)
+	 #include "Arch/XMega/DMA/DMA.h"
+	 #include "Arch/XMega/Timer/Timer.h"
+ #endif
+
  /** @defgroup Serial
   *  @{
   */
@@ -56,6 +62,10 @@
 		 #define CR						0x0D	/**< Carriage return */ 
 		 #define XON					0x11	/**< Software flow control on */ 
 		 #define XOFF					0x13	/**< Software flow control off */
+		 #define USART_SLIP_END			0xC0	/**< SLIP frame end */
+		 #define USART_SLIP_ESC			0xDB	/**< SLIP escape */
+		 #define USART_SLIP_ESC_END		0xDC	/**< SLIP escaped frame end */
+		 #define USART_SLIP_ESC_ESC		0xDD	/**< SLIP escaped escape */
 	 /** @} */ // end of Serial-Commands
  /** @} */ // end of Serial
 
@@ -66,10 +76,19 @@
  #define USARTE_ID		2						/**< USART E ID */
  #define USARTF_ID		3						/**< USART F ID */
 
+ #if(!defined USART_RX_BUFFER_SIZE)
+	#define USART_RX_BUFFER_SIZE	USART_BUFFER_SIZE	/**< Size of USART receive buffer in bytes */
+ #endif
+
  /** @brief	USART callback definition.
  */
  typedef void (*USART_Callback_t)(void);
 
+ /** @brief			USART DMA receive callback definition.
+  *  @param Bytes	Number of bytes received since the last callback
+  */
+ typedef void (*USART_DMA_RxCallback_t)(const uint16_t Bytes);
+
  /** @brief USART parity modes.
   */
  typedef enum
@@ -135,6 +154,16 @@
 	 USART_BUFFER_OVERFLOW = 0x08,				/**< Buffer overflow interrupt */
  } USART_CallbackType_t;
 
+ /** @brief USART receive framing modes.
+  */
+ typedef enum
+ {
+	 USART_FRAMING_NONE = 0x00,					/**< No framing. The receive callback is called for each byte */
+	 USART_FRAMING_LINE = 0x01,					/**< Lines terminated with LF. CR is ignored */
+	 USART_FRAMING_SLIP = 0x02,					/**< SLIP frames (RFC 1055) */
+	 USART_FRAMING_COBS = 0x03,					/**< COBS frames with 0x00 as delimiter */
+ } USART_Framing_t;
+
  /** @brief USART interrupt configuration object.
   */
  typedef struct
@@ -171,8 +200,31 @@
  {
 	 USART_t* Device;							/**< Target USART */
 	 RingBuffer_t* Ptr_TxRingBuffer;			/**< Pointer to target ring buffer */				
+	 #if(defined USART_USE_RX_BUFFER)
+		 SPSCRingBuffer_t* Ptr_RxRingBuffer;	/**< Pointer to receive ring buffer */
+		 USART_Framing_t Framing;				/**< Receive framing mode */
+		 volatile uint8_t FramesReceived;		/**< Number of received frames. Only modified by the interrupt */
+		 uint8_t FramesRead;					/**< Number of read frames */
+		 volatile uint8_t FramesTruncated;		/**< Number of received frames with lost bytes. Only modified by the interrupt */
+		 bool Discard;							/**< #true while the rest of a frame with lost bytes is discarded */
+	 #endif
  } USART_Message_t;
 
+ #if(defined USART_USE_DMA)
+	 /** @brief USART DMA receive configuration object.
+	  */
+	 typedef struct
+	 {
+		 USART_t* Device;							/**< Pointer to USART device object */
+		 TC0_t* Timer;								/**< Pointer to Timer0 device object for the idle line detection */
+		 Timer_Prescaler_t Prescaler;				/**< Clock prescaler for the idle timer */
+		 uint16_t IdleTime;							/**< Idle time in timer ticks \n
+														 NOTE: Should be at least two characters long. */
+		 Event_Channel_t EventChannel;				/**< Event channel used to restart the idle timer with each edge on the Rx pin */
+		 USART_DMA_RxCallback_t Callback;			/**< Function pointer to idle line callback */
+	 } USART_DMA_RxConfig_t;
+ #endif
+
  /** @brief			Set the device mode for USART interface.
   *  @param Device	Pointer to USART object
   *  @param Mode	USART device mode
@@ -354,6 +406,24 @@
   */
  void USART_Print(USART_t* Device, const char* Data);
  
+ /** @brief			Formatted output with the USART interface.
+					NOTE: The output is written into the transmit ring buffer when the interrupt support is enabled.
+						  Otherwise the characters are transmitted directly.
+					Supported conversions are %d, %i, %u, %x, %X, %b (binary), %c, %s, %S (string in flash) and %%.
+					Use l for 32 bit values (%ld, %lu, %lx), a width with optional 0 or - flag (%08lx, %-6d) and
+					a precision for fixed-point numbers (%.2d prints 1234 as 12.34).
+  *  @param Device	Pointer to USART object
+  *  @param Format	Pointer to format string
+  */
+ void USART_Printf(USART_t* Device, const char* Format, ...);
+
+ /** @brief			Formatted output with a format string stored in the flash (i. e. PSTR("...")).
+					NOTE: See #USART_Printf for the supported conversions.
+  *  @param Device	Pointer to USART object
+  *  @param Format	Pointer to format string in flash
+  */
+ void USART_Printf_P(USART_t* Device, const char* Format, ...);
+
  /** @brief			Flush the USART transmit buffer.
   *  @param Device	Pointer to USART object
   */
@@ -365,6 +435,109 @@
   */
  void USART_SwitchEcho(USART_t* Device, const bool Enable);
  
+ #if(defined USART_USE_RX_BUFFER)
+	 /** @brief			Get the number of received bytes in the receive buffer.
+	  *  @param Device	Pointer to USART object
+	  *  @return		Number of bytes
+	  */
+	 uint16_t USART_Available(USART_t* Device);
+
+	 /** @brief			Copy received bytes from the receive buffer.
+	  *  @param Device	Pointer to USART object
+	  *  @param Data	Pointer to data array
+	  *  @param Length	Max. number of bytes
+	  *  @return		Number of copied bytes
+	  */
+	 uint16_t USART_Read(USART_t* Device, uint8_t* Data, const uint16_t Length);
+
+	 /** @brief			Get the contiguous block of received bytes without copying them.
+						NOTE: The data stays valid until #USART_Skip is called. Call the function again after
+							  #USART_Skip to get the data behind the end of the ring buffer.
+	  *  @param Device	Pointer to USART object
+	  *  @param Data	Pointer to data pointer
+	  *  @return		Number of bytes in the block
+	  */
+	 uint16_t USART_Peek(USART_t* Device, const uint8_t** Data);
+
+	 /** @brief			Remove bytes from the receive buffer.
+	  *  @param Device	Pointer to USART object
+	  *  @param Length	Number of bytes
+	  */
+	 void USART_Skip(USART_t* Device, const uint16_t Length);
+
+	 /** @brief			Set the framing mode for the receive buffer.
+						NOTE: The receive callback is only called at the end of a frame when a framing mode is set.
+	  *  @param Device	Pointer to USART object
+	  *  @param Framing	Framing mode
+	  */
+	 void USART_SetFraming(USART_t* Device, const USART_Framing_t Framing);
+
+	 /** @brief			Read and decode a complete frame from the receive buffer.
+						NOTE: Frames longer than the data array are truncated. When the receive buffer overflows, the
+							  rest of the frame is discarded until the next delimiter and the frame is counted by
+							  #USART_GetTruncatedFrames.
+	  *  @param Device	Pointer to USART object
+	  *  @param Data	Pointer to data array
+	  *  @param Length	Pointer to size of the data array. Returns the frame length.
+	  *  @return		#false if no complete frame is available
+	  */
+	 bool USART_ReadFrame(USART_t* Device, uint8_t* Data, uint16_t* Length);
+
+	 /** @brief			Get the number of received frames with lost bytes.
+	  *  @param Device	Pointer to USART object
+	  *  @return		Number of truncated frames
+	  */
+	 uint8_t USART_GetTruncatedFrames(USART_t* Device);
+ #endif
+
+ #if(defined USART_USE_DMA)
+	 /** @brief				Transmit a data block with the DMA.
+							NOTE: The data has to be valid until the transmission is complete!
+	  *  @param Device		Pointer to USART object
+	  *  @param Data		Pointer to data
+	  *  @param Length		Length of data
+	  *  @param Callback	Function pointer to transmission complete callback. Can be #NULL.
+	  *  @return			#false if a DMA transmission or an interrupt driven transmission is still active
+	  */
+	 bool USART_DMA_Write(USART_t* Device, const uint8_t* Data, const uint16_t Length, USART_Callback_t Callback);
+
+	 /** @brief			Transmit a string with the DMA.
+						NOTE: The string has to be valid until the transmission is complete!
+	  *  @param Device	Pointer to USART object
+	  *  @param Data	Pointer to string
+	  *  @return		#false if a DMA transmission or an interrupt driven transmission is still active
+	  */
+	 bool USART_DMA_Print(USART_t* Device, const char* Data);
+
+	 /** @brief		Check if a DMA transmission is active.
+	  *  @return	#true if the transmission is active
+	  */
+	 bool USART_DMA_IsBusy(void);
+
+	 /** @brief			Start the continuous DMA reception into the DMA receive buffer.
+						NOTE: The callback is called from the timer interrupt when the receive line is idle.
+	  *  @param Config	Pointer to DMA receive configuration object
+	  */
+	 void USART_DMA_StartReceive(USART_DMA_RxConfig_t* Config);
+
+	 /** @brief	Stop the DMA reception.
+	  */
+	 void USART_DMA_StopReceive(void);
+
+	 /** @brief		Get the number of unread bytes in the DMA receive buffer.
+	  *  @return	Number of bytes
+	  */
+	 uint16_t USART_DMA_Available(void);
+
+	 /** @brief			Copy received bytes from the DMA receive buffer.
+						NOTE: Unread data is overwritten when more than #USART_DMA_RX_BUFFER_SIZE bytes are received.
+	  *  @param Data	Pointer to data array
+	  *  @param Length	Max. number of bytes
+	  *  @return		Number of copied bytes
+	  */
+	 uint16_t USART_DMA_Read(uint8_t* Data, const uint16_t Length);
+ #endif
+
  /** @brief				Set the baud rate of a USART interface.
   *  @param Device		Pointer to USART object
   *  @param Baudrate	Baudrate for the interface
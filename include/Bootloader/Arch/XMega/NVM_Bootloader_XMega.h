@@ -58,4 +58,25 @@
   */
  void NVM_FlushFlash(const uint16_t Page);
 
+ /** @brief			Start the write of the page buffer into the flash memory without waiting for the NVM controller.
+					NOTE: The page buffer must not be loaded until #NVM_IsBusy returns #false.
+  *  @param Page	Page address
+  */
+ void NVM_StartFlushFlash(const uint16_t Page);
+
+ /** @brief			Calculate the CRC-32 (IEEE 802.3) of the application section with the CRC module.
+  *  @param Length	Length of the image in bytes
+  *  @return		CRC-32
+  */
+ uint32_t NVM_ApplicationCRC(const uint32_t Length);
+
+ /** @brief		Check if the NVM controller is busy.
+  *  @return	#true when busy
+  */
+ static inline bool NVM_IsBusy(void) __attribute__((always_inline));
+ static inline bool NVM_IsBusy(void)
+ {
+	 return NVM.STATUS & NVM_NVMBUSY_bm;
+ }
+
 #endif /* NVM_BOOTLOADER_XMEGA_H_ */
\ No newline at end of file
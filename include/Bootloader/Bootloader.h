@@ -44,10 +44,32 @@
 
  #if(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_INTEL)
 	 #include "Parser/IntelHexParser.h"
+ #elif(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_BINARY)
+	 #include "Parser/BinaryParser.h"
  #else
 	 #error "File format not supported by bootloader!"
  #endif
 
+ #if(defined BOOTLOADER_USE_COMPRESSION)
+	 #if(BOOTLOADER_FILE_FORMAT != HEX_FORMAT_BINARY)
+		 #error "Compressed images are only supported with the binary format!"
+	 #endif
+
+	 #include "Parser/LZSSDecoder.h"
+ #endif
+
+ #if(defined BOOTLOADER_USE_DELTA)
+	 #if(BOOTLOADER_FILE_FORMAT != HEX_FORMAT_BINARY)
+		 #error "Differential updates are only supported with the binary format!"
+	 #endif
+
+	 #if(defined BOOTLOADER_USE_COMPRESSION)
+		 #error "Differential updates can not be used with compressed images!"
+	 #endif
+
+	 #include "Parser/DeltaPatch.h"
+ #endif
+
  /*
 	Function prototypes used by the bootloader.
  */
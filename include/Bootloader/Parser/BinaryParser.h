@@ -0,0 +1,109 @@
+/*
+ * BinaryParser.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Bootloader parser for the binary packet format.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Common/Parser/BinaryParser.h
+ *  @brief Bootloader parser for the binary packet format.
+ *
+ *  This contains the prototypes and definitions for the binary packet format parser.
+ *  Each packet contains one flash page (all values are little endian):
+ *
+ *		| Start | Sequence | Page (2) | Length (2) | Data (Length) | CRC (2) |
+ *
+ *  The start byte is #PARSER_PACKET_DATA for a data packet or #PARSER_PACKET_END for the last packet.
+ *  The page field of the end packet contains the start address of the application. The end packet can contain
+ *  the length of the image and the CRC-32 of the image (both 4 bytes). The bootloader verifies the programmed
+ *  application with these values and answers with #PARSER_ERROR when the CRC doesn't match. The CRC-16 (XMODEM)
+ *  covers all bytes between the start byte and the CRC.
+ *  A differential update (#BOOTLOADER_USE_DELTA) starts with a #PARSER_PACKET_BASE packet, which contains the length and
+ *  the CRC-32 of the installed application. The bootloader answers with #PARSER_ERROR when the installed application
+ *  doesn't match. The bootloader can't receive data while it calculates the CRC, so the sender has to wait for the
+ *  acknowledge of the base packet before it transmits the next packet.
+ *  The bootloader answers with #PARSER_ACK and the sequence number of the last programmed packet (cumulative)
+ *  or with #PARSER_NAK and the expected sequence number. The sender can transmit up to #BOOTLOADER_WINDOW packets
+ *  without an acknowledge and has to continue with the expected sequence number after a #PARSER_NAK.
+ *  The bootloader sends only one #PARSER_NAK until the expected packet is received. Further errors are answered
+ *  after the receive timeout.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef BINARYPARSER_H_
+#define BINARYPARSER_H_
+
+ #include "Common/Common.h"
+
+ #if(defined BOOTLOADER_USE_DELTA)
+	 #define PARSER_MAX_DATA_BYTES	(APP_SECTION_PAGE_SIZE + (APP_SECTION_PAGE_SIZE / 128))	/**< Maximum data bytes per packet. A patch needs one operation per 128 data bytes */
+ #else
+	 #define PARSER_MAX_DATA_BYTES	APP_SECTION_PAGE_SIZE		/**< Maximum data bytes per packet */
+ #endif
+
+ #define PARSER_PACKET_DATA			0x01						/**< Start byte for a data packet */
+ #define PARSER_PACKET_BASE			0x02						/**< Start byte for the base packet of a differential update */
+ #define PARSER_PACKET_END			0x04						/**< Start byte for the end packet */
+ #define PARSER_ACK					0x06						/**< Acknowledge for a programmed packet */
+ #define PARSER_NAK					0x15						/**< Request to repeat a packet */
+ #define PARSER_ERROR				0x18						/**< Verification of the application failed */
+
+ #define PARSER_END_DATA_BYTES		0x08						/**< Data bytes of an end or base packet with image length and CRC */
+
+ /** @brief State of the binary packet parser.
+  */
+ typedef enum
+ {
+	 PARSER_STATE_BUSY = 0x00,									/**< Busy */
+	 PARSER_STATE_SUCCESSFUL = 0x01,							/**< Packet complete */
+	 PARSER_STATE_ERROR = 0x02,									/**< CRC error */
+	 PARSER_STATE_OVERFLOW = 0x03,								/**< Packet is larger than a flash page */
+ } Parser_State_t;
+
+ /** @brief Packet object for the binary format.
+  */
+ typedef struct
+ {
+	 uint8_t Type;												/**< Start byte of the packet */
+	 uint8_t Sequence;											/**< Sequence number */
+	 uint16_t Page;												/**< Page address or start address for the end packet */
+	 uint16_t Length;											/**< Data byte count */
+	 uint8_t* pBuffer;											/**< Pointer to data buffer. Set to #NULL to drop the data bytes */
+ } Parser_Packet_t;
+
+ /** @brief	Initialize the parser.
+  */
+ void Parser_Init(void);
+
+ /** @brief	Check if the data buffer of the packet object can be changed.
+  *  @return	#true when the parser waits for a packet or receives the header of a packet
+  */
+ bool Parser_IsIdle(void);
+
+ /** @brief				Receive a byte and store it in the packet object.
+						NOTE: The data buffer must be set before the first data byte is received (see #Parser_IsIdle).
+  *  @param Packet		Pointer to packet object
+  *  @param Received	Received byte
+  *  @return			#PARSER_STATE_SUCCESSFUL when the packet is complete and the CRC is valid
+  */
+ Parser_State_t Parser_GetByte(Parser_Packet_t* Packet, const uint8_t Received);
+
+#endif /* BINARYPARSER_H_ */
\ No newline at end of file
@@ -0,0 +1,57 @@
+/*
+ * DeltaPatch.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Page patch decoder for differential bootloader updates.
+
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Common/Parser/DeltaPatch.h
+ *  @brief Page patch decoder for differential bootloader updates.
+ *
+ *  This contains the prototypes and definitions for the page patch decoder. Each data packet contains the patch for
+ *  one flash page. The new page is rebuilt from the old content of the same page and a list of operations:
+ *
+ *		0x00 - 0x7F | Copy (Operation + 1) bytes from the old page
+ *		0x80 - 0xFF | Replace ((Operation & 0x7F) + 1) bytes with the following data bytes
+ *
+ *  The rest of the page is copied from the old page when the patch ends. Unchanged pages are not transmitted.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef DELTAPATCH_H_
+#define DELTAPATCH_H_
+
+ #include "Common/Common.h"
+
+ /** @brief	Initialize the decoder for a new page.
+  */
+ void Delta_Init(void);
+
+ /** @brief				Get the next byte of the new page.
+  *  @param Input		Pointer to input pointer. The pointer is moved behind the consumed bytes
+  *  @param Length		Pointer to remaining input bytes
+  *  @param Old			Byte of the old page at the current position
+  *  @return			Byte of the new page
+  */
+ uint8_t Delta_Decode(const uint8_t** Input, uint16_t* Length, const uint8_t Old);
+
+#endif /* DELTAPATCH_H_ */
\ No newline at end of file
@@ -26,7 +26,9 @@
  *  @brief Bootloader parser for the Intel-Hex file format.
  *		   NOTE: Please check https://en.wikipedia.org/wiki/Intel_HEX for additional information.
  *
- *  This contains the prototypes and definitions for the Intel-Hex file format parser.
+ *  This contains the prototypes and definitions for the Intel-Hex file format parser. The parser works in a single pass
+ *  over the received characters. Each data byte is passed to the caller as soon as it is received and the checksum
+ *  is calculated on the fly, so no line buffer is needed.
  *
  *  @author Daniel Kampert
  */
@@ -36,16 +38,7 @@
 
  #include "Common/Common.h"
 
- #define PARSER_MAX_DATA_BYTES		16							/**< Maximum data bytes per record */
-
- #define PARSER_LENGTH_BYTES		0x02						/**< Length of the length field in bytes */
- #define PARSER_ADDRESS_BYTES		0x04						/**< Length of the address field in bytes */
- #define PARSER_TYPE_BYTES			0x02						/**< Length of the type field in bytes */
- #define PARSER_DATA_BYTES			0x02						/**< Length of the data field in bytes */
- #define PARSER_CHECK_BYTES			0x02						/**< Length of the checksum field in bytes */
- 
- #define PARSER_LINE_END			0x0D						/**< Line ending for the record. Intel tools add a 0x0D, 0x0A to the end of each line */
- #define PARSER_START_BYTE			0x00						/**< Start byte for the current record */
+ #define PARSER_LINE_START			':'							/**< Start character for a record */
 
  /** @brief State of the Intel hex file parser.
   */
@@ -55,6 +48,7 @@
 	 PARSER_STATE_SUCCESSFUL = 0x01,							/**< Parsing successful */
 	 PARSER_STATE_ERROR = 0x02,									/**< Error while parsing the line */
 	 PARSER_STATE_OVERFLOW = 0x03,								/**< Buffer overflow during line receive */
+	 PARSER_STATE_DATA = 0x04,									/**< A new data byte is available */
  } Parser_State_t;
 
  /** @brief Record types
@@ -73,13 +67,12 @@
   */
  typedef struct
  {
-	 uint16_t Length;											/**< Data byte count */
-	 uint16_t Address;											/**< Memory address */
-	 uint32_t Offset;											/**< Offset address */
+	 uint8_t Length;											/**< Data byte count */
+	 uint16_t Address;											/**< Memory address of the current data byte */
+	 uint32_t Offset;											/**< Offset address from the last extended address record */
 	 uint32_t StartAddress;										/**< Start address */
 	 Parser_Type_t Type;										/**< Record type */
-	 unsigned char* pBuffer;									/**< Pointer to data buffer */
-	 uint16_t Checksum;											/**< Checksum */
+	 uint8_t Data;												/**< Current data byte */
 	 bool Valid;												/**< Valid flag */
  } Parser_Block_t;
 
@@ -87,16 +80,14 @@
   */
  void Parser_Init(void);
 
- /** @brief				Receive a byte, store it in the line buffer and wait for a complete block.
-  *  @param Received	Received byte
-  *  @return			#PARSER_STATE_SUCCESSFULL when line end
-  */
- Parser_State_t Parser_GetByte(const uint8_t Received);
-
- /** @brief			Parse the line buffer into a #IntelHexParser_Line_t object. Must be called after #IntelHexParser_GetLine.
-  *  @param Line	Pointer to line object
-  *  @return		Parser state. Must be polled until #PARSER_STATE_SUCCESSFULL or #PARSER_STATE_ERROR is returned
+ /** @brief				Receive a character and decode the current record.
+						NOTE: The data bytes are passed before the checksum of the record is checked. The record has to be
+						discarded when #PARSER_STATE_ERROR is returned.
+  *  @param Line		Pointer to record object
+  *  @param Received	Received character
+  *  @return			#PARSER_STATE_DATA when a data byte is available in the record object, #PARSER_STATE_SUCCESSFUL when the
+						record is complete and valid or #PARSER_STATE_ERROR for an invalid record
   */
- Parser_State_t Parser_Parse(Parser_Block_t* Line);
+ Parser_State_t Parser_GetByte(Parser_Block_t* Line, const uint8_t Received);
 
 #endif /* INTELHEXPARSER_H_ */
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+ * LZSSDecoder.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: LZSS decoder for compressed bootloader images.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Common/Parser/LZSSDecoder.h
+ *  @brief LZSS decoder for compressed bootloader images.
+ *
+ *  This contains the prototypes and definitions for the streaming LZSS decoder. The compressed image is a bit stream (MSB first).
+ *  Each token starts with a tag bit:
+ *
+ *		1 | Literal (8)
+ *		0 | Offset - 1 (#BOOTLOADER_LZSS_WINDOW_BITS) | Length - 2 (#BOOTLOADER_LZSS_LENGTH_BITS)
+ *
+ *  A back reference copies Length bytes from Offset bytes before the current position. The decoder only needs a ring buffer with
+ *  2^#BOOTLOADER_LZSS_WINDOW_BITS bytes of RAM and can be interrupted after each input or output byte.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef LZSSDECODER_H_
+#define LZSSDECODER_H_
+
+ #include "Common/Common.h"
+
+ #if(!defined BOOTLOADER_LZSS_WINDOW_BITS)
+	 #define BOOTLOADER_LZSS_WINDOW_BITS	8
+ #endif
+
+ #if(!defined BOOTLOADER_LZSS_LENGTH_BITS)
+	 #define BOOTLOADER_LZSS_LENGTH_BITS	4
+ #endif
+
+ /** @brief State of the LZSS decoder.
+  */
+ typedef enum
+ {
+	 LZSS_STATE_OUTPUT = 0x00,									/**< One byte was decoded */
+	 LZSS_STATE_INPUT = 0x01,									/**< All input bytes are consumed */
+ } LZSS_State_t;
+
+ /** @brief	Initialize the decoder.
+  */
+ void LZSS_Init(void);
+
+ /** @brief				Decode the next byte.
+  *  @param Input		Pointer to input pointer. The pointer is moved behind the consumed bytes
+  *  @param Length		Pointer to remaining input bytes
+  *  @param Output		Pointer to decoded byte
+  *  @return			#LZSS_STATE_OUTPUT when a byte was decoded or #LZSS_STATE_INPUT when more input is needed
+  */
+ LZSS_State_t LZSS_Decode(const uint8_t** Input, uint16_t* Length, uint8_t* Output);
+
+#endif /* LZSSDECODER_H_ */
\ No newline at end of file
@@ -32,14 +32,27 @@
 #define FRAMEBUFFER_H_
 
  #include <stdint.h>
+ #include <stddef.h>
+ #include <stdbool.h>
+
+ /** @brief Modified column range of a single frame buffer page.
+  *			NOTE: The range is empty when \ref FrameBuffer_Dirty_t.Start is greater than \ref FrameBuffer_Dirty_t.End.
+  */
+ typedef struct
+ {
+	 uint8_t Start;								/**< First modified column */
+	 uint8_t End;								/**< Last modified column */
+ } FrameBuffer_Dirty_t;
 
  /** @brief			Initialize a new frame buffer.
   *  @param Width	Width of each page in pixel
   *  @param Height	Height of each page in pixel
   *  @param Pages	Page count
   *  @param Buffer	Pointer to memory location for data
+  *  @param Dirty	Pointer to one #FrameBuffer_Dirty_t object for each page \n
+  *					NOTE: Set to #NULL to disable the tracking of modified columns
   */
- void FrameBuffer_Init(const uint8_t Width, const uint8_t Height, const uint8_t Pages, uint8_t* Buffer);
+ void FrameBuffer_Init(const uint8_t Width, const uint8_t Height, const uint8_t Pages, uint8_t* Buffer, FrameBuffer_Dirty_t* Dirty);
 
  /** @brief			Store a byte in the frame buffer.
   *  @param Page	Display page
@@ -71,4 +84,32 @@
   */
  void FrameBuffer_ReadPage(const uint8_t Page, const uint8_t Column, const uint8_t Length, uint8_t* Data);
 
+ /** @brief			Get a pointer to a byte in the frame buffer.
+  *  @param Page	Display page
+  *  @param Column	Display column
+  *  @return		Pointer to data
+  */
+ uint8_t* FrameBuffer_GetPointer(const uint8_t Page, const uint8_t Column);
+
+ /** @brief			Mark a column range of a page as modified.
+  *					NOTE: Only available when the frame buffer is initialized with dirty tracking.
+  *  @param Page	Display page
+  *  @param Start	First modified column
+  *  @param End		Last modified column
+  */
+ void FrameBuffer_MarkDirty(const uint8_t Page, const uint8_t Start, const uint8_t End);
+
+ /** @brief			Get the modified column range of a page.
+  *  @param Page	Display page
+  *  @param Start	Pointer to first modified column
+  *  @param End		Pointer to last modified column
+  *  @return		#true if the page contains modified columns
+  */
+ bool FrameBuffer_GetDirty(const uint8_t Page, uint8_t* Start, uint8_t* End);
+
+ /** @brief			Mark a page as unmodified.
+  *  @param Page	Display page
+  */
+ void FrameBuffer_ClearDirty(const uint8_t Page);
+
 #endif /* FRAMEBUFFER_H_ */
\ No newline at end of file
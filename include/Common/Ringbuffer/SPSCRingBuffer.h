@@ -0,0 +1,281 @@
+/*
+ * SPSCRingBuffer.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Lock-free single producer single consumer ring buffer.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and omissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Common/Ringbuffer/SPSCRingBuffer.h
+ *  @brief Lock-free single producer single consumer ring buffer.
+ *
+ *  The head index is only written by the producer and the tail index is only written by the consumer.
+ *  Both indices are free running 8 bit counters, so they can be read and written with a single instruction
+ *  and an interrupt can be the producer or the consumer without locking the interrupts.
+ *  The size of the buffer has to be a power of two between 2 and 128 bytes.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef SPSCRINGBUFFER_H_
+#define SPSCRINGBUFFER_H_
+
+ #include <stdint.h>
+ #include <stdbool.h>
+ #include <string.h>
+
+ /** @brief	Compiler barrier. Prevents that data accesses are moved across an index update.
+  */
+ #define SPSCRINGBUFFER_BARRIER()			__asm__ __volatile__("" ::: "memory")
+
+ /** @brief SPSC ring buffer object definition.
+  */
+ typedef struct
+ {
+	 uint8_t* Data;						/**< Pointer to the data array */
+	 uint8_t Mask;						/**< Size of the data array - 1 */
+	 volatile uint8_t Head;				/**< Write index. Only modified by the producer */
+	 volatile uint8_t Tail;				/**< Read index. Only modified by the consumer */
+ } SPSCRingBuffer_t;
+
+ /** @brief			Initialize a new SPSC ring buffer.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Data	Pointer to data array
+  *  @param Size	Size of the data array \n
+					NOTE: Has to be a power of two and not larger than 128!
+  */
+ static inline void SPSCRingBuffer_Init(SPSCRingBuffer_t* Buffer, uint8_t* Data, const uint8_t Size) __attribute__ ((always_inline));
+ static inline void SPSCRingBuffer_Init(SPSCRingBuffer_t* Buffer, uint8_t* Data, const uint8_t Size)
+ {
+	 Buffer->Data = Data;
+	 Buffer->Mask = Size - 0x01;
+	 Buffer->Head = 0x00;
+	 Buffer->Tail = 0x00;
+ }
+
+ /** @brief			Get the byte count in the buffer.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @return		Bytes in the buffer
+  */
+ static inline uint8_t SPSCRingBuffer_GetBytes(const SPSCRingBuffer_t* Buffer) __attribute__ ((always_inline));
+ static inline uint8_t SPSCRingBuffer_GetBytes(const SPSCRingBuffer_t* Buffer)
+ {
+	 return (uint8_t)(Buffer->Head - Buffer->Tail);
+ }
+
+ /** @brief			Get the free space in the buffer.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @return		Free bytes in the buffer
+  */
+ static inline uint8_t SPSCRingBuffer_GetFree(const SPSCRingBuffer_t* Buffer) __attribute__ ((always_inline));
+ static inline uint8_t SPSCRingBuffer_GetFree(const SPSCRingBuffer_t* Buffer)
+ {
+	 return Buffer->Mask + 0x01 - SPSCRingBuffer_GetBytes(Buffer);
+ }
+
+ /** @brief			Check if the buffer is empty.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @return		#true if the buffer is empty
+  */
+ static inline bool SPSCRingBuffer_IsEmpty(const SPSCRingBuffer_t* Buffer) __attribute__ ((always_inline));
+ static inline bool SPSCRingBuffer_IsEmpty(const SPSCRingBuffer_t* Buffer)
+ {
+	 return (Buffer->Head == Buffer->Tail);
+ }
+
+ /** @brief			Check if the buffer is full.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @return		#true if the buffer is full
+  */
+ static inline bool SPSCRingBuffer_IsFull(const SPSCRingBuffer_t* Buffer) __attribute__ ((always_inline));
+ static inline bool SPSCRingBuffer_IsFull(const SPSCRingBuffer_t* Buffer)
+ {
+	 return (SPSCRingBuffer_GetBytes(Buffer) > Buffer->Mask);
+ }
+
+ /** @brief			Save a new data byte. Producer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Data	Data byte
+  *  @return		#false if the buffer is full
+  */
+ static inline bool SPSCRingBuffer_Save(SPSCRingBuffer_t* Buffer, const uint8_t Data) __attribute__ ((always_inline));
+ static inline bool SPSCRingBuffer_Save(SPSCRingBuffer_t* Buffer, const uint8_t Data)
+ {
+	 uint8_t Head = Buffer->Head;
+
+	 if((uint8_t)(Head - Buffer->Tail) > Buffer->Mask)
+	 {
+		 return false;
+	 }
+
+	 Buffer->Data[Head & Buffer->Mask] = Data;
+	 SPSCRINGBUFFER_BARRIER();
+	 Buffer->Head = Head + 0x01;
+
+	 return true;
+ }
+
+ /** @brief			Load the next data byte. Consumer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Data	Pointer to data byte
+  *  @return		#false if the buffer is empty
+  */
+ static inline bool SPSCRingBuffer_Load(SPSCRingBuffer_t* Buffer, uint8_t* Data) __attribute__ ((always_inline));
+ static inline bool SPSCRingBuffer_Load(SPSCRingBuffer_t* Buffer, uint8_t* Data)
+ {
+	 uint8_t Tail = Buffer->Tail;
+
+	 if(Tail == Buffer->Head)
+	 {
+		 return false;
+	 }
+
+	 SPSCRINGBUFFER_BARRIER();
+	 *Data = Buffer->Data[Tail & Buffer->Mask];
+	 SPSCRINGBUFFER_BARRIER();
+	 Buffer->Tail = Tail + 0x01;
+
+	 return true;
+ }
+
+ /** @brief			Get the contiguous block of data at the read index. Consumer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Data	Pointer to data pointer
+  *  @return		Bytes in the contiguous block
+  */
+ static inline uint8_t SPSCRingBuffer_GetReadSpan(const SPSCRingBuffer_t* Buffer, uint8_t** Data) __attribute__ ((always_inline));
+ static inline uint8_t SPSCRingBuffer_GetReadSpan(const SPSCRingBuffer_t* Buffer, uint8_t** Data)
+ {
+	 uint8_t Offset = Buffer->Tail & Buffer->Mask;
+	 uint8_t Length = SPSCRingBuffer_GetBytes(Buffer);
+	 uint8_t ToEnd = Buffer->Mask + 0x01 - Offset;
+
+	 SPSCRINGBUFFER_BARRIER();
+	 *Data = &Buffer->Data[Offset];
+
+	 return (Length < ToEnd) ? Length : ToEnd;
+ }
+
+ /** @brief			Remove data bytes after they were processed with #SPSCRingBuffer_GetReadSpan. Consumer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Count	Number of bytes
+  */
+ static inline void SPSCRingBuffer_CommitRead(SPSCRingBuffer_t* Buffer, const uint8_t Count) __attribute__ ((always_inline));
+ static inline void SPSCRingBuffer_CommitRead(SPSCRingBuffer_t* Buffer, const uint8_t Count)
+ {
+	 SPSCRINGBUFFER_BARRIER();
+	 Buffer->Tail += Count;
+ }
+
+ /** @brief			Get the contiguous block of free space at the write index. Producer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Data	Pointer to data pointer
+  *  @return		Bytes in the contiguous block
+  */
+ static inline uint8_t SPSCRingBuffer_GetWriteSpan(const SPSCRingBuffer_t* Buffer, uint8_t** Data) __attribute__ ((always_inline));
+ static inline uint8_t SPSCRingBuffer_GetWriteSpan(const SPSCRingBuffer_t* Buffer, uint8_t** Data)
+ {
+	 uint8_t Offset = Buffer->Head & Buffer->Mask;
+	 uint8_t Length = SPSCRingBuffer_GetFree(Buffer);
+	 uint8_t ToEnd = Buffer->Mask + 0x01 - Offset;
+
+	 *Data = &Buffer->Data[Offset];
+
+	 return (Length < ToEnd) ? Length : ToEnd;
+ }
+
+ /** @brief			Add data bytes after they were written with #SPSCRingBuffer_GetWriteSpan. Producer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Count	Number of bytes
+  */
+ static inline void SPSCRingBuffer_CommitWrite(SPSCRingBuffer_t* Buffer, const uint8_t Count) __attribute__ ((always_inline));
+ static inline void SPSCRingBuffer_CommitWrite(SPSCRingBuffer_t* Buffer, const uint8_t Count)
+ {
+	 SPSCRINGBUFFER_BARRIER();
+	 Buffer->Head += Count;
+ }
+
+ /** @brief			Copy a data block into the buffer. Producer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Data	Pointer to data
+  *  @param Length	Length of data
+  *  @return		Number of copied bytes
+  */
+ static inline uint16_t SPSCRingBuffer_Write(SPSCRingBuffer_t* Buffer, const uint8_t* Data, const uint16_t Length)
+ {
+	 uint16_t Bytes = 0x00;
+
+	 // Copy the data in max. two blocks (up to the end of the array and from the start of the array)
+	 while(Bytes < Length)
+	 {
+		 uint8_t* Span;
+		 uint16_t Block = SPSCRingBuffer_GetWriteSpan(Buffer, &Span);
+
+		 if(Block == 0x00)
+		 {
+			 break;
+		 }
+
+		 if(Block > (Length - Bytes))
+		 {
+			 Block = Length - Bytes;
+		 }
+
+		 memcpy(Span, &Data[Bytes], Block);
+		 SPSCRingBuffer_CommitWrite(Buffer, Block);
+		 Bytes += Block;
+	 }
+
+	 return Bytes;
+ }
+
+ /** @brief			Copy a data block from the buffer. Consumer only.
+  *  @param Buffer	Pointer to ring buffer object
+  *  @param Data	Pointer to data array
+  *  @param Length	Max. number of bytes
+  *  @return		Number of copied bytes
+  */
+ static inline uint16_t SPSCRingBuffer_Read(SPSCRingBuffer_t* Buffer, uint8_t* Data, const uint16_t Length)
+ {
+	 uint16_t Bytes = 0x00;
+
+	 while(Bytes < Length)
+	 {
+		 uint8_t* Span;
+		 uint16_t Block = SPSCRingBuffer_GetReadSpan(Buffer, &Span);
+
+		 if(Block == 0x00)
+		 {
+			 break;
+		 }
+
+		 if(Block > (Length - Bytes))
+		 {
+			 Block = Length - Bytes;
+		 }
+
+		 memcpy(&Data[Bytes], Span, Block);
+		 SPSCRingBuffer_CommitRead(Buffer, Block);
+		 Bytes += Block;
+	 }
+
+	 return Bytes;
+ }
+
+#endif /* SPSCRINGBUFFER_H_ */
\ No newline at end of file
@@ -110,6 +110,7 @@
   */
 	#define HEX_FORMAT_UNKNOWN									0		/**< Unknown Hex-File format */
 	#define HEX_FORMAT_INTEL									1		/**< Intel Hex-File format */ 
+	#define HEX_FORMAT_BINARY									2		/**< Binary packet format with windowed acknowledge */
  /** @} */ // end of HexFormats
 
  #include "Doxygen.h"
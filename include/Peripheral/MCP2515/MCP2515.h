@@ -69,6 +69,19 @@
  #endif
 
  #define MCP2515_MAX_DATABYTES		8					/**< Max. data bytes per message */
+ #define MCP2515_FILTER_GROUPS		16					/**< Number of filter groups used by the filter planner */
+
+ #if(defined MCP2515_USE_TX_QUEUE)
+	 #if((!defined MCP2515_TX_QUEUE_SIZE) || (MCP2515_TX_QUEUE_SIZE < 1) || (MCP2515_TX_QUEUE_SIZE > 254))
+		 #error "Invalid size for the MCP2515 transmit queue. Use a size between 1 and 254!"
+	 #endif
+ #endif
+
+ #if(defined MCP2515_USE_RX_FIFO)
+	 #if((!defined MCP2515_RX_FIFO_SIZE) || (MCP2515_RX_FIFO_SIZE < 2) || (MCP2515_RX_FIFO_SIZE > 128) || (MCP2515_RX_FIFO_SIZE & (MCP2515_RX_FIFO_SIZE - 1)))
+		 #error "Invalid size for the MCP2515 receive FIFO. Use a power of two between 2 and 128!"
+	 #endif
+ #endif
 
  /** @brief MCP2515 error codes.
   */
@@ -77,6 +90,7 @@
 	MCP2515_NO_ERROR = 0,								/**< No error */ 
 	MCP2515_INVALID_IDENTIFIER = -1,					/**< Invalid identifier */
 	MCP2515_TX_BUFFER_FULL = -2,						/**< Transmit buffer full */
+	MCP2515_TX_QUEUE_FULL = -3,							/**< Transmit queue full */
  } MCP2515_ErrorCode_t;
 
  /** @brief MCP2515 clock out prescaler.
@@ -192,6 +206,40 @@
 	 uint8_t* pData;									/**< Pointer to message data */
  } CAN_Message_t;
 
+ /** @brief MCP2515 frame object for the receive FIFO and the transmit queue.
+  */
+ typedef struct
+ {
+	 MCP2515_MessageType_t Type;						/**< Message type */
+	 uint32_t ID;										/**< Standard or extended message ID */
+	 uint8_t Length;									/**< Message length */
+	 uint8_t Data[MCP2515_MAX_DATABYTES];				/**< Message data */
+ } MCP2515_Frame_t;
+
+ #if(defined MCP2515_USE_RX_FIFO)
+	 /** @brief MCP2515 receive statistics.
+	  */
+	 typedef struct
+	 {
+		 uint32_t Frames;								/**< Number of frames stored in the receive FIFO */
+		 uint16_t SoftwareOverflows;					/**< Number of frames lost because the receive FIFO was full */
+		 uint16_t HardwareOverflows;					/**< Number of receive buffer overflows reported by the CAN controller */
+	 } MCP2515_RxStatistics_t;
+ #endif
+
+ #if(defined MCP2515_USE_STATISTICS)
+	 /** @brief MCP2515 traffic statistics.
+	  */
+	 typedef struct
+	 {
+		 uint32_t SPIBytes;								/**< Number of bytes sent over the SPI */
+		 uint32_t SPITransactions;						/**< Number of chip select cycles */
+		 uint32_t TxFrames;								/**< Number of transmitted frames */
+		 uint32_t RxFrames;								/**< Number of received frames */
+		 uint32_t Interrupts;							/**< Number of handled interrupts */
+	 } MCP2515_Statistics_t;
+ #endif
+
  /** @brief	MCP2515 interrupt handler
  */
  typedef void (*MCP2515_Callback_t)(void);
@@ -227,6 +275,28 @@
 	bool UseExtended;									/**< Set this to #true if you want to use extended frames */ 
  } MCP2515_FilterConfig_t;
 
+ /**
+  * MCP2515 identifier range for the filter planner
+  */
+ typedef struct
+ {
+	uint32_t Start;										/**< First identifier */
+	uint32_t End;										/**< Last identifier */
+ } MCP2515_IDRange_t;
+
+ /**
+  * MCP2515 filter plan
+  */
+ typedef struct
+ {
+	uint32_t Mask[2];									/**< Mask for RXB0 and RXB1 */
+	uint32_t Filter[6];									/**< Filter RXF0 - RXF5 */
+	uint32_t Wanted;									/**< Number of wanted identifiers */
+	uint32_t Accepted;									/**< Number of identifiers accepted by the filters */
+	uint16_t FalseAcceptRatio;							/**< Expected ratio of unwanted messages in permille \n
+															 NOTE: Assumes that all identifiers are used equally. */
+ } MCP2515_FilterPlan_t;
+
  /**
   * MCP2515 configuration object
   */
@@ -262,7 +332,7 @@
   *							NOTE: Set it to #NULL if you have initialized the SPI already
   *  @param DeviceConfig	Pointer to MCP2515 configuration object
   */
- void MCP2515_Init(SPIM_Config_t* Config, MCP2515_Config_t* DeviceConfig, MCP2515_ErrorCallback_t Bla);
+ void MCP2515_Init(SPIM_Config_t* Config, const MCP2515_Config_t* DeviceConfig);
 
  /** @brief					Configure the bit timing.
   *  @param Config			Pointer to bit timing configuration object
@@ -321,6 +391,18 @@
   */
  void MCP2515_ConfigFilter(const MCP2515_FilterConfig_t* Config); 
 
+ /** @brief				Calculate and program the masks and filters for a list of identifiers.
+  *						NOTE: The identifiers are merged into six filter groups and the groups are assigned to the receive
+  *						buffers with the least number of accepted identifiers. Both receive buffers use the filters afterwards.
+  *						The ranges can overlap and don't have to be sorted.
+  *  @param Ranges		Pointer to list of identifier ranges
+  *  @param Count		Number of identifier ranges
+  *  @param UseExtended	Set to #true for extended identifiers
+  *  @param Plan		Pointer to resulting filter plan
+  *  @return			Error code
+  */
+ MCP2515_ErrorCode_t MCP2515_PlanFilters(const MCP2515_IDRange_t* Ranges, const uint8_t Count, const bool UseExtended, MCP2515_FilterPlan_t* Plan);
+
  /** @brief			Request a message transmission.
   *  @param Buffer	Transmit buffer
   */
@@ -340,12 +422,54 @@
   */
  void MCP2515_ReadMessage(CAN_Message_t* Message);
 
- /** @brief				Send a CAN message.
+ /** @brief				Load a CAN message into the first free transmit buffer.
+  *						NOTE: Use #MCP2515_RequestTransmission to start the transmission.
   *  @param Message		Pointer to CAN message object
   *  @param Priority	Message priority
-  *  @param Buffer		Transmit buffer
   *  @return			Error code
   */
- MCP2515_ErrorCode_t MCP2515_PrepareMessage(CAN_Message_t* Message, const MCP2515_MessagePriority_t Priority, const MCP2515_TransmitBuffer_t Buffer);
+ MCP2515_ErrorCode_t MCP2515_PrepareMessage(CAN_Message_t* Message, const MCP2515_MessagePriority_t Priority);
+
+ #if(defined MCP2515_USE_TX_QUEUE)
+	 /** @brief				Add a CAN message to the transmit queue.
+	  *						NOTE: The transmit interrupt loads the queued messages into the transmit buffers. Messages with
+	  *						a higher priority are sent first. The queue doesn't use buffers loaded with #MCP2515_PrepareMessage.
+	  *  @param Frame		Pointer to frame object
+	  *  @param Priority	Message priority
+	  *  @return			Error code
+	  */
+	 MCP2515_ErrorCode_t MCP2515_Enqueue(const MCP2515_Frame_t* Frame, const MCP2515_MessagePriority_t Priority);
+ #endif
+
+ #if(defined MCP2515_USE_RX_FIFO)
+	 /** @brief			Get the oldest message from the receive FIFO.
+	  *					NOTE: The interrupt handler copies all received messages into the FIFO, so
+	  *					#MCP2515_ReadMessage doesn't find any message.
+	  *  @param Frame	Pointer to FIFO entry
+	  *  @return		#true if a message was available
+	  */
+	 bool MCP2515_Dequeue(MCP2515_Frame_t* Frame);
+
+	 /** @brief				Get the receive statistics.
+	  *  @param Statistics	Pointer to statistics object
+	  */
+	 void MCP2515_GetRxStatistics(MCP2515_RxStatistics_t* Statistics);
+
+	 /** @brief	Reset the receive statistics.
+	  */
+	 void MCP2515_ResetRxStatistics(void);
+ #endif
+
+ #if(defined MCP2515_USE_STATISTICS)
+	 /** @brief				Get the traffic statistics.
+	  *						NOTE: Use the ratio of #SPIBytes and the number of frames to measure the SPI load per frame.
+	  *  @param Statistics	Pointer to statistics object
+	  */
+	 void MCP2515_GetStatistics(MCP2515_Statistics_t* Statistics);
+
+	 /** @brief	Reset the traffic statistics.
+	  */
+	 void MCP2515_ResetStatistics(void);
+ #endif
  
 #endif /* MCP2515_H_ */
\ No newline at end of file
@@ -67,6 +67,22 @@
 	 #define SD_SS							&PORTE, 5
  #endif
 
+ #if(!defined SD_BUSY_TIMEOUT)
+	 #define SD_BUSY_TIMEOUT				250000UL
+ #endif
+
+ #if(defined SD_USE_DMA)
+	 #if((MCU_ARCH != MCU_ARCH_XMEGA) || (SD_INTERFACE_TYPE != INTERFACE_USART_SPI))
+		 #error "DMA support for the SD card is only available for XMega architecture with USART-SPI interface!"
+	 #endif
+
+	 #if((!defined SD_DMA_TX_CHANNEL) | (!defined SD_DMA_RX_CHANNEL) | (!defined SD_DMA_TX_TRIGGER) | (!defined SD_DMA_RX_TRIGGER) | (!defined SD_DMA_INT_LEVEL))
+		 #error "Invalid SD card DMA configuration. Please check the configuration file!"
+	 #endif
+
+	 #include "Arch/XMega/DMA/DMA.h"
+ #endif
+
  /** @brief SD card states.
   */
  typedef enum
@@ -107,8 +123,31 @@
 	 SD_ERASE_ERROR			= 0x08,		/**< Erase sequence error */
 	 SD_ADDRESS_ERROR		= 0x10,		/**< Address error */
 	 SD_PARAMETER_ERROR		= 0x20,		/**< Parameter error */
+	 SD_BUSY				= 0x40,		/**< Asynchronous transfer in progress */
+	 SD_TIMEOUT				= 0x80,		/**< The card doesn't leave the busy state */
  } SD_Error_t; 
  
+ /** @brief States of the asynchronous block transfer.
+  */
+ typedef enum
+ {
+	 SD_ASYNC_IDLE = 0x00,				/**< No transfer in progress */
+	 SD_ASYNC_TRANSFER = 0x01,			/**< Data block transfer in progress. The data buffer is in use */
+	 SD_ASYNC_BUSY = 0x02,				/**< The SD card is programming the last data block. The data buffer is released */
+ } SD_AsyncState_t;
+
+ #if(defined SD_USE_STATISTICS)
+	 /** @brief SD card write statistics.
+	  */
+	 typedef struct
+	 {
+		 uint32_t Writes;							/**< Number of written data blocks */
+		 uint32_t MaxBusyPolls;						/**< Worst-case number of busy polls after a write \n
+														 NOTE: One poll takes 8 SPI clock cycles when the card is polled with a blocking function. */
+		 uint16_t Timeouts;							/**< Number of busy timeouts */
+	 } SD_Statistics_t;
+ #endif
+
  /** @brief SD card OCR object.
   *			NOTE: Please check http://users.ece.utexas.edu/~valvano/EE345M/SD_Physical_Layer_Spec.pdf if you need additional information.
   */
@@ -243,6 +282,11 @@
  */
  typedef void (*SD_Callback_t)(const SD_State_t State);
 
+ /** @brief			SD asynchronous transfer callback definition.
+ *  @param Error	Error code of the transfer
+ */
+ typedef void (*SD_AsyncCallback_t)(const SD_Error_t Error);
+
  /** @brief		Check if a card is available.
   *  @return	#true if a card is available
   */
@@ -271,8 +315,10 @@
  #endif
 
  /** @brief	Abort all pending write processes.
+  *			NOTE: This function waits until the card has finished the programming of the last data block.
+  *  @return	Error code
   */
- void SD_Sync(void);
+ const SD_Error_t SD_Sync(void);
 
  /** @brief			Read the CSD register (16 bytes) of the SD card.
   *  @param Buffer	Pointer to CSD data
@@ -331,6 +377,7 @@
  const SD_Error_t SD_ReadDataBlocks(const uint32_t Address, const uint32_t Blocks, uint8_t* Buffer);
 
  /** @brief			Write a single data block to the SD card.
+  *					NOTE: The function returns when the card has accepted the data. The next access waits for the programming.
   *  @param Address	Start block
   *  @param Buffer	Pointer to data
   *  @return		Error code
@@ -338,6 +385,7 @@
  const SD_Error_t SD_WriteDataBlock(const uint32_t Address, const uint8_t* Buffer);
  
  /** @brief			Write multiple data blocks to the SD card.
+  *					NOTE: The blocks are pre-erased by the SD card before writing.
   *  @param Address	Start block
   *  @param Blocks	Data blocks
   *  @param Buffer	Pointer to data
@@ -345,4 +393,83 @@
   */
  const SD_Error_t SD_WriteDataBlocks(const uint32_t Address, const uint32_t Blocks, const uint8_t* Buffer);
 
+ /** @brief			Start a multiple block write to a contiguous sector run.
+  *					NOTE: The SD card stays selected until #SD_CloseStream is called. Don't use other SD card functions while the stream is open.
+  *  @param Address	Start block
+  *  @param Blocks	Expected number of data blocks for the pre-erase of the SD card \n
+  *					NOTE: Set to 0 if the number of blocks is unknown
+  *  @return		Error code
+  */
+ const SD_Error_t SD_OpenStream(const uint32_t Address, const uint32_t Blocks);
+
+ /** @brief			Append a single data block to the open stream.
+  *					NOTE: The stream is closed when an error occurs.
+  *  @param Buffer	Pointer to data
+  *  @return		Error code
+  */
+ const SD_Error_t SD_AppendStream(const uint8_t* Buffer);
+
+ /** @brief		Finish the multiple block write and release the SD card.
+  *  @return	Error code
+  */
+ const SD_Error_t SD_CloseStream(void);
+
+ /** @brief		Check once if the SD card is still programming the last data block.
+  *				NOTE: Write functions return without waiting for the programming. Call this function from the
+  *				main loop or a timer tick (not from an interrupt) to finish the busy phase before the next access.
+  *  @return	#true if the card is busy
+  */
+ const bool SD_IsBusy(void);
+
+ #if(defined SD_USE_STATISTICS)
+	 /** @brief				Get the write statistics of the SD card.
+	  *  @param Statistics	Pointer to statistics object
+	  */
+	 void SD_GetStatistics(SD_Statistics_t* Statistics);
+
+	 /** @brief	Reset the write statistics of the SD card.
+	  */
+	 void SD_ResetStatistics(void);
+ #endif
+
+ #if(defined SD_USE_DMA)
+	 /** @brief				Start the DMA transfer of a single data block from the SD card.
+	  *						NOTE: The DMA controller has to be initialized and the global interrupts have to be enabled.
+	  *  @param Address		Block address
+	  *  @param Buffer		Pointer to data
+	  *  @param Callback	Function pointer to completion callback (called from the DMA interrupt or from #SD_PollAsync when #SD_USE_CRC is set) \n
+	  *						NOTE: Set to #NULL if you do not need a callback
+	  *  @return			Error code or #SD_BUSY if a transfer is in progress. Waits until the SD card has finished the programming of the last data block
+	  */
+	 const SD_Error_t SD_ReadDataBlockAsync(const uint32_t Address, uint8_t* Buffer, SD_AsyncCallback_t Callback);
+
+	 /** @brief				Start the DMA transfer of a single data block to the SD card.
+	  *						NOTE: The DMA controller has to be initialized and the global interrupts have to be enabled.
+	  *						The callback is called when the data buffer is released. Use #SD_PollAsync to check if the SD card has finished the programming.
+	  *  @param Address		Block address
+	  *  @param Buffer		Pointer to data
+	  *  @param Callback	Function pointer to completion callback (called from the DMA interrupt) \n
+	  *						NOTE: Set to #NULL if you do not need a callback
+	  *  @return			Error code or #SD_BUSY if a transfer is in progress. Waits until the SD card has finished the programming of the last data block
+	  */
+	 const SD_Error_t SD_WriteDataBlockAsync(const uint32_t Address, const uint8_t* Buffer, SD_AsyncCallback_t Callback);
+
+	 /** @brief				Append a single data block to the open stream by using the DMA.
+	  *						NOTE: Use two buffers and fill the second buffer while the first buffer is transmitted.
+	  *						Call #SD_CloseStream if the callback reports an error.
+	  *  @param Buffer		Pointer to data
+	  *  @param Callback	Function pointer to completion callback (called from the DMA interrupt) \n
+	  *						NOTE: Set to #NULL if you do not need a callback
+	  *  @return			Error code or #SD_BUSY if a transfer is in progress. Waits until the SD card has finished the programming of the last data block
+	  */
+	 const SD_Error_t SD_AppendStreamAsync(const uint8_t* Buffer, SD_AsyncCallback_t Callback);
+
+	 /** @brief		Get the state of the asynchronous transfer.
+	  *				NOTE: This function checks the busy state of the SD card after a write transfer.
+	  *				The checksum of a read transfer is checked by this function when #SD_USE_CRC is set.
+	  *  @return	Transfer state
+	  */
+	 const SD_AsyncState_t SD_PollAsync(void);
+ #endif
+
 #endif /* SD_H_ */
\ No newline at end of file
@@ -85,6 +85,22 @@
   */
  void Display_WriteData(const uint8_t Data);
 
+ /** @brief			Write multiple data bytes to the display controller.
+  *					NOTE: The column address is incremented automatically by the display controller.
+  *  @param Data	Pointer to display data
+  *  @param Length	Number of data bytes
+  */
+ void Display_WriteDataBytes(const uint8_t* Data, const uint8_t Length);
+
+ /** @brief	Select the display controller and switch it into data mode.
+  *			NOTE: Use this function to stream data to the display with a DMA channel.
+  */
+ void Display_BeginData(void);
+
+ /** @brief	Leave the data mode and deselect the display controller.
+  */
+ void Display_EndData(void);
+
  /** @brief			Set the page address of the display controller.
   *  @param Line	Display page
   */
@@ -41,17 +41,40 @@
 	 typedef SPIM_Config_t DisplayInterface_t;
 
 	 #define DISPLAY_INTERFACE				SSD1306_INTERFACE
+	 #define DISPLAY_INTERFACE_TYPE			SSD1306_INTERFACE_TYPE
 	 #define DISPLAY_CLOCK					SSD1306_CLOCK
  #elif(defined USE_ST7565R)
 	 #include "Peripheral/ST7565R/ST7565R.h"
 	 typedef SPIM_Config_t DisplayInterface_t;
 
 	 #define DISPLAY_INTERFACE				ST7565R_INTERFACE
+	 #define DISPLAY_INTERFACE_TYPE			ST7565R_INTERFACE_TYPE
 	 #define DISPLAY_CLOCK					ST7565R_CLOCK
  #endif
 
  #include "Common/Font/Font.h"
- #include "Common/Framebuffer/Framebuffer.h"
+ #include "Common/FrameBuffer/FrameBuffer.h"
+
+ #if(defined DISPLAYMANAGER_USE_DMA)
+	 #if(MCU_ARCH != MCU_ARCH_XMEGA)
+		 #error "DMA support for the display manager is only available for XMega architecture!"
+	 #endif
+
+	 #if((!defined DISPLAYMANAGER_DMA_CHANNEL) | (!defined DISPLAYMANAGER_DMA_TRIGGER) | (!defined DISPLAYMANAGER_DMA_INT_LEVEL))
+		 #error "Invalid display manager DMA configuration. Please check the configuration file!"
+	 #endif
+
+	 #include "Arch/XMega/DMA/DMA.h"
+
+	 // The DMA engine transmits the modified frame buffer columns only
+	 #if(!defined DISPLAYMANAGER_USE_DEFERRED)
+		 #define DISPLAYMANAGER_USE_DEFERRED
+	 #endif
+ #endif
+
+ #if((defined DISPLAYMANAGER_USE_GLYPH_CACHE) && (!defined DISPLAYMANAGER_GLYPH_CACHE_SIZE))
+	 #error "Invalid display manager glyph cache configuration. Please check the configuration file!"
+ #endif
 
  #if((!defined DISPLAY_WIDTH) | (!defined DISPLAY_HEIGHT) | (!defined DISPLAY_PIXEL_PER_BYTE))
 	#error "Invalid display manager dimension configuration. Please check the configuration file!"
@@ -81,6 +104,20 @@
   *  @param Data	Data byte
   */
  extern void Display_WriteData(const uint8_t Data);
+
+ /** @brief			Write multiple data bytes to the display.
+  *  @param Data	Pointer to display data
+  *  @param Length	Number of data bytes
+  */
+ extern void Display_WriteDataBytes(const uint8_t* Data, const uint8_t Length);
+
+ /** @brief	Select the display and switch it into data mode.
+  */
+ extern void Display_BeginData(void);
+
+ /** @brief	Leave the data mode and deselect the display.
+  */
+ extern void Display_EndData(void);
  
  /** @brief			Set the display page.
   *  @param Page 	Display page
@@ -97,6 +134,10 @@
   */
  extern void Display_SetStartLine(const uint8_t Line);
 
+ /** @brief	Display manager callback definition.
+  */
+ typedef void (*DisplayManager_Callback_t)(void);
+
  /** @brief Fill options for drawing objects.
   */
  typedef enum
@@ -113,6 +154,16 @@
 	 PIXELMASK_CLEAR = 0x01,					/**< Clear the pixel */
  } PixelMask_t;
 
+ /** @brief Raster operations for bitmaps.
+  */
+ typedef enum
+ {
+	 RASTEROP_SET = 0x00,						/**< Set the pixel of the bitmap */
+	 RASTEROP_CLEAR = 0x01,						/**< Clear the pixel of the bitmap */
+	 RASTEROP_XOR = 0x02,						/**< Toggle the pixel of the bitmap */
+	 RASTEROP_COPY = 0x03,						/**< Replace the display content with the bitmap */
+ } RasterOp_t;
+
  /** @brief Circle segments.
   */
  typedef enum
@@ -148,8 +199,21 @@
 		 const uint8_t* RAM;
 		 const uint8_t* Flash; 
 	 } Data;									/**< Bitmap data */
+	 const uint8_t* Mask;						/**< Optional transparency mask with the layout of the bitmap data. \n
+													 NOTE: The mask is stored in the same memory as the bitmap data. Set to \c NULL for an opaque bitmap. */
  } Bitmap_t;
 
+ #if(defined DISPLAYMANAGER_USE_STATISTICS)
+	 /** @brief Display manager transfer statistics.
+	  */
+	 typedef struct
+	 {
+		 uint32_t DataBytes;						/**< Number of data bytes sent to the display */
+		 uint32_t Commands;							/**< Number of page and column address commands sent to the display */
+		 uint16_t Flushes;							/**< Number of frame buffer flushes */
+	 } DisplayManager_Statistics_t;
+ #endif
+
  /** @brief	Initialize the display manager service.
   */
  void DisplayManager_Init(void);
@@ -163,6 +227,39 @@
   */
  void DisplayManager_Clear(void);
 
+ /** @brief	Transmit all modified frame buffer columns to the display.
+  *			NOTE: The drawing functions only modify the frame buffer when #DISPLAYMANAGER_USE_DEFERRED is set.
+  *				  Call this function to update the display after drawing.
+  */
+ void DisplayManager_Flush(void);
+
+ #if(defined DISPLAYMANAGER_USE_DMA)
+	 /** @brief				Transmit all modified frame buffer columns to the display by using the DMA.
+	  *						NOTE: The DMA controller has to be initialized and the global interrupts have to be enabled.
+	  *							  Do not modify the frame buffer before the callback is called when #DISPLAYMANAGER_DMA_DOUBLE_BUFFER is not set.
+	  *  @param Callback	Function pointer to completion callback \n
+	  *						NOTE: Set to #NULL if you do not need a callback
+	  *  @return			#false if a transmission is already in progress
+	  */
+	 bool DisplayManager_FlushAsync(DisplayManager_Callback_t Callback);
+
+	 /** @brief		Get the status of the DMA transmission.
+	  *  @return	#true if a transmission is in progress
+	  */
+	 bool DisplayManager_IsBusy(void);
+ #endif
+
+ #if(defined DISPLAYMANAGER_USE_STATISTICS)
+	 /** @brief				Get the transfer statistics of the display manager.
+	  *  @param Statistics	Pointer to statistics object
+	  */
+	 void DisplayManager_GetStatistics(DisplayManager_Statistics_t* Statistics);
+
+	 /** @brief	Reset the transfer statistics of the display manager.
+	  */
+	 void DisplayManager_ResetStatistics(void);
+ #endif
+
  /** @brief			Clear a single display line (an entire page in the display controller).
   *  @param Line	Line number
   */
@@ -180,6 +277,26 @@
   */
  void DisplayManager_DrawPixel(const uint8_t x, const uint8_t y, const PixelMask_t Mask);
 
+ /** @brief			Fill or clear a rectangular area of the display.
+  *					NOTE: The area is clipped at the display borders.
+  *  @param x		x coordinate of the upper left corner
+  *  @param y		y coordinate of the upper left corner
+  *  @param Width	Width of the area
+  *  @param Height	Height of the area
+  *  @param Mask	Pixel mask
+  */
+ void DisplayManager_FillArea(const uint8_t x, const uint8_t y, const uint8_t Width, const uint8_t Height, const PixelMask_t Mask);
+
+ /** @brief			Draw a run of column bytes into a display page.
+  *					NOTE: The columns are clipped at the display borders.
+  *  @param Page	Display page
+  *  @param x		x coordinate of the first column
+  *  @param Data	Pointer to column data
+  *  @param Length	Number of columns
+  *  @param Mask	Pixel mask
+  */
+ void DisplayManager_DrawColumns(const uint8_t Page, const uint8_t x, const uint8_t* Data, const uint8_t Length, const PixelMask_t Mask);
+
  /** @brief			Draw a line between two points.
   *  @param x1		Start coordinate (x direction)
   *  @param y1		Start coordinate (y direction)
@@ -238,13 +355,23 @@
  void DisplayManager_DrawCircleSegment(const uint8_t x, const uint8_t y, const uint8_t Radius, const CircleSegment_t Segment, const FillOptions_t Fill, const PixelMask_t Mask);
 
  /** @brief			Draw a bitmap on the display.
-  *					NOTE: Use the python script https://gitlab.com/Kampi/Python/blob/master/Bitmap2Array.py to generate the array
+  *					NOTE: Use the python script https://gitlab.com/Kampi/Python/blob/master/Bitmap2Array.py to generate the array.
+  *					The pixels of the bitmap are set with #RASTEROP_SET.
   *  @param x		x coordinate
   *  @param y		y coordinate
   *  @param Bitmap	Pointer to bitmap object
   */
  void DisplayManager_DrawBitmap(const uint8_t x, const uint8_t y, const Bitmap_t* Bitmap);
 
+ /** @brief				Copy a bitmap into the display with a raster operation.
+  *						NOTE: The bitmap is clipped at the display borders. Only pixels with a set bit in the transparency mask are modified.
+  *  @param x			x coordinate (can be negative)
+  *  @param y			y coordinate (can be negative)
+  *  @param Bitmap		Pointer to bitmap object
+  *  @param Operation	Raster operation
+  */
+ void DisplayManager_BlitBitmap(const int16_t x, const int16_t y, const Bitmap_t* Bitmap, const RasterOp_t Operation);
+
  /** @brief			Draw a string on the display.
   *  @param x		x coordinate
   *  @param y		y coordinate
@@ -31,6 +31,41 @@
 #ifndef FATFS_H_
 #define FATFS_H_
  
+ #include "Common/Common.h"
+
  #include "../source/Services/FatFs/fatfs-r0.13c/source/ff.h"
 
+ #if(defined FATFS_USE_CACHE)
+	 #if((!defined FATFS_CACHE_SECTORS) || (FATFS_CACHE_SECTORS < 1) || (FATFS_CACHE_SECTORS > 254))
+		 #error "Invalid size for the sector cache. Please check the configuration file!"
+	 #endif
+
+	 /** @brief Sector cache statistics.
+	  */
+	 typedef struct
+	 {
+		 uint32_t Hits;								/**< Number of sector accesses served by the cache */
+		 uint32_t Misses;							/**< Number of sector accesses which need a new cache entry */
+		 uint32_t WriteBacks;						/**< Number of modified sectors written to the SD card */
+	 } FatFs_CacheStatistics_t;
+
+	 /** @brief			Pin a region of sectors in the sector cache.
+	  *					NOTE: Pinned sectors are only replaced if all cache entries are pinned. Use it for the FAT
+	  *					region after mounting the volume (start sector \c fatbase and \c fsize * \c n_fats sectors
+	  *					of the #FATFS object).
+	  *  @param Sector	Start sector
+	  *  @param Count	Number of sectors
+	  */
+	 void FatFs_CachePin(const uint32_t Sector, const uint32_t Count);
+
+	 /** @brief				Get the statistics of the sector cache.
+	  *  @param Statistics	Pointer to statistics object
+	  */
+	 void FatFs_GetCacheStatistics(FatFs_CacheStatistics_t* Statistics);
+
+	 /** @brief	Reset the statistics of the sector cache.
+	  */
+	 void FatFs_ResetCacheStatistics(void);
+ #endif
+
 #endif /* FATFS_H_ */
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+ * KeyValueStore.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Wear leveled key/value store for the XMega EEPROM.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Services/KeyValueStore/KeyValueStore.h
+ *  @brief Wear leveled key/value store for the XMega EEPROM.
+ *
+ *  This contains the prototypes and definitions for the key/value store. The store uses #KVS_PAGES EEPROM pages
+ *  (starting with page #KVS_FIRST_PAGE) as a ring buffer and appends each value as a new record:
+ *
+ *		| Key | Length | Sequence (2) | Data (Length) | CRC-8 |
+ *
+ *  A record is written with a partial page write into the erased part of a page, so an update doesn't erase a page.
+ *  The newest record of a key (highest sequence number) is valid and a RAM index stores the address of each key.
+ *  When the current page is full the store moves to the next page and copies the valid records of the oldest page
+ *  into the new page before the oldest page is erased. So each page is erased only once per pass through the ring.
+ *  The page behind the current page is always erased. The key of a record is written at last, so a write which is interrupted
+ *  by a reset leaves an erased key and the rest of the page isn't used anymore. The CRC detects corrupted records.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef KEYVALUESTORE_H_
+#define KEYVALUESTORE_H_
+
+ #include "Common/Common.h"
+
+ #if(MCU_ARCH == MCU_ARCH_XMEGA)
+	 #include "Arch/XMega/NVM/NVM.h"
+ #else
+	 #error "Architecture not supported!"
+ #endif
+
+ #if(!defined KVS_FIRST_PAGE)
+	 #define KVS_FIRST_PAGE						0
+ #endif
+
+ #if(!defined KVS_PAGES)
+	 #define KVS_PAGES							8
+ #endif
+
+ #if(!defined KVS_MAX_KEYS)
+	 #define KVS_MAX_KEYS						16
+ #endif
+
+ #if(KVS_PAGES < 3)
+	 #error "The key/value store needs at least three EEPROM pages!"
+ #endif
+
+ #define KVS_HEADER_BYTES						0x04						/**< Size of the record header */
+ #define KVS_MAX_LENGTH							(EEPROM_PAGE_SIZE - KVS_HEADER_BYTES - 0x01)	/**< Max. length of a value */
+
+ /** @brief Key/value store error codes.
+  */
+ typedef enum
+ {
+	 KVS_NO_ERROR = 0x00,										/**< No error */
+	 KVS_INVALID_PARAM = 0x01,									/**< Invalid parameter */
+	 KVS_NOT_FOUND = 0x02,										/**< Key not found */
+	 KVS_FULL = 0x03,											/**< Not enough space for the record */
+ } KeyValueStore_Error_t;
+
+ /** @brief	Erase all pages of the key/value store.
+  */
+ void KeyValueStore_Format(void);
+
+ /** @brief	Initialize the key/value store and build the index from the records in the EEPROM.
+			NOTE: The EEPROM pages have to be erased with #KeyValueStore_Format before the first use.
+  */
+ void KeyValueStore_Init(void);
+
+ /** @brief			Write a value. Nothing is written when the value doesn't change.
+  *  @param Key		Key
+  *  @param Length	Length of the value
+  *  @param Data	Pointer to value
+  *  @return		Error code
+  */
+ KeyValueStore_Error_t KeyValueStore_Write(const uint8_t Key, const uint8_t Length, const void* Data);
+
+ /** @brief			Read a value.
+  *  @param Key		Key
+  *  @param Length	Pointer to the size of the data buffer. Returns the length of the value
+  *  @param Data	Pointer to data buffer
+  *  @return		Error code
+  */
+ KeyValueStore_Error_t KeyValueStore_Read(const uint8_t Key, uint8_t* Length, void* Data);
+
+ /** @brief			Delete a value.
+  *  @param Key		Key
+  *  @return		Error code
+  */
+ KeyValueStore_Error_t KeyValueStore_Delete(const uint8_t Key);
+
+#endif /* KEYVALUESTORE_H_ */
\ No newline at end of file
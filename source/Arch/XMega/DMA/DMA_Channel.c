@@ -53,7 +53,8 @@ static void _DMA_Channel_InterruptHandler(const uint8_t Channel)
 	{
 		if(_DMA_Callbacks[Channel].TransactionComplete)
 		{
-			DMA_WriteStatus(Status | (0x01 << Channel));
+			// Only clear the flag of this channel, because writing a one clears the flag
+			DMA_WriteStatus(0x01 << Channel);
 			_DMA_Callbacks[Channel].TransactionComplete(Channel);
 		}
 	}
@@ -62,7 +63,7 @@ static void _DMA_Channel_InterruptHandler(const uint8_t Channel)
 	{
 		if(_DMA_Callbacks[Channel].Error)
 		{
-			DMA_WriteStatus(Status | (0x0A << Channel));
+			DMA_WriteStatus(0x10 << Channel);
 			_DMA_Callbacks[Channel].Error(Channel);
 		}
 	}
@@ -120,17 +121,21 @@ void DMA_Channel_InstallCallback(DMA_InterruptConfig_t* Config)
 	{
 		Channel = 0x00;
 	}
-	#if(DMA_CHANNEL > 2)
+	#if(DMA_CHANNEL > 1)
 		else if(Config->Channel == &DMA.CH1)
 		{
 			Channel = 0x01;
 		}
-	#elif(DMA_CHANNEL > 2)
+	#endif
+
+	#if(DMA_CHANNEL > 2)
 		else if(Config->Channel == &DMA.CH2)
 		{
 			Channel = 0x02;
 		}
-	#elif(DMA_CHANNEL > 3)
+	#endif
+
+	#if(DMA_CHANNEL > 3)
 		else if(Config->Channel == &DMA.CH3)
 		{
 			Channel = 0x03;
@@ -257,21 +262,21 @@ ISR(DMA_CH0_vect)
 	_DMA_Channel_InterruptHandler(0);
 }
 
-#if(DMA_CHANNEL_COUNT > 1)
+#if(DMA_CHANNEL > 1)
 	ISR(DMA_CH1_vect)
 	{
 		_DMA_Channel_InterruptHandler(1);
 	}
 #endif
 
-#if(DMA_CHANNEL_COUNT > 2)
+#if(DMA_CHANNEL > 2)
 	ISR(DMA_CH2_vect)
 	{
 		_DMA_Channel_InterruptHandler(2);
 	}
 #endif
 
-#if(DMA_CHANNEL_COUNT > 3)
+#if(DMA_CHANNEL > 3)
 	ISR(DMA_CH3_vect)
 	{
 		_DMA_Channel_InterruptHandler(3);
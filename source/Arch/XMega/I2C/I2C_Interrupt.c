@@ -46,6 +46,141 @@
 	I2C_Buffer_t _I2CS_Buffer[TWI_DEVICES];
 #endif
 
+#if(defined I2CM_USE_QUEUE)
+	/*
+		Transaction queue for each TWI master
+	*/
+	static struct
+	{
+		TWI_t* Device;
+		I2CM_Transaction_t* Active;
+		I2CM_Transaction_t* Last;
+		uint8_t Index;
+		bool Reading;
+	} _I2CM_Queue[TWI_DEVICES];
+
+	/** @brief			Start the active transaction of the transaction queue.
+	 *  @param Device	Device ID
+	 */
+	static void _I2CM_QueueStart(const uint8_t Device)
+	{
+		I2CM_Transaction_t* Transaction = _I2CM_Queue[Device].Active;
+
+		_I2CM_Queue[Device].Index = 0x00;
+
+		// Writing the address generates a start condition or a repeated start when the bus is still owned
+		if(Transaction->WriteLength > 0x00)
+		{
+			_I2CM_Queue[Device].Reading = false;
+			_I2CM_Queue[Device].Device->MASTER.ADDR = I2C_WRITE(Transaction->Address);
+		}
+		else
+		{
+			_I2CM_Queue[Device].Reading = true;
+			_I2CM_Queue[Device].Device->MASTER.ADDR = I2C_READ(Transaction->Address);
+		}
+	}
+
+	/** @brief			Finish the active transaction and start the next transaction of the transaction queue.
+	 *  @param Device	Device ID
+	 *  @param Error	Error code of the active transaction
+	 */
+	static void _I2CM_QueueFinish(const uint8_t Device, const I2C_Error_t Error)
+	{
+		I2CM_Transaction_t* Transaction = _I2CM_Queue[Device].Active;
+		TWI_t* TWI = _I2CM_Queue[Device].Device;
+
+		_I2CM_Queue[Device].Active = Transaction->Next;
+		if(_I2CM_Queue[Device].Active == NULL)
+		{
+			_I2CM_Queue[Device].Last = NULL;
+		}
+
+		if((Error != I2C_NO_ERROR) || (_I2CM_Queue[Device].Active == NULL))
+		{
+			// Release the bus. The last byte of a read has to be answered with a NACK
+			TWI->MASTER.CTRLC = (_I2CM_Queue[Device].Reading ? TWI_MASTER_ACKACT_bm : 0x00) | TWI_MASTER_CMD_STOP_gc;
+		}
+		else if(_I2CM_Queue[Device].Reading)
+		{
+			// The NACK is sent before the repeated start
+			TWI->MASTER.CTRLC = TWI_MASTER_ACKACT_bm;
+		}
+
+		if(_I2CM_Queue[Device].Active != NULL)
+		{
+			_I2CM_QueueStart(Device);
+		}
+
+		Transaction->Error = Error;
+		Transaction->Status = (Error == I2C_NO_ERROR) ? I2CM_TRANSACTION_COMPLETE : I2CM_TRANSACTION_ERROR;
+
+		if(Transaction->Callback != NULL)
+		{
+			Transaction->Callback(Transaction);
+		}
+	}
+
+	/** @brief			I2C master interrupt handler for the transaction queue.
+	 *  @param Device	Device ID
+	 *  @param Status	Status of the TWI master
+	 */
+	static void _I2CM_QueueHandler(const uint8_t Device, const uint8_t Status)
+	{
+		I2CM_Transaction_t* Transaction = _I2CM_Queue[Device].Active;
+		TWI_t* TWI = _I2CM_Queue[Device].Device;
+
+		if(Status & (TWI_MASTER_ARBLOST_bm | TWI_MASTER_BUSERR_bm))
+		{
+			_I2CM_QueueFinish(Device, I2C_BUS_ERROR);
+		}
+		else if(Status & TWI_MASTER_WIF_bm)
+		{
+			// A NACK for the address means that there is no device
+			if(Status & TWI_MASTER_RXACK_bm)
+			{
+				_I2CM_QueueFinish(Device, (_I2CM_Queue[Device].Index == 0x00) ? I2C_NO_DEVICE : I2C_BUS_ERROR);
+			}
+			else if(_I2CM_Queue[Device].Reading)
+			{
+				_I2CM_QueueFinish(Device, I2C_BUS_ERROR);
+			}
+			else if(_I2CM_Queue[Device].Index < Transaction->WriteLength)
+			{
+				TWI->MASTER.DATA = Transaction->WriteData[_I2CM_Queue[Device].Index++];
+			}
+			else if(Transaction->ReadLength > 0x00)
+			{
+				// Switch to the read phase with a repeated start
+				_I2CM_Queue[Device].Reading = true;
+				_I2CM_Queue[Device].Index = 0x00;
+				TWI->MASTER.ADDR = I2C_READ(Transaction->Address);
+			}
+			else
+			{
+				_I2CM_QueueFinish(Device, I2C_NO_ERROR);
+			}
+		}
+		else if(Status & TWI_MASTER_RIF_bm)
+		{
+			Transaction->ReadData[_I2CM_Queue[Device].Index++] = TWI->MASTER.DATA;
+
+			if(_I2CM_Queue[Device].Index < Transaction->ReadLength)
+			{
+				TWI->MASTER.CTRLC = TWI_MASTER_CMD_RECVTRANS_gc;
+			}
+			else
+			{
+				_I2CM_QueueFinish(Device, I2C_NO_ERROR);
+			}
+		}
+		else
+		{
+			_I2CM_QueueFinish(Device, I2C_BUS_ERROR);
+		}
+	}
+#endif
+
 /** @brief			I2C error handler for master mode.
  *  @param Device	Device ID
  */
@@ -167,6 +302,15 @@ static void _I2CM_ReadHandler(const uint8_t Device)
  */
 static void _I2CM_InterruptHandler(const uint8_t Device)
 {
+	#if(defined I2CM_USE_QUEUE)
+		if(_I2CM_Queue[Device].Active != NULL)
+		{
+			_I2CM_QueueHandler(Device, I2CM_ReadStatus(_I2CM_Queue[Device].Device));
+
+			return;
+		}
+	#endif
+
 	uint8_t Status = I2CM_ReadStatus(_I2CM_Messages[Device].Device);
 	
 	// Check the interface status
@@ -200,6 +344,56 @@ void I2CM_DisableInterruptSupport(TWI_t* Device)
 	Device->MASTER.CTRLA &= ~(0x03 << 0x06);
 }
 
+#if(defined I2CM_USE_QUEUE)
+	I2C_Error_t I2CM_Enqueue(TWI_t* Device, I2CM_Transaction_t* Transaction)
+	{
+		uint8_t ID = 0x00;
+
+		if(Device == &TWIE)
+		{
+			ID = TWIE_ID;
+		}
+
+		if((Transaction->WriteLength == 0x00) && (Transaction->ReadLength == 0x00))
+		{
+			return I2C_INVALID_PARAM;
+		}
+
+		Transaction->Next = NULL;
+		Transaction->Status = I2CM_TRANSACTION_PENDING;
+		Transaction->Error = I2C_NO_ERROR;
+
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			if(_I2CM_Queue[ID].Active == NULL)
+			{
+				_I2CM_Queue[ID].Device = Device;
+				_I2CM_Queue[ID].Active = Transaction;
+				_I2CM_Queue[ID].Last = Transaction;
+
+				_I2CM_QueueStart(ID);
+			}
+			else
+			{
+				_I2CM_Queue[ID].Last->Next = Transaction;
+				_I2CM_Queue[ID].Last = Transaction;
+			}
+		}
+
+		return I2C_NO_ERROR;
+	}
+
+	bool I2CM_QueueIsIdle(const TWI_t* Device)
+	{
+		if(Device == &TWIE)
+		{
+			return (_I2CM_Queue[TWIE_ID].Active == NULL);
+		}
+
+		return (_I2CM_Queue[TWIC_ID].Active == NULL);
+	}
+#endif
+
 /** @brief			I2C error handler for slave mode.
  *  @param Device	Device ID
  */
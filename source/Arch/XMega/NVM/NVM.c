@@ -110,6 +110,34 @@ void NVM_EEPROMWritePage(const uint8_t Page, const uint8_t Length, const uint8_t
 	NVM_ExecuteCommand(NVM_CMD_ERASE_WRITE_EEPROM_PAGE_gc);
 }
 
+void NVM_EEPROMWriteBytes(const uint8_t Page, const uint8_t Offset, const uint8_t Length, const uint8_t* Data)
+{
+	// Check the address
+	if((Page >= (EEPROM_SIZE / EEPROM_PAGE_SIZE)) || ((Offset + Length) > EEPROM_PAGE_SIZE))
+	{
+		return;
+	}
+
+	NVM_FlushEEBuffer();
+	NVM.CMD = NVM_CMD_LOAD_EEPROM_BUFFER_gc;
+
+	uint16_t Address = (uint16_t)(Page * EEPROM_PAGE_SIZE);
+
+	NVM.ADDR1 = (Address >> 0x08) & 0x1F;
+	NVM.ADDR2 = 0x00;
+
+	// Only the loaded bytes are written by the page write
+	for(uint8_t i = 0x00; i < Length; i++)
+	{
+		NVM.ADDR0 = (Address & 0xFF) | (Offset + i);
+		NVM.DATA0 = *Data++;
+	}
+
+	NVM.ADDR0 = Address & 0xFF;
+
+	NVM_ExecuteCommand(NVM_CMD_WRITE_EEPROM_PAGE_gc);
+}
+
 uint8_t NVM_EEPROMReadByte(const uint8_t Page, const uint8_t Offset)
 {
 	// Check the address
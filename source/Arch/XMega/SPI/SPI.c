@@ -57,7 +57,7 @@ void SPI_InstallCallback(const SPI_InterruptConfig_t* Config)
 	}
 	else if(Config->Device == &SPID)
 	{
-		ID = SPIE_ID;
+		ID = SPID_ID;
 	}
 	
 	#if(defined SPIE)
@@ -96,7 +96,7 @@ void SPI_RemoveCallback(SPI_t* Device, const SPI_CallbackType_t Callback)
 	}
 	else if(Device == &SPID)
 	{
-		ID = SPIE_ID;
+		ID = SPID_ID;
 	}
 	
 	#if(defined SPIE)
@@ -107,7 +107,7 @@ void SPI_RemoveCallback(SPI_t* Device, const SPI_CallbackType_t Callback)
 	#endif
 		
 	#if(defined SPIF)
-		else if(>Device == &SPIF)
+		else if(Device == &SPIF)
 		{
 			ID = SPIF_ID;
 		}
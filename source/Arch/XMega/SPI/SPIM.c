@@ -49,7 +49,7 @@ void SPIM_Init(SPIM_Config_t* Config)
 	}
 	else if(Config->Device == &SPID)
 	{
-		ID = SPIE_ID;
+		ID = SPID_ID;
 	}
 	
 	#if(defined SPIE)
@@ -165,7 +165,7 @@ const uint8_t SPIM_SendData(SPI_t* Device, const uint8_t Data)
 	return Device->DATA;
 }
 
-SPI_Status_t SPIM_Transmit(SPI_t* Device, const uint8_t Bytes, uint8_t* WriteBuffer, uint8_t* ReadBuffer, PORT_t* Port, const uint8_t Pin)
+SPI_Status_t SPIM_Transmit(SPI_t* Device, const uint16_t Bytes, uint8_t* WriteBuffer, uint8_t* ReadBuffer, PORT_t* Port, const uint8_t Pin)
 {
 	uint8_t ID = 0x00;
 	
@@ -175,7 +175,7 @@ SPI_Status_t SPIM_Transmit(SPI_t* Device, const uint8_t Bytes, uint8_t* WriteBuf
 	}
 	else if(Device == &SPID)
 	{
-		ID = SPIE_ID;
+		ID = SPID_ID;
 	}
 	
 	#if(defined SPIE)
@@ -186,7 +186,7 @@ SPI_Status_t SPIM_Transmit(SPI_t* Device, const uint8_t Bytes, uint8_t* WriteBuf
 	#endif
 	
 	#if(defined SPIF)
-		else if(>Device == &SPIF)
+		else if(Device == &SPIF)
 		{
 			ID = SPIF_ID;
 		}
@@ -209,6 +209,9 @@ SPI_Status_t SPIM_Transmit(SPI_t* Device, const uint8_t Bytes, uint8_t* WriteBuf
 	
 	SPIM_SelectDevice(_SPIM_Messages[ID].Port, _SPIM_Messages[ID].Pin);
 	
+	// The first byte starts the transmission. The remaining bytes are transmitted by the interrupt
+	Device->DATA = WriteBuffer[0];
+
 	return SPI_MESSAGE_PENDING;
 }
 
@@ -222,7 +225,7 @@ const SPI_Status_t SPIM_Status(const SPI_t* Device)
 	}
 	else if(Device == &SPID)
 	{
-		ID = SPIE_ID;
+		ID = SPID_ID;
 	}
 	
 	#if(defined SPIE)
@@ -41,19 +41,263 @@
 	} _SPI_Callbacks[SPI_DEVICES];
 
 	SPI_Message_t _SPIM_Messages[SPI_DEVICES];
-	SPI_DeviceMode_t _SPI_DeviceMode[SPI_DEVICES];
+	extern SPI_DeviceMode_t _SPI_DeviceModes[SPI_DEVICES];
 	SPI_Buffer_t _SPI_SlaveBuffer[SPI_DEVICES];
 #endif
 
+#if(defined SPIM_USE_QUEUE)
+	#if(defined SPIM_USE_DMA)
+		#if(!defined SPIM_DMA_CHANNEL)
+			#error "No DMA channel for the SPI transmission defined!"
+		#endif
+
+		#if(!defined SPIM_DMA_INT_LEVEL)
+			#define SPIM_DMA_INT_LEVEL						INT_LVL_LO
+		#endif
+
+		#if(!defined SPIM_DMA_THRESHOLD)
+			#define SPIM_DMA_THRESHOLD						16
+		#endif
+
+		// The first byte is written by the CPU and the DMA needs at least one byte
+		#if(SPIM_DMA_THRESHOLD < 2)
+			#error "SPIM_DMA_THRESHOLD must be at least 2!"
+		#endif
+
+		static volatile bool _SPIM_DMABusy;
+		static uint8_t _SPIM_DMADevice;
+		static uint8_t _SPIM_DMALevel;
+	#endif
+
+	/*
+		Transaction queue for each SPI master
+	*/
+	static struct
+	{
+		SPI_t* Device;
+		SPIM_Transaction_t* Active;
+		SPIM_Transaction_t* Last;
+		const SPIM_BusDevice_t* Current;
+		const SPIM_BusDevice_t* Selected;
+		uint16_t Index;
+	} _SPIM_Queue[SPI_DEVICES];
+
+	#if(defined SPIM_USE_DMA)
+		static void _SPIM_QueueHandler(const uint8_t Device);
+
+		/** @brief			DMA transaction complete callback.
+		 *  @param Channel	DMA channel
+		 */
+		static void _SPIM_DMACallback(const uint8_t Channel)
+		{
+			SPI_t* SPI = _SPIM_Queue[_SPIM_DMADevice].Device;
+
+			_SPIM_DMABusy = false;
+
+			// The DMA doesn't clear the interrupt flag of the previous bytes, so clear it before waiting for the last byte
+			(void)SPI->STATUS;
+			(void)SPI->DATA;
+
+			// The last byte can be shifted out before the callback is called. Limit the wait to the duration of one
+			// byte (8 SPI clocks with the current prescaler)
+			uint16_t Polls = 0x08 << ((SPI->CTRL & SPI_PRESCALER_gm) << 0x01);
+			while(!(SPI->STATUS & SPI_IF_bm) && Polls--);
+
+			// Finish the transaction like the SPI interrupt
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+			{
+				SPI->INTCTRL |= _SPIM_DMALevel;
+				_SPIM_QueueHandler(_SPIM_DMADevice);
+			}
+		}
+
+		/** @brief			Transmit the active transaction with the DMA.
+		 *  @param Device	Device ID
+		 *  @return			#false if the DMA can not be used for the transaction
+		 */
+		static bool _SPIM_DMAStart(const uint8_t Device)
+		{
+			SPIM_Transaction_t* Transaction = _SPIM_Queue[Device].Active;
+			SPI_t* SPI = _SPIM_Queue[Device].Device;
+			DMA_TriggerSource_t Trigger = DMA_TRIGGER_SPIC;
+
+			// The SPI has only one DMA trigger, so only write transactions can be handled by one channel
+			if(_SPIM_DMABusy || (Transaction->Length < SPIM_DMA_THRESHOLD) || (Transaction->ReadData != NULL) || (Transaction->WriteData == NULL))
+			{
+				return false;
+			}
+
+			if(SPI == &SPID)
+			{
+				Trigger = DMA_TRIGGER_SPID;
+			}
+
+			#if(defined SPIE)
+				else if(SPI == &SPIE)
+				{
+					Trigger = DMA_TRIGGER_SPIE;
+				}
+			#endif
+
+			#if(defined SPIF)
+				else if(SPI == &SPIF)
+				{
+					Trigger = DMA_TRIGGER_SPIF;
+				}
+			#endif
+
+			DMA_TransferConfig_t Config = {
+				.Channel = &SPIM_DMA_CHANNEL,
+				.EnableSingleShot = true,
+				.EnableRepeatMode = false,
+				.BurstLength = DMA_BURSTLENGTH_1,
+				.SrcReload = DMA_ADDRESS_RELOAD_NONE,
+				.DstReload = DMA_ADDRESS_RELOAD_NONE,
+				.SrcAddrMode = DMA_ADDRESS_MODE_INC,
+				.DstAddrMode = DMA_ADDRESS_MODE_FIXED,
+				.TriggerSource = Trigger,
+				.TransferCount = Transaction->Length - 0x01,
+				.RepeatCount = 0x00,
+				.SrcAddress = (uintptr_t)&Transaction->WriteData[1],
+				.DstAddress = (uintptr_t)&SPI->DATA,
+			};
+
+			DMA_InterruptConfig_t DMAInterrupt = {
+				.Channel = &SPIM_DMA_CHANNEL,
+				.Source = DMA_TRANSACTION_INTERRUPT,
+				.InterruptLevel = SPIM_DMA_INT_LEVEL,
+				.Callback = _SPIM_DMACallback,
+			};
+
+			_SPIM_DMABusy = true;
+			_SPIM_DMADevice = Device;
+
+			// The SPI interrupt would compete with the DMA
+			_SPIM_DMALevel = SPI->INTCTRL & 0x03;
+			SPI->INTCTRL &= ~0x03;
+
+			// The DMA callback handles the last byte
+			_SPIM_Queue[Device].Index = Transaction->Length - 0x01;
+
+			DMA_Channel_Config(&Config);
+			DMA_Channel_InstallCallback(&DMAInterrupt);
+			DMA_Channel_Enable(&SPIM_DMA_CHANNEL);
+
+			// Each transmitted byte triggers the next transfer
+			SPI->DATA = Transaction->WriteData[0];
+
+			return true;
+		}
+	#endif
+
+	/** @brief			Start the active transaction of the transaction queue.
+	 *  @param Device	Device ID
+	 */
+	static void _SPIM_QueueStart(const uint8_t Device)
+	{
+		SPIM_Transaction_t* Transaction = _SPIM_Queue[Device].Active;
+		const SPIM_BusDevice_t* BusDevice = Transaction->BusDevice;
+		SPI_t* SPI = _SPIM_Queue[Device].Device;
+
+		if((_SPIM_Queue[Device].Selected != NULL) && (_SPIM_Queue[Device].Selected != BusDevice))
+		{
+			SPIM_DeselectDevice(_SPIM_Queue[Device].Selected->Port, _SPIM_Queue[Device].Selected->Pin);
+			_SPIM_Queue[Device].Selected = NULL;
+		}
+
+		// Only reconfigure the interface when the bus switches to another device
+		if(_SPIM_Queue[Device].Current != BusDevice)
+		{
+			SPI_SetMode(SPI, BusDevice->Mode);
+			SPI_SetDataOrder(SPI, BusDevice->DataOrder);
+			SPIM_SwitchDoubleSpeed(SPI, false);
+			SPIM_SetPrescaler(SPI, BusDevice->Prescaler);
+
+			_SPIM_Queue[Device].Current = BusDevice;
+		}
+
+		if(_SPIM_Queue[Device].Selected == NULL)
+		{
+			SPIM_SelectDevice(BusDevice->Port, BusDevice->Pin);
+			_SPIM_Queue[Device].Selected = BusDevice;
+		}
+
+		_SPIM_Queue[Device].Index = 0x00;
+
+		#if(defined SPIM_USE_DMA)
+			if(_SPIM_DMAStart(Device))
+			{
+				return;
+			}
+		#endif
+
+		SPI->DATA = (Transaction->WriteData != NULL) ? Transaction->WriteData[0] : 0xFF;
+	}
+
+	/** @brief			SPI master interrupt handler for the transaction queue.
+	 *  @param Device	Device ID
+	 */
+	static void _SPIM_QueueHandler(const uint8_t Device)
+	{
+		SPIM_Transaction_t* Transaction = _SPIM_Queue[Device].Active;
+		SPI_t* SPI = _SPIM_Queue[Device].Device;
+		uint8_t Data = SPI->DATA;
+
+		if(Transaction->ReadData != NULL)
+		{
+			Transaction->ReadData[_SPIM_Queue[Device].Index] = Data;
+		}
+
+		if(++_SPIM_Queue[Device].Index < Transaction->Length)
+		{
+			SPI->DATA = (Transaction->WriteData != NULL) ? Transaction->WriteData[_SPIM_Queue[Device].Index] : 0xFF;
+
+			return;
+		}
+
+		if(!Transaction->KeepSelected)
+		{
+			SPIM_DeselectDevice(Transaction->BusDevice->Port, Transaction->BusDevice->Pin);
+			_SPIM_Queue[Device].Selected = NULL;
+		}
+
+		_SPIM_Queue[Device].Active = Transaction->Next;
+		if(_SPIM_Queue[Device].Active == NULL)
+		{
+			_SPIM_Queue[Device].Last = NULL;
+		}
+		else
+		{
+			_SPIM_QueueStart(Device);
+		}
+
+		Transaction->Status = SPI_MESSAGE_COMPLETE;
+
+		if(Transaction->Callback != NULL)
+		{
+			Transaction->Callback(Transaction);
+		}
+	}
+#endif
+
 /** @brief			SPI interrupt handler.
  *  @param Device	Device ID
  */
 static void _SPI_InterruptHandler(const uint8_t Device)
 {
+	#if(defined SPIM_USE_QUEUE)
+		if(_SPIM_Queue[Device].Active != NULL)
+		{
+			_SPIM_QueueHandler(Device);
+
+			return;
+		}
+	#endif
+
 	SPI_t* Device_Ptr = _SPIM_Messages[Device].Device;
 
 	// Check if master or slave mode
-	if(_SPI_DeviceMode[Device] == SPI_MASTER)
+	if(_SPI_DeviceModes[Device] == SPI_MASTER)
 	{
 		// Check for error
 		if(Device_Ptr->STATUS & SPI_WRCOL_bm)
@@ -112,6 +356,91 @@ void SPI_DisableInterruptSupport(SPI_t* Device)
 	Device->INTCTRL &= ~0x03;
 }
 
+#if(defined SPIM_USE_QUEUE)
+	void SPIM_InitBusDevice(const SPIM_BusDevice_t* BusDevice)
+	{
+		GPIO_Set(BusDevice->Port, BusDevice->Pin);
+		GPIO_SetDirection(BusDevice->Port, BusDevice->Pin, GPIO_DIRECTION_OUT);
+	}
+
+	SPI_Status_t SPIM_Enqueue(SPI_t* Device, SPIM_Transaction_t* Transaction)
+	{
+		uint8_t ID = 0x00;
+
+		if(Device == &SPID)
+		{
+			ID = SPID_ID;
+		}
+
+		#if(defined SPIE)
+			else if(Device == &SPIE)
+			{
+				ID = SPIE_ID;
+			}
+		#endif
+
+		#if(defined SPIF)
+			else if(Device == &SPIF)
+			{
+				ID = SPIF_ID;
+			}
+		#endif
+
+		if((Transaction->Length == 0x00) || (Transaction->BusDevice == NULL))
+		{
+			return SPI_MESSAGE_ERROR;
+		}
+
+		Transaction->Next = NULL;
+		Transaction->Status = SPI_MESSAGE_PENDING;
+
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			if(_SPIM_Queue[ID].Active == NULL)
+			{
+				_SPIM_Queue[ID].Device = Device;
+				_SPIM_Queue[ID].Active = Transaction;
+				_SPIM_Queue[ID].Last = Transaction;
+
+				_SPIM_QueueStart(ID);
+			}
+			else
+			{
+				_SPIM_Queue[ID].Last->Next = Transaction;
+				_SPIM_Queue[ID].Last = Transaction;
+			}
+		}
+
+		return SPI_MESSAGE_PENDING;
+	}
+
+	bool SPIM_QueueIsIdle(const SPI_t* Device)
+	{
+		uint8_t ID = 0x00;
+
+		if(Device == &SPID)
+		{
+			ID = SPID_ID;
+		}
+
+		#if(defined SPIE)
+			else if(Device == &SPIE)
+			{
+				ID = SPIE_ID;
+			}
+		#endif
+
+		#if(defined SPIF)
+			else if(Device == &SPIF)
+			{
+				ID = SPIF_ID;
+			}
+		#endif
+
+		return (_SPIM_Queue[ID].Active == NULL);
+	}
+#endif
+
 /*
     Interrupt vectors
 */
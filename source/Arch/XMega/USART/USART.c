@@ -31,6 +31,9 @@
  *  @author Daniel Kampert
  */
 
+#include <string.h>
+#include <stdarg.h>
+
 #include "Arch/XMega/USART/USART.h"
 #include "Arch/XMega/PowerManagement/PowerManagement.h"
 
@@ -42,6 +45,20 @@ static RingBuffer_t _USART_TxRingBuffer[USART_DEVICES][USART_CHANNEL];
  */
 static uint8_t _TxData[USART_DEVICES][USART_CHANNEL][USART_BUFFER_SIZE];
 
+#if(defined USART_USE_RX_BUFFER)
+	#if((USART_RX_BUFFER_SIZE > 128) || (USART_RX_BUFFER_SIZE & (USART_RX_BUFFER_SIZE - 1)))
+		#error "USART_RX_BUFFER_SIZE has to be a power of two and not larger than 128!"
+	#endif
+
+	/** @brief Rx ring buffer for each USART interface.
+	 */
+	static SPSCRingBuffer_t _USART_RxRingBuffer[USART_DEVICES][USART_CHANNEL];
+
+	/** @brief Data buffer for Rx ring buffer.
+	 */
+	static uint8_t _RxData[USART_DEVICES][USART_CHANNEL][USART_RX_BUFFER_SIZE];
+#endif
+
 #ifndef DOXYGEN
 	/*
 		Object declaration
@@ -57,6 +74,374 @@ static uint8_t _TxData[USART_DEVICES][USART_CHANNEL][USART_BUFFER_SIZE];
 	} _USART_Callbacks[USART_DEVICES][USART_CHANNEL];
 #endif
 
+/** @brief			Get the message object of a USART interface.
+ *  @param Device	Pointer to USART object
+ *  @return			Pointer to message object
+ */
+static USART_Message_t* USART_GetMessage(const USART_t* Device)
+{
+	uint8_t ID = 0x00;
+	uint8_t Channel = 0x00;
+
+	if(Device == &USARTD0)
+	{
+		ID = USARTD_ID;
+	}
+	else if(Device == &USARTE0)
+	{
+		ID = USARTE_ID;
+	}
+
+	#if(defined USARTC1)
+		else if(Device == &USARTC1)
+		{
+			ID = USARTC_ID;
+			Channel = 0x01;
+		}
+	#endif
+
+	#if(defined USARTD1)
+		else if(Device == &USARTD1)
+		{
+			ID = USARTD_ID;
+			Channel = 0x01;
+		}
+	#endif
+
+	#if(defined USARTF0)
+		else if(Device == &USARTF0)
+		{
+			ID = USARTF_ID;
+		}
+	#endif
+
+	return &_USART_Messages[ID][Channel];
+}
+
+#if(defined USART_PRINTF_DIVIDE_FREE)
+	/** @brief Powers of ten for the divide-free decimal conversion.
+	 */
+	static const uint32_t _USART_Decimals[] PROGMEM = {1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL, 1UL};
+#endif
+
+/** @brief			Save a single character in the transmit ring buffer of a USART interface.
+					NOTE: The function waits for free space when the ring buffer is full.
+ *  @param Message	Pointer to message object
+ *  @param Data		Data byte
+ */
+static void USART_PutTx(USART_Message_t* Message, const char Data)
+{
+	bool Saved = false;
+
+	// Interrupt support is disabled
+	if(Message->Ptr_TxRingBuffer == NULL)
+	{
+		USART_SendChar(Message->Device, Data);
+
+		return;
+	}
+
+	while(!Saved)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			if(!RingBuffer_IsFull(Message->Ptr_TxRingBuffer))
+			{
+				RingBuffer_Save(Message->Ptr_TxRingBuffer, Data);
+				Saved = true;
+			}
+		}
+
+		if(!Saved)
+		{
+			// Start the transmission to free the buffer
+			USART_Flush(Message->Device);
+		}
+	}
+}
+
+/** @brief			Convert a number into a string.
+ *  @param Number	Number
+ *  @param Base		Base of the number (2, 10 or 16)
+ *  @param Upper	Set to #true to use upper case letters for hex numbers
+ *  @param Buffer	Pointer to string buffer. Has to be 32 bytes long.
+ *  @return			Number of digits
+ */
+static uint8_t USART_ConvertNumber(uint32_t Number, const uint8_t Base, const bool Upper, char* Buffer)
+{
+	uint8_t Digits = 0x00;
+
+	if(Base == 10)
+	{
+		#if(defined USART_PRINTF_DIVIDE_FREE)
+			// Get each digit by subtracting the powers of ten
+			for(uint8_t i = 0x00; i < (sizeof(_USART_Decimals) / sizeof(_USART_Decimals[0])); i++)
+			{
+				uint32_t Decimal = pgm_read_dword(&_USART_Decimals[i]);
+				char Digit = '0';
+
+				while(Number >= Decimal)
+				{
+					Number -= Decimal;
+					Digit++;
+				}
+
+				if((Digit != '0') || (Digits > 0x00) || (Decimal == 0x01))
+				{
+					Buffer[Digits++] = Digit;
+				}
+			}
+
+			return Digits;
+		#else
+			do
+			{
+				Buffer[Digits++] = '0' + (Number % 10);
+				Number /= 10;
+			} while(Number);
+		#endif
+	}
+	else
+	{
+		// Binary and hexadecimal numbers only need shifts
+		uint8_t Shift = (Base == 16) ? 0x04 : 0x01;
+		uint8_t Mask = Base - 0x01;
+
+		do
+		{
+			char Digit = Representation[Number & Mask];
+
+			if(!Upper && (Digit > '9'))
+			{
+				Digit += 'a' - 'A';
+			}
+
+			Buffer[Digits++] = Digit;
+			Number >>= Shift;
+		} while(Number);
+	}
+
+	// Reverse the digits
+	for(uint8_t i = 0x00; i < (Digits >> 0x01); i++)
+	{
+		char Temp = Buffer[i];
+		Buffer[i] = Buffer[Digits - i - 0x01];
+		Buffer[Digits - i - 0x01] = Temp;
+	}
+
+	return Digits;
+}
+
+/** @brief				Format a string and write it into the transmit ring buffer of a USART interface.
+ *  @param Device		Pointer to USART object
+ *  @param Format		Pointer to format string
+ *  @param FromFlash	Set to #true if the format string is stored in the flash
+ *  @param Arguments	Argument list
+ */
+static void USART_Format(USART_t* Device, const char* Format, const bool FromFlash, va_list Arguments)
+{
+	char Buffer[33];
+	USART_Message_t* Message = USART_GetMessage(Device);
+
+	// The message object is only initialized with the interrupt support
+	Message->Device = Device;
+
+	while(1)
+	{
+		char Char = FromFlash ? pgm_read_byte(Format++) : *Format++;
+
+		if(Char == '\0')
+		{
+			break;
+		}
+		else if(Char != '%')
+		{
+			USART_PutTx(Message, Char);
+			continue;
+		}
+
+		bool LeftAlign = false;
+		bool ZeroPad = false;
+		bool Long = false;
+		uint8_t Width = 0x00;
+		uint8_t Decimals = 0x00;
+
+		Char = FromFlash ? pgm_read_byte(Format++) : *Format++;
+
+		// Flags
+		while((Char == '-') || (Char == '0'))
+		{
+			if(Char == '-')
+			{
+				LeftAlign = true;
+			}
+			else
+			{
+				ZeroPad = true;
+			}
+
+			Char = FromFlash ? pgm_read_byte(Format++) : *Format++;
+		}
+
+		// Field width
+		while((Char >= '0') && (Char <= '9'))
+		{
+			Width = (Width * 10) + (Char - '0');
+			Char = FromFlash ? pgm_read_byte(Format++) : *Format++;
+		}
+
+		// Decimal places for fixed-point numbers
+		if(Char == '.')
+		{
+			Char = FromFlash ? pgm_read_byte(Format++) : *Format++;
+
+			while((Char >= '0') && (Char <= '9'))
+			{
+				Decimals = (Decimals * 10) + (Char - '0');
+				Char = FromFlash ? pgm_read_byte(Format++) : *Format++;
+			}
+		}
+
+		if(Char == 'l')
+		{
+			Long = true;
+			Char = FromFlash ? pgm_read_byte(Format++) : *Format++;
+		}
+
+		char* String = Buffer;
+		uint16_t Length = 0x00;
+		bool StringFromFlash = false;
+		char Sign = 0x00;
+
+		switch(Char)
+		{
+			case 'd':
+			case 'i':
+			{
+				int32_t Value = Long ? va_arg(Arguments, int32_t) : va_arg(Arguments, int);
+				uint32_t Magnitude = Value;
+
+				if(Value < 0x00)
+				{
+					Sign = '-';
+					Magnitude = 0x00 - Magnitude;
+				}
+
+				Length = USART_ConvertNumber(Magnitude, 10, false, Buffer);
+
+				break;
+			}
+			case 'u':
+			case 'x':
+			case 'X':
+			case 'b':
+			{
+				uint32_t Value = Long ? va_arg(Arguments, uint32_t) : va_arg(Arguments, unsigned int);
+				uint8_t Base = (Char == 'u') ? 10 : ((Char == 'b') ? 2 : 16);
+
+				Length = USART_ConvertNumber(Value, Base, (Char == 'X'), Buffer);
+
+				break;
+			}
+			case 'c':
+			{
+				Buffer[0] = (char)va_arg(Arguments, int);
+				Length = 0x01;
+
+				break;
+			}
+			case 's':
+			case 'S':
+			{
+				String = va_arg(Arguments, char*);
+				StringFromFlash = (Char == 'S');
+				Length = StringFromFlash ? strlen_P(String) : strlen(String);
+
+				break;
+			}
+			case '\0':
+			{
+				// Step back to the terminator so that the main loop ends and the buffer is flushed
+				Format--;
+
+				continue;
+			}
+			default:
+			{
+				USART_PutTx(Message, Char);
+
+				continue;
+			}
+		}
+
+		// Fixed-point numbers need at least one digit before the decimal point
+		uint8_t Zeros = 0x00;
+		if((Decimals > 0x00) && ((Char == 'd') || (Char == 'i') || (Char == 'u')))
+		{
+			if(Length <= Decimals)
+			{
+				Zeros = Decimals + 0x01 - Length;
+			}
+		}
+		else
+		{
+			Decimals = 0x00;
+		}
+
+		uint16_t Total = Length + Zeros + (Sign ? 0x01 : 0x00) + (Decimals ? 0x01 : 0x00);
+		uint16_t Padding = (Width > Total) ? (Width - Total) : 0x00;
+
+		if(!LeftAlign && !ZeroPad)
+		{
+			for(; Padding; Padding--)
+			{
+				USART_PutTx(Message, ' ');
+			}
+		}
+
+		if(Sign)
+		{
+			USART_PutTx(Message, Sign);
+		}
+
+		if(!LeftAlign)
+		{
+			for(; Padding; Padding--)
+			{
+				USART_PutTx(Message, '0');
+			}
+		}
+
+		// Leading zeros of fixed-point numbers are counted as part of the digits
+		for(uint16_t i = 0x00; i < (Zeros + Length); i++)
+		{
+			if(Decimals && (i == (Zeros + Length - Decimals)))
+			{
+				USART_PutTx(Message, '.');
+			}
+
+			if(i < Zeros)
+			{
+				USART_PutTx(Message, '0');
+			}
+			else
+			{
+				USART_PutTx(Message, StringFromFlash ? pgm_read_byte(&String[i - Zeros]) : String[i - Zeros]);
+			}
+		}
+
+		for(; Padding; Padding--)
+		{
+			USART_PutTx(Message, ' ');
+		}
+	}
+
+	if(Message->Ptr_TxRingBuffer != NULL)
+	{
+		USART_Flush(Device);
+	}
+}
+
 void USART_InstallCallback(const USART_InterruptConfig_t* Config)
 {
 	uint8_t Device = 0x00;
@@ -336,6 +721,15 @@ void USART_EnableInterruptSupport(USART_t* Device, const Interrupt_Level_t Level
 	
 	_USART_Messages[ID][Channel].Device = Device;
 	_USART_Messages[ID][Channel].Ptr_TxRingBuffer = &_USART_TxRingBuffer[ID][Channel];
+
+	#if(defined USART_USE_RX_BUFFER)
+		SPSCRingBuffer_Init(&_USART_RxRingBuffer[ID][Channel], _RxData[ID][Channel], USART_RX_BUFFER_SIZE);
+		_USART_Messages[ID][Channel].Ptr_RxRingBuffer = &_USART_RxRingBuffer[ID][Channel];
+		_USART_Messages[ID][Channel].FramesReceived = 0x00;
+		_USART_Messages[ID][Channel].FramesRead = 0x00;
+		_USART_Messages[ID][Channel].FramesTruncated = 0x00;
+		_USART_Messages[ID][Channel].Discard = false;
+	#endif
 	
 	Device->CTRLA = (Device->CTRLA & (~(0x03 << 0x04))) | (Level << 0x04);
 }
@@ -358,8 +752,8 @@ void USART_WriteDecimal(USART_t* Device, const uint32_t Number, const uint8_t Ba
 	char* pBuffer;
 	uint32_t Number_Temp = Number;
 
-	// Reserve a transmit buffer. Size depends on the type of 'Number' + array end
-	char Buffer[sizeof(Number) + 2] = {0x00};
+	// Reserve a transmit buffer. Size depends on the type of 'Number' (one digit per bit for binary output) + array end
+	char Buffer[(sizeof(Number) << 0x03) + 2] = {0x00};
 
 	// Set the end of a char array
 	Buffer[sizeof(Buffer) - 1] = '\0';
@@ -451,6 +845,24 @@ void USART_Print(USART_t* Device, const char* Data)
 	USART_Flush(Device);
 }
 
+void USART_Printf(USART_t* Device, const char* Format, ...)
+{
+	va_list Arguments;
+
+	va_start(Arguments, Format);
+	USART_Format(Device, Format, false, Arguments);
+	va_end(Arguments);
+}
+
+void USART_Printf_P(USART_t* Device, const char* Format, ...)
+{
+	va_list Arguments;
+
+	va_start(Arguments, Format);
+	USART_Format(Device, Format, true, Arguments);
+	va_end(Arguments);
+}
+
 void USART_Flush(USART_t* Device)
 {
 	Device->CTRLA |= 0x03;
@@ -511,6 +923,188 @@ void USART_SwitchEcho(USART_t* Device, const bool Enable)
 	}
 }
 
+#if(defined USART_USE_RX_BUFFER)
+	uint16_t USART_Available(USART_t* Device)
+	{
+		USART_Message_t* Message = USART_GetMessage(Device);
+
+		// The receive buffer is initialized with the interrupt support
+		if(Message->Ptr_RxRingBuffer == NULL)
+		{
+			return 0x00;
+		}
+
+		return SPSCRingBuffer_GetBytes(Message->Ptr_RxRingBuffer);
+	}
+
+	uint16_t USART_Read(USART_t* Device, uint8_t* Data, const uint16_t Length)
+	{
+		USART_Message_t* Message = USART_GetMessage(Device);
+
+		if(Message->Ptr_RxRingBuffer == NULL)
+		{
+			return 0x00;
+		}
+
+		return SPSCRingBuffer_Read(Message->Ptr_RxRingBuffer, Data, Length);
+	}
+
+	uint16_t USART_Peek(USART_t* Device, const uint8_t** Data)
+	{
+		uint8_t* Span;
+		USART_Message_t* Message = USART_GetMessage(Device);
+
+		if(Message->Ptr_RxRingBuffer == NULL)
+		{
+			*Data = NULL;
+
+			return 0x00;
+		}
+
+		uint16_t Length = SPSCRingBuffer_GetReadSpan(Message->Ptr_RxRingBuffer, &Span);
+
+		*Data = Span;
+
+		return Length;
+	}
+
+	void USART_Skip(USART_t* Device, const uint16_t Length)
+	{
+		USART_Message_t* Message = USART_GetMessage(Device);
+
+		if(Message->Ptr_RxRingBuffer == NULL)
+		{
+			return;
+		}
+
+		uint16_t Bytes = SPSCRingBuffer_GetBytes(Message->Ptr_RxRingBuffer);
+
+		if(Length < Bytes)
+		{
+			Bytes = Length;
+		}
+
+		SPSCRingBuffer_CommitRead(Message->Ptr_RxRingBuffer, Bytes);
+	}
+
+	void USART_SetFraming(USART_t* Device, const USART_Framing_t Framing)
+	{
+		USART_Message_t* Message = USART_GetMessage(Device);
+
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			Message->Framing = Framing;
+			Message->FramesRead = Message->FramesReceived;
+			Message->Discard = false;
+		}
+	}
+
+	uint8_t USART_GetTruncatedFrames(USART_t* Device)
+	{
+		return USART_GetMessage(Device)->FramesTruncated;
+	}
+
+	bool USART_ReadFrame(USART_t* Device, uint8_t* Data, uint16_t* Length)
+	{
+		uint16_t Bytes = 0x00;
+		bool Escape = false;
+		uint8_t Remaining = 0x00;
+		uint8_t Code = 0x00;
+		USART_Message_t* Message = USART_GetMessage(Device);
+
+		if(Message->FramesRead == Message->FramesReceived)
+		{
+			return false;
+		}
+
+		Message->FramesRead++;
+
+		while(1)
+		{
+			uint8_t Byte;
+
+			SPSCRingBuffer_Load(Message->Ptr_RxRingBuffer, &Byte);
+
+			if(Message->Framing == USART_FRAMING_LINE)
+			{
+				if(Byte == LF)
+				{
+					break;
+				}
+				else if(Byte == CR)
+				{
+					continue;
+				}
+			}
+			else if(Message->Framing == USART_FRAMING_SLIP)
+			{
+				if(Byte == USART_SLIP_END)
+				{
+					break;
+				}
+				else if(Byte == USART_SLIP_ESC)
+				{
+					Escape = true;
+					continue;
+				}
+				else if(Escape)
+				{
+					Escape = false;
+
+					if(Byte == USART_SLIP_ESC_END)
+					{
+						Byte = USART_SLIP_END;
+					}
+					else if(Byte == USART_SLIP_ESC_ESC)
+					{
+						Byte = USART_SLIP_ESC;
+					}
+				}
+			}
+			else if(Message->Framing == USART_FRAMING_COBS)
+			{
+				if(Byte == 0x00)
+				{
+					break;
+				}
+				else if(Remaining == 0x00)
+				{
+					// Each code byte except the first one and 0xFF replaces a zero
+					uint8_t Last = Code;
+
+					Code = Byte;
+					Remaining = Code - 0x01;
+
+					if((Last == 0x00) || (Last == 0xFF))
+					{
+						continue;
+					}
+
+					Byte = 0x00;
+				}
+				else
+				{
+					Remaining--;
+				}
+			}
+
+			if(Bytes < *Length)
+			{
+				Data[Bytes] = Byte;
+			}
+
+			Bytes++;
+		}
+
+		if(Bytes < *Length)
+		{
+			*Length = Bytes;
+		}
+
+		return true;
+	}
+#endif
+
 void USART_SetBaudrate(USART_t* Device, const uint32_t Baudrate, const uint32_t Clock, const int8_t BSCALE, const bool DoubleSpeed)
 {
 	float BSEL_Temp = 0x00;
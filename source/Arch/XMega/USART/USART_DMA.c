@@ -0,0 +1,350 @@
+/*
+ * USART_DMA.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: DMA driver for Atmel AVR8 XMega USART module.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Arch/XMega/USART/USART_DMA.c
+ *  @brief DMA driver for Atmel AVR8 XMega USART module.
+ *
+ *  This file contains the implementation of the DMA transmission and reception for the Atmel AVR8 XMega USART driver.
+ *  The transmission is triggered by the data register empty flag of the USART. The reception uses a DMA channel in
+ *  repeat mode, which writes into a circular buffer. Each edge on the Rx pin restarts a timer over the event system,
+ *  so the timer overflows only when the receive line is idle.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <string.h>
+
+#include "Arch/XMega/USART/USART.h"
+
+#if(defined USART_USE_DMA)
+
+#if(!defined USART_DMA_TX_CHANNEL)
+	#error "No DMA channel for the USART transmission defined!"
+#endif
+
+#if(!defined USART_DMA_RX_CHANNEL)
+	#error "No DMA channel for the USART reception defined!"
+#endif
+
+#if(!defined USART_DMA_INT_LEVEL)
+	#define USART_DMA_INT_LEVEL								INT_LVL_LO
+#endif
+
+#if(!defined USART_DMA_RX_BUFFER_SIZE)
+	#define USART_DMA_RX_BUFFER_SIZE						USART_BUFFER_SIZE
+#endif
+
+static volatile bool _USART_DMABusy;
+static USART_Callback_t _USART_DMATxCallback;
+
+static USART_DMA_RxCallback_t _USART_DMARxCallback;
+static TC0_t* _USART_DMARxTimer;
+static uint16_t _USART_DMARxTail;
+static uint16_t _USART_DMARxReported;
+static uint8_t _USART_DMARxBuffer[USART_DMA_RX_BUFFER_SIZE];
+
+/** @brief			Get the DMA trigger source for the receive complete flag of a USART.
+					NOTE: The trigger for the data register empty flag is the next trigger source.
+ *  @param Device	Pointer to USART object
+ *  @return			DMA trigger source
+ */
+static DMA_TriggerSource_t USART_DMA_GetTrigger(const USART_t* Device)
+{
+	if(Device == &USARTD0)
+	{
+		return DMA_TRIGGER_USARTD0_RXC;
+	}
+	else if(Device == &USARTE0)
+	{
+		return DMA_TRIGGER_USARTE0_RXC;
+	}
+
+	#if(defined USARTC1)
+		else if(Device == &USARTC1)
+		{
+			return DMA_TRIGGER_USARTC1_RXC;
+		}
+	#endif
+
+	#if(defined USARTD1)
+		else if(Device == &USARTD1)
+		{
+			return DMA_TRIGGER_USARTD1_RXC;
+		}
+	#endif
+
+	#if(defined USARTF0)
+		else if(Device == &USARTF0)
+		{
+			return DMA_TRIGGER_USARTF0_RXC;
+		}
+	#endif
+
+	return DMA_TRIGGER_USARTC0_RXC;
+}
+
+/** @brief		Get the current write position of the receive DMA channel.
+ *  @return		Write position in the receive buffer
+ */
+static uint16_t USART_DMA_GetHead(void)
+{
+	uint16_t Remaining;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		Remaining = USART_DMA_RX_CHANNEL.TRFCNT;
+	}
+
+	if((Remaining == 0x00) || (Remaining > USART_DMA_RX_BUFFER_SIZE))
+	{
+		return 0x00;
+	}
+
+	return USART_DMA_RX_BUFFER_SIZE - Remaining;
+}
+
+/** @brief			DMA transaction complete callback for the transmission.
+ *  @param Channel	DMA channel
+ */
+static void USART_DMA_TxCallback(const uint8_t Channel)
+{
+	_USART_DMABusy = false;
+
+	if(_USART_DMATxCallback != NULL)
+	{
+		_USART_DMATxCallback();
+	}
+}
+
+/** @brief	Idle timer overflow callback.
+ */
+static void USART_DMA_IdleCallback(void)
+{
+	uint16_t Head = USART_DMA_GetHead();
+
+	// Only report new data once per idle phase
+	if(Head != _USART_DMARxReported)
+	{
+		uint16_t Bytes = (Head - _USART_DMARxReported + USART_DMA_RX_BUFFER_SIZE) % USART_DMA_RX_BUFFER_SIZE;
+
+		_USART_DMARxReported = Head;
+
+		if(_USART_DMARxCallback != NULL)
+		{
+			_USART_DMARxCallback(Bytes);
+		}
+	}
+}
+
+bool USART_DMA_Write(USART_t* Device, const uint8_t* Data, const uint16_t Length, USART_Callback_t Callback)
+{
+	// The data register empty interrupt is enabled until the transmit ring buffer is empty
+	if(_USART_DMABusy || (Device->CTRLA & 0x03))
+	{
+		return false;
+	}
+
+	if(Length == 0x00)
+	{
+		return true;
+	}
+
+	DMA_TransferConfig_t Config = {
+		.Channel = &USART_DMA_TX_CHANNEL,
+		.EnableSingleShot = true,
+		.EnableRepeatMode = false,
+		.BurstLength = DMA_BURSTLENGTH_1,
+		.SrcReload = DMA_ADDRESS_RELOAD_NONE,
+		.DstReload = DMA_ADDRESS_RELOAD_NONE,
+		.SrcAddrMode = DMA_ADDRESS_MODE_INC,
+		.DstAddrMode = DMA_ADDRESS_MODE_FIXED,
+		.TriggerSource = USART_DMA_GetTrigger(Device) + 0x01,
+		.TransferCount = Length,
+		.RepeatCount = 0x00,
+		.SrcAddress = (uintptr_t)Data,
+		.DstAddress = (uintptr_t)&Device->DATA,
+	};
+
+	DMA_InterruptConfig_t DMAInterrupt = {
+		.Channel = &USART_DMA_TX_CHANNEL,
+		.Source = DMA_TRANSACTION_INTERRUPT,
+		.InterruptLevel = USART_DMA_INT_LEVEL,
+		.Callback = USART_DMA_TxCallback,
+	};
+
+	_USART_DMATxCallback = Callback;
+	_USART_DMABusy = true;
+
+	DMA_Channel_Config(&Config);
+	DMA_Channel_InstallCallback(&DMAInterrupt);
+
+	// The empty data register triggers the first transfer
+	DMA_Channel_Enable(&USART_DMA_TX_CHANNEL);
+
+	return true;
+}
+
+bool USART_DMA_Print(USART_t* Device, const char* Data)
+{
+	return USART_DMA_Write(Device, (const uint8_t*)Data, strlen(Data), NULL);
+}
+
+bool USART_DMA_IsBusy(void)
+{
+	return _USART_DMABusy;
+}
+
+void USART_DMA_StartReceive(USART_DMA_RxConfig_t* Config)
+{
+	PORT_t* Port = &PORTC;
+	uint8_t Pin = USART_RX0_PIN;
+
+	if(Config->Device == &USARTD0)
+	{
+		Port = &PORTD;
+	}
+	else if(Config->Device == &USARTE0)
+	{
+		Port = &PORTE;
+	}
+
+	#if(defined USARTC1)
+		else if(Config->Device == &USARTC1)
+		{
+			Pin = USART_RX1_PIN;
+		}
+	#endif
+
+	#if(defined USARTD1)
+		else if(Config->Device == &USARTD1)
+		{
+			Port = &PORTD;
+			Pin = USART_RX1_PIN;
+		}
+	#endif
+
+	#if(defined USARTF0)
+		else if(Config->Device == &USARTF0)
+		{
+			Port = &PORTF;
+		}
+	#endif
+
+	DMA_TransferConfig_t DMAConfig = {
+		.Channel = &USART_DMA_RX_CHANNEL,
+		.EnableSingleShot = true,
+		.EnableRepeatMode = true,
+		.BurstLength = DMA_BURSTLENGTH_1,
+		.SrcReload = DMA_ADDRESS_RELOAD_NONE,
+		.DstReload = DMA_ADDRESS_RELOAD_BLOCK,
+		.SrcAddrMode = DMA_ADDRESS_MODE_FIXED,
+		.DstAddrMode = DMA_ADDRESS_MODE_INC,
+		.TriggerSource = USART_DMA_GetTrigger(Config->Device),
+		.TransferCount = USART_DMA_RX_BUFFER_SIZE,
+		.RepeatCount = 0x00,
+		.SrcAddress = (uintptr_t)&Config->Device->DATA,
+		.DstAddress = (uintptr_t)_USART_DMARxBuffer,
+	};
+
+	Timer0_InterruptConfig_t TimerInterrupt = {
+		.Device = Config->Timer,
+		.Source = TIMER_OVERFLOW_INTERRUPT,
+		.InterruptLevel = USART_DMA_INT_LEVEL,
+		.Callback = USART_DMA_IdleCallback,
+	};
+
+	Timer0_Config_t TimerConfig = {
+		.Device = Config->Timer,
+		.Prescaler = Config->Prescaler,
+		.Period = Config->IdleTime,
+	};
+
+	_USART_DMARxCallback = Config->Callback;
+	_USART_DMARxTimer = Config->Timer;
+	_USART_DMARxTail = 0x00;
+	_USART_DMARxReported = 0x00;
+
+	// The receive complete interrupt would compete with the DMA
+	Config->Device->CTRLA &= ~(0x03 << 0x04);
+
+	// A repeat count of zero repeats the block transfer forever
+	DMA_Channel_Config(&DMAConfig);
+	DMA_Channel_Enable(&USART_DMA_RX_CHANNEL);
+
+	// Restart the idle timer with each edge on the receive line
+	GPIO_SetInputSense(Port, Pin, GPIO_SENSE_BOTH);
+	Event_SetPinSource(Config->EventChannel, Port, Pin);
+
+	Timer0_Init(&TimerConfig);
+	Timer0_SetEventChannel(Config->Timer, Config->EventChannel);
+	Timer0_SetCaptureMode(Config->Timer, TIMER_EVENT_RESTART);
+	Timer0_InstallCallback(&TimerInterrupt);
+}
+
+void USART_DMA_StopReceive(void)
+{
+	DMA_Channel_Disable(&USART_DMA_RX_CHANNEL);
+
+	if(_USART_DMARxTimer != NULL)
+	{
+		Timer0_RemoveCallback(_USART_DMARxTimer, TIMER_OVERFLOW_INTERRUPT);
+		Timer0_ChangeInterruptLevel(_USART_DMARxTimer, TIMER_OVERFLOW_INTERRUPT, INT_LVL_OFF);
+		_USART_DMARxTimer = NULL;
+	}
+}
+
+uint16_t USART_DMA_Available(void)
+{
+	return (USART_DMA_GetHead() - _USART_DMARxTail + USART_DMA_RX_BUFFER_SIZE) % USART_DMA_RX_BUFFER_SIZE;
+}
+
+uint16_t USART_DMA_Read(uint8_t* Data, const uint16_t Length)
+{
+	uint16_t Head = USART_DMA_GetHead();
+	uint16_t Bytes = 0x00;
+
+	while((Bytes < Length) && (_USART_DMARxTail != Head))
+	{
+		// Copy the data up to the write position or up to the end of the buffer
+		uint16_t Block = ((Head > _USART_DMARxTail) ? Head : USART_DMA_RX_BUFFER_SIZE) - _USART_DMARxTail;
+
+		if(Block > (Length - Bytes))
+		{
+			Block = Length - Bytes;
+		}
+
+		memcpy(&Data[Bytes], &_USART_DMARxBuffer[_USART_DMARxTail], Block);
+
+		Bytes += Block;
+		_USART_DMARxTail += Block;
+		if(_USART_DMARxTail == USART_DMA_RX_BUFFER_SIZE)
+		{
+			_USART_DMARxTail = 0x00;
+		}
+	}
+
+	return Bytes;
+}
+
+#endif
\ No newline at end of file
@@ -90,11 +90,6 @@ static void _USART_InterruptHandler(const uint8_t Device, const uint8_t Channel,
 	{
 		if(Callback == USART_DRE_INTERRUPT)
 		{
-			if (_USART_Callbacks[Device][Channel].EmptyCallback)
-			{
-				_USART_Callbacks[Device][Channel].EmptyCallback();
-			}
-
 			if(!(RingBuffer_IsEmpty(_USART_Messages[Device][Channel].Ptr_TxRingBuffer)))
 			{
 				_USART_Messages[Device][Channel].Device->DATA = RingBuffer_Load(_USART_Messages[Device][Channel].Ptr_TxRingBuffer);
@@ -102,6 +97,12 @@ static void _USART_InterruptHandler(const uint8_t Device, const uint8_t Channel,
 			else
 			{
 				_USART_Messages[Device][Channel].Device->CTRLA &= ~0x03;
+
+				// Only signal the application once when the transmit buffer is empty
+				if (_USART_Callbacks[Device][Channel].EmptyCallback)
+				{
+					_USART_Callbacks[Device][Channel].EmptyCallback();
+				}
 			}
 		}
 		else if(Callback == USART_TXC_INTERRUPT)
@@ -113,16 +114,71 @@ static void _USART_InterruptHandler(const uint8_t Device, const uint8_t Channel,
 		}
 		else if(Callback == USART_RXC_INTERRUPT)
 		{		
-			// Echo message when enabled
-			if(_USART_Echo[Device][Channel] == true)
-			{
-				_USART_Messages[Device][Channel].Device->DATA = _USART_Messages[Device][Channel].Device->DATA;
-			}
+			#if(defined USART_USE_RX_BUFFER)
+				USART_Message_t* Message = &_USART_Messages[Device][Channel];
+				uint8_t Data = Message->Device->DATA;
+				bool Notify = (Message->Framing == USART_FRAMING_NONE);
 
-			if (_USART_Callbacks[Device][Channel].RxCallback)
-			{
-				_USART_Callbacks[Device][Channel].RxCallback();
-			}
+				// Echo message when enabled
+				if(_USART_Echo[Device][Channel] == true)
+				{
+					Message->Device->DATA = Data;
+				}
+
+				// The receive buffer is initialized with the interrupt support
+				if(Message->Ptr_RxRingBuffer != NULL)
+				{
+					bool Delimiter = ((Message->Framing == USART_FRAMING_LINE) && (Data == LF)) ||
+									 ((Message->Framing == USART_FRAMING_SLIP) && (Data == USART_SLIP_END)) ||
+									 ((Message->Framing == USART_FRAMING_COBS) && (Data == 0x00));
+					uint8_t Reserved = ((Message->Framing != USART_FRAMING_NONE) && !Delimiter) ? 0x01 : 0x00;
+
+					// Discard the rest of a frame with lost bytes until the next delimiter. One byte is kept free for
+					// the delimiter, so the frame is always completed and can be removed with #USART_ReadFrame.
+					if((Message->Discard && !Delimiter) || (SPSCRingBuffer_GetFree(Message->Ptr_RxRingBuffer) <= Reserved))
+					{
+						if(!Message->Discard && _USART_Callbacks[Device][Channel].BufferOverflow)
+						{
+							_USART_Callbacks[Device][Channel].BufferOverflow();
+						}
+
+						Message->Discard = (Message->Framing != USART_FRAMING_NONE);
+
+						return;
+					}
+
+					SPSCRingBuffer_Save(Message->Ptr_RxRingBuffer, Data);
+
+					// Only signal the application when a frame is complete
+					if(Delimiter)
+					{
+						if(Message->Discard)
+						{
+							Message->FramesTruncated++;
+							Message->Discard = false;
+						}
+
+						Message->FramesReceived++;
+						Notify = true;
+					}
+				}
+
+				if(Notify && _USART_Callbacks[Device][Channel].RxCallback)
+				{
+					_USART_Callbacks[Device][Channel].RxCallback();
+				}
+			#else
+				// Echo message when enabled
+				if(_USART_Echo[Device][Channel] == true)
+				{
+					_USART_Messages[Device][Channel].Device->DATA = _USART_Messages[Device][Channel].Device->DATA;
+				}
+
+				if (_USART_Callbacks[Device][Channel].RxCallback)
+				{
+					_USART_Callbacks[Device][Channel].RxCallback();
+				}
+			#endif
 		}
 	}
 }
@@ -28,7 +28,7 @@
  *  @author Daniel Kampert
  */
 
-#include "Common/common.h"
+#include "Common/Common.h"
 
  /** 
   * USB logo
@@ -36,6 +36,9 @@
 #define NVM_CMD_LOAD_FLASH_BUFFER_gc			0x23
 #define NVM_CMD_ERASE_FLASH_BUFFER_gc			0x26
 #define NVM_CMD_ERASE_WRITE_FLASH_PAGE_gc		0x2F
+#define NVM_CMD_FLASH_RANGE_CRC_gc				0x3A
+#define CRC_RESET_RESET1_gc						0x80
+#define CRC_SOURCE_FLASH_gc						0x01
 #define CCP_SPM_gc								0x9D
 #define CCP_IOREG_gc							0xD8
 
@@ -177,6 +180,34 @@ NVM_LoadFlashBuffer:
 
 	ret
 
+;--
+;	Input:
+;		-
+;
+;	Return:
+;		-
+;--
+.section .text
+.global NVM_ClearFlashBuffer
+NVM_ClearFlashBuffer:
+	call	NVM_WaitBusy
+
+	; Load NVM command
+	ldi		r26, NVM_CMD_ERASE_FLASH_BUFFER_gc
+	sts		NVM_CMD, r26
+
+	; Execute the NVM command
+	ldi		r18, CCP_IOREG_gc
+	ldi		r19, NVM_CMDEX_bm
+	sts		CCP, r18
+	sts		NVM_CTRLA, r19
+	call	NVM_WaitBusy
+
+	; Clear the NVM command
+	sts		NVM_CMD, r1
+
+	ret
+
 ;--
 ;	Input:
 ;		r25:r24				Page address
@@ -209,4 +240,101 @@ NVM_FlushFlash:
 	; Restore RAMPZ
 	out		RAMPZ, r18
 
+	ret
+
+;--
+;	Start the page write without waiting for the NVM controller.
+;
+;	Input:
+;		r25:r24				Page address
+;
+;	Return:
+;		-
+;--
+.section .text
+.global NVM_StartFlushFlash
+NVM_StartFlushFlash:
+	; Save RAMPZ
+	in		r18, RAMPZ
+
+	; Save the page address
+	mov		r19, r25
+	mov		ZH, r24
+
+	; Perform the address calculation
+	lsl		ZH
+	rol		r19
+
+	; Save the high byte into the RAMPZ register
+	sts		RAMPZ, r19
+
+	; Load NVM command
+	ldi		r26, NVM_CMD_ERASE_WRITE_FLASH_PAGE_gc
+	call	NVM_ExecuteSPM
+
+	; Restore RAMPZ
+	out		RAMPZ, r18
+
+	ret
+
+;--
+;	Calculate the CRC-32 of the application section with the CRC module.
+;
+;	Input:
+;		r25:r22				Length in bytes
+;
+;	Return:
+;		r25:r22				CRC-32
+;--
+.section .text
+.global NVM_ApplicationCRC
+NVM_ApplicationCRC:
+	call	NVM_WaitBusy
+
+	; Reset the CRC module to all ones
+	ldi		r18, CRC_RESET_RESET1_gc
+	sts		CRC_CTRL, r18
+
+	; Enable the 32 bit mode before the source is selected
+	ldi		r18, CRC_CRC32_bm
+	sts		CRC_CTRL, r18
+
+	; Use the flash memory as source
+	ldi		r18, CRC_CRC32_bm | CRC_SOURCE_FLASH_gc
+	sts		CRC_CTRL, r18
+
+	; Load the start address
+	sts		NVM_ADDR0, r1
+	sts		NVM_ADDR1, r1
+	sts		NVM_ADDR2, r1
+
+	; Load the end address (length - 1)
+	subi	r22, 0x01
+	sbci	r23, 0x00
+	sbci	r24, 0x00
+	sts		NVM_DATA0, r22
+	sts		NVM_DATA1, r23
+	sts		NVM_DATA2, r24
+
+	; Execute the NVM command
+	ldi		r26, NVM_CMD_FLASH_RANGE_CRC_gc
+	sts		NVM_CMD, r26
+	ldi		r18, CCP_IOREG_gc
+	ldi		r19, NVM_CMDEX_bm
+	sts		CCP, r18
+	sts		NVM_CTRLA, r19
+	call	NVM_WaitBusy
+
+	; Clear the NVM command
+	sts		NVM_CMD, r1
+
+	; Read the result
+	lds		r22, CRC_CHECKSUM0
+	lds		r23, CRC_CHECKSUM1
+	lds		r24, CRC_CHECKSUM2
+	lds		r25, CRC_CHECKSUM3
+
+	; Disable the CRC module
+	sts		CRC_CTRL, r1
+
 	ret
\ No newline at end of file
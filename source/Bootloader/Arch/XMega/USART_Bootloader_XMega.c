@@ -30,26 +30,87 @@
  *  @author Daniel Kampert
  */
 
+#include <string.h>
+
 #include "Bootloader/Bootloader.h"
 
-/** @brief	Data buffer for the current line.
+/** @brief	Start address of the application.
  */
-static unsigned char _LineBuffer[PARSER_MAX_DATA_BYTES];
+static uint32_t _StartAddress;
+
+#if(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_BINARY)
+	/** @brief	Number of words which are loaded into the NVM page buffer between two USART polls.
+	 */
+	#define BOOTLOADER_COPY_WORDS			8
+
+	/** @brief	Page buffers for the received packets.
+	 */
+	static uint8_t _PageBuffer[BOOTLOADER_WINDOW][PARSER_MAX_DATA_BYTES];
+
+	#if((defined BOOTLOADER_USE_COMPRESSION) || (defined BOOTLOADER_USE_DELTA))
+		/** @brief	Compressed data bytes or patch bytes in each page buffer.
+		 */
+		static uint16_t _DataLength[BOOTLOADER_WINDOW];
+	#endif
+
+	#if(!defined BOOTLOADER_USE_COMPRESSION)
+		/** @brief	Page address for each page buffer.
+		 */
+		static uint16_t _PageAddress[BOOTLOADER_WINDOW];
+	#endif
+
+	/** @brief	Packet object for the parsing engine.
+	 */
+	static Parser_Packet_t _Packet;
+#else
+	/** @brief	Data block object for the parsing engine.
+	 */
+	static Parser_Block_t _Line;
+
+	/** @brief	Page address of the data in the NVM page buffer.
+	 */
+	static uint16_t _Page;
+
+	/** @brief	#true when the NVM page buffer contains data.
+	 */
+	static bool _PageLoaded;
+
+	/** @brief	Address behind the last data byte.
+	 */
+	static uint32_t _NextAddress;
+
+	/** @brief	Low byte of an incomplete code word and a flag for an incomplete code word.
+	 */
+	static uint8_t _LowByte;
+	static bool _LowByteLoaded;
+#endif
+
+#if(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_BINARY)
+	/** @brief			Receive a single character with the USART without waiting.
+	 *	@param Data		Pointer to received character
+	 *	@return			#true when a character was received
+	 */
+	static bool Bootloader_PollChar(unsigned char* Data)
+	{
+		if(((USART_t*)(&USART_NAME(BOOTLOADER_INTERFACE)))->STATUS & USART_RXCIF_bm)
+		{
+			*Data = ((USART_t*)(&USART_NAME(BOOTLOADER_INTERFACE)))->DATA;
 
-/** @brief	Data block object for the parsing engine.
- */
-static Parser_Block_t _Line = {
-		.pBuffer = _LineBuffer,
-	};
+			return true;
+		}
 
-/** @brief	Receive a single character with the USART.
- *	@return	Received character
- */
-static unsigned char Bootloader_GetChar(void)
-{
-	while(!(((USART_t*)(&USART_NAME(BOOTLOADER_INTERFACE)))->STATUS & USART_RXCIF_bm));
-	return ((USART_t*)(&USART_NAME(BOOTLOADER_INTERFACE)))->DATA;
-}
+		return false;
+	}
+#else
+	/** @brief	Receive a single character with the USART.
+	 *	@return	Received character
+	 */
+	static unsigned char Bootloader_GetChar(void)
+	{
+		while(!(((USART_t*)(&USART_NAME(BOOTLOADER_INTERFACE)))->STATUS & USART_RXCIF_bm));
+		return ((USART_t*)(&USART_NAME(BOOTLOADER_INTERFACE)))->DATA;
+	}
+#endif
 
 /** @brief		Transmit a single character with the USART.
  *	@param Data	Data byte to transmit
@@ -71,10 +132,87 @@ static void Bootloader_PutString(const char* Message)
 	}
 }
 
+#if(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_BINARY)
+	/** @brief				Transmit an acknowledge or a repeat request.
+	 *	@param Response		#PARSER_ACK or #PARSER_NAK
+	 *	@param Sequence		Sequence number
+	 */
+	static void Bootloader_Reply(const uint8_t Response, const uint8_t Sequence)
+	{
+		Bootloader_PutChar(Response);
+		Bootloader_PutChar(Sequence);
+	}
+#else
+	/** @brief	Write the NVM page buffer into the flash memory.
+	 */
+	static void Bootloader_FlushPage(void)
+	{
+		// Complete the last code word with the erased value
+		if(_LowByteLoaded)
+		{
+			NVM_LoadFlashBuffer(((_NextAddress - 0x01) % APP_SECTION_PAGE_SIZE) >> 0x01, 0xFF00 | _LowByte);
+			_LowByteLoaded = false;
+		}
+
+		if(_PageLoaded)
+		{
+			NVM_FlushFlash(_Page);
+			_PageLoaded = false;
+		}
+	}
+
+	/** @brief			Load a data byte into the NVM page buffer.
+						NOTE: A data byte for another page writes the current page. This can happen in the middle of a record,
+						so the sender is stopped while the page is written.
+	 *	@param Address	Byte address
+	 *	@param Data		Data byte
+	 */
+	static void Bootloader_LoadByte(const uint32_t Address, const uint8_t Data)
+	{
+		uint16_t Page = Address / APP_SECTION_PAGE_SIZE;
+
+		// Complete the last code word when the data isn't continuous
+		if(_LowByteLoaded && ((Address != _NextAddress) || (Page != _Page)))
+		{
+			NVM_LoadFlashBuffer(((_NextAddress - 0x01) % APP_SECTION_PAGE_SIZE) >> 0x01, 0xFF00 | _LowByte);
+			_LowByteLoaded = false;
+		}
+
+		if(Page != _Page)
+		{
+			// The USART can only buffer two bytes during the page write
+			if(_PageLoaded)
+			{
+				Bootloader_PutChar(XOFF);
+				Bootloader_FlushPage();
+				Bootloader_PutChar(XON);
+			}
+
+			_Page = Page;
+		}
+
+		if(Address & 0x01)
+		{
+			NVM_LoadFlashBuffer((Address % APP_SECTION_PAGE_SIZE) >> 0x01, (Data << 0x08) | (_LowByteLoaded ? _LowByte : 0xFF));
+			_LowByteLoaded = false;
+		}
+		else
+		{
+			_LowByte = Data;
+			_LowByteLoaded = true;
+		}
+
+		_NextAddress = Address + 0x01;
+		_PageLoaded = true;
+	}
+#endif
+
 void Bootloader_Init(void)
 {
-	// Remove the old application
-	NVM_EraseApplication();
+	// Remove the old application. A differential update needs the old application as base
+	#if(!defined BOOTLOADER_USE_DELTA)
+		NVM_EraseApplication();
+	#endif
 
 	// Enable the default clock
 	asm volatile(	"movw r30,  %0"		"\n\t"
@@ -100,64 +238,330 @@ void Bootloader_Init(void)
 	// Initialize the hex file parser
 	Parser_Init();
 
-	// Enable the transmitter by disabling the flow control
-	Bootloader_PutChar(XON);
+	#if(BOOTLOADER_FILE_FORMAT != HEX_FORMAT_BINARY)
+		// Enable the transmitter by disabling the flow control
+		Bootloader_PutChar(XON);
+	#endif
 }
 
+#if(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_BINARY)
 bool Bootloader_Enter(void)
 {
-	uint16_t Page = 0x00;
-	uint8_t Offset = 0x00;
+	uint8_t Received = 0x00;
+	uint8_t Programmed = 0x00;
 	uint16_t Words = 0x00;
+	uint16_t Timeout = 0x00;
+	uint32_t ImageLength = 0x00;
+	uint32_t ImageCRC = 0x00;
+	bool Finished = false;
+	bool Rejected = false;
+	unsigned char Data;
+
+	#if((defined BOOTLOADER_USE_COMPRESSION) || (defined BOOTLOADER_USE_DELTA))
+		uint16_t Page = 0x00;
+		uint16_t Remaining = 0x00;
+		const uint8_t* Input = NULL;
+	#endif
+
+	#if(defined BOOTLOADER_USE_COMPRESSION)
+		uint8_t LowByte = 0x00;
+		bool HighByte = false;
+
+		LZSS_Init();
+	#elif(defined BOOTLOADER_USE_DELTA)
+		bool Changed = false;
+	#endif
 
 	Bootloader_PutString("Enter bootloader...\n\r");
 
-	do
+	// Leave the loop when the end packet is received and all pages are written
+	while(!Finished || (Programmed != Received) || NVM_IsBusy())
 	{
-		if(Parser_GetByte(Bootloader_GetChar()) == PARSER_STATE_SUCCESSFUL)
+		// Receive the next packet into the next free page buffer. A page buffer can be released while the
+		// header of a packet is received, so the buffer is selected until the first data byte is received
+		if(Parser_IsIdle())
 		{
-			// Disable the transmitter
-			Bootloader_PutChar(XOFF);
+			_Packet.pBuffer = ((uint8_t)(Received - Programmed) < BOOTLOADER_WINDOW) ? _PageBuffer[Received % BOOTLOADER_WINDOW] : NULL;
+		}
 
-			// Parsing successfully?
-			if((Parser_Parse(&_Line) == PARSER_STATE_SUCCESSFUL) && _Line.Valid)
+		if(Bootloader_PollChar(&Data))
+		{
+			Parser_State_t State = Parser_GetByte(&_Packet, Data);
+
+			Timeout = 0x00;
+
+			if(State == PARSER_STATE_SUCCESSFUL)
 			{
-				if(_Line.Type == PARSER_TYPE_DATA)
+				uint8_t Distance = _Packet.Sequence - Received;
+
+				if(Distance == 0x00)
 				{
-					uint32_t Address = (_Line.Offset + _Line.Address) >> 0x01;
-					Offset = Address & 0xFF;
-					Page = (Address & 0x3FF00) >> 0x08;
+					Rejected = false;
 
-					for(uint8_t i = 0x00; i < _Line.Length; i += 0x02)
+					if((_Packet.Type == PARSER_PACKET_END) && ((_Packet.Length == 0x00) || (_Packet.pBuffer != NULL)))
 					{
-						uint16_t CodeWord = (_LineBuffer[i + 1] << 0x08) | _LineBuffer[i];
-						NVM_LoadFlashBuffer(Offset + (i >> 0x01), CodeWord);
+						// The end packet can contain the length and the CRC-32 of the image
+						if(_Packet.Length >= PARSER_END_DATA_BYTES)
+						{
+							memcpy(&ImageLength, &_Packet.pBuffer[0], sizeof(ImageLength));
+							memcpy(&ImageCRC, &_Packet.pBuffer[4], sizeof(ImageCRC));
+						}
+
+						_StartAddress = _Packet.Page;
+						Finished = true;
+					}
+					else if((_Packet.Type == PARSER_PACKET_DATA) && (_Packet.pBuffer != NULL))
+					{
+						#if(defined BOOTLOADER_USE_COMPRESSION)
+							// The page address is given by the decoded data
+							_DataLength[Received % BOOTLOADER_WINDOW] = _Packet.Length;
+						#elif(defined BOOTLOADER_USE_DELTA)
+							_DataLength[Received % BOOTLOADER_WINDOW] = _Packet.Length;
+							_PageAddress[Received % BOOTLOADER_WINDOW] = _Packet.Page;
+						#else
+							// Fill the rest of an incomplete page with the erased value
+							memset(&_Packet.pBuffer[_Packet.Length], 0xFF, APP_SECTION_PAGE_SIZE - _Packet.Length);
+							_PageAddress[Received % BOOTLOADER_WINDOW] = _Packet.Page;
+						#endif
+
+						Received++;
+					}
+					#if(defined BOOTLOADER_USE_DELTA)
+						else if((_Packet.Type == PARSER_PACKET_BASE) && (_Packet.Length >= PARSER_END_DATA_BYTES) && (_Packet.pBuffer != NULL) && (Programmed == Received))
+						{
+							uint32_t BaseLength;
+							uint32_t BaseCRC;
+
+							memcpy(&BaseLength, &_Packet.pBuffer[0], sizeof(BaseLength));
+							memcpy(&BaseCRC, &_Packet.pBuffer[4], sizeof(BaseCRC));
+
+							// The patches can only be applied to the application they were created for
+							if(NVM_ApplicationCRC(BaseLength) != BaseCRC)
+							{
+								Bootloader_Reply(PARSER_ERROR, Received);
+
+								return false;
+							}
+
+							Received++;
+							Bootloader_Reply(PARSER_ACK, Programmed++);
+						}
+					#endif
+					else if(!Rejected)
+					{
+						// No page buffer was free when the data bytes were received
+						Bootloader_Reply(PARSER_NAK, Received);
+						Rejected = true;
+					}
+				}
+				else if(Distance & 0x80)
+				{
+					// Repeated packet, because the acknowledge was lost
+					Bootloader_Reply(PARSER_ACK, Programmed - 0x01);
+				}
+
+				// Packets after a missing packet are dropped without a response
+			}
+			else if((State != PARSER_STATE_BUSY) && !Rejected)
+			{
+				// Request the packet only once. The rest of the broken packet can contain more start bytes
+				// and the sender would repeat the packets for each request
+				Bootloader_Reply(PARSER_NAK, Received);
+				Rejected = true;
+			}
+		}
+		else if(++Timeout == BOOTLOADER_TIMEOUT)
+		{
+			// Drop an incomplete packet and request the missing packets again
+			Timeout = 0x00;
+			Parser_Init();
+
+			if(!Finished)
+			{
+				Bootloader_Reply(PARSER_NAK, Received);
+				Rejected = true;
+			}
+		}
+
+		// Load the next page into the NVM page buffer while the packets are received.
+		// The page buffer can only be loaded when the last page write is complete
+		if((Programmed != Received) && !NVM_IsBusy())
+		{
+			#if(defined BOOTLOADER_USE_COMPRESSION)
+				if(Input == NULL)
+				{
+					Input = _PageBuffer[Programmed % BOOTLOADER_WINDOW];
+					Remaining = _DataLength[Programmed % BOOTLOADER_WINDOW];
+				}
+
+				for(uint8_t i = 0x00; i < (BOOTLOADER_COPY_WORDS << 0x01); i++)
+				{
+					if(LZSS_Decode(&Input, &Remaining, &Data) == LZSS_STATE_INPUT)
+					{
+						// The packet is decoded and the page buffer can be used for the next packet
+						Input = NULL;
+						Bootloader_Reply(PARSER_ACK, Programmed++);
+
+						break;
+					}
+
+					if(!HighByte)
+					{
+						LowByte = Data;
+						HighByte = true;
+					}
+					else
+					{
+						NVM_LoadFlashBuffer(Words, (Data << 0x08) | LowByte);
+						HighByte = false;
 
 						// Write the page when the buffer is full
-						if(Words++ == ((APP_SECTION_PAGE_SIZE / 2) - 1))
+						if(++Words == (APP_SECTION_PAGE_SIZE / 2))
 						{
-							NVM_FlushFlash(Page);
+							NVM_StartFlushFlash(Page++);
 							Words = 0x00;
+
+							break;
 						}
 					}
 				}
-			}
-			else
+			#elif(defined BOOTLOADER_USE_DELTA)
+				if(Input == NULL)
+				{
+					Input = _PageBuffer[Programmed % BOOTLOADER_WINDOW];
+					Remaining = _DataLength[Programmed % BOOTLOADER_WINDOW];
+					Page = _PageAddress[Programmed % BOOTLOADER_WINDOW];
+					Changed = false;
+					Delta_Init();
+				}
+
+				// The old page can only be read when the NVM controller is ready
+				uint32_t Address = ((uint32_t)Page * APP_SECTION_PAGE_SIZE) + (Words << 0x01);
+
+				for(uint8_t i = 0x00; (i < BOOTLOADER_COPY_WORDS) && (Words < (APP_SECTION_PAGE_SIZE / 2)); i++, Words++, Address += 0x02)
+				{
+					uint16_t Old = pgm_read_word_far(Address);
+					uint16_t New = Delta_Decode(&Input, &Remaining, Old & 0xFF);
+
+					New |= Delta_Decode(&Input, &Remaining, Old >> 0x08) << 0x08;
+					Changed |= (New != Old);
+
+					NVM_LoadFlashBuffer(Words, New);
+				}
+
+				if(Words == (APP_SECTION_PAGE_SIZE / 2))
+				{
+					// Skip the erase and the write when the patch doesn't change the page
+					if(Changed)
+					{
+						NVM_StartFlushFlash(Page);
+					}
+					else
+					{
+						NVM_ClearFlashBuffer();
+					}
+
+					Words = 0x00;
+					Input = NULL;
+
+					// The page buffer can be used for the next packet
+					Bootloader_Reply(PARSER_ACK, Programmed++);
+				}
+			#else
+				uint8_t* Page = _PageBuffer[Programmed % BOOTLOADER_WINDOW];
+
+				for(uint8_t i = 0x00; (i < BOOTLOADER_COPY_WORDS) && (Words < (APP_SECTION_PAGE_SIZE / 2)); i++, Words++)
+				{
+					NVM_LoadFlashBuffer(Words, (Page[(Words << 0x01) + 1] << 0x08) | Page[Words << 0x01]);
+				}
+
+				if(Words == (APP_SECTION_PAGE_SIZE / 2))
+				{
+					NVM_StartFlushFlash(_PageAddress[Programmed % BOOTLOADER_WINDOW]);
+					Words = 0x00;
+
+					// The page buffer can be used for the next packet
+					Bootloader_Reply(PARSER_ACK, Programmed++);
+				}
+			#endif
+		}
+	}
+
+	#if(defined BOOTLOADER_USE_COMPRESSION)
+		// Write the last incomplete page and fill the rest of the page with the erased value
+		if(HighByte)
+		{
+			NVM_LoadFlashBuffer(Words++, 0xFF00 | LowByte);
+		}
+
+		if(Words > 0x00)
+		{
+			while(Words < (APP_SECTION_PAGE_SIZE / 2))
 			{
-				// Error handling
+				NVM_LoadFlashBuffer(Words++, 0xFFFF);
+			}
 
-				return false;
+			NVM_FlushFlash(Page);
+		}
+	#endif
+
+	// Compare the programmed application with the CRC-32 from the end packet
+	if((ImageLength > 0x00) && (NVM_ApplicationCRC(ImageLength) != ImageCRC))
+	{
+		Bootloader_Reply(PARSER_ERROR, Received);
+
+		return false;
+	}
+
+	Bootloader_Reply(PARSER_ACK, Received);
+
+	return true;
+}
+#else
+bool Bootloader_Enter(void)
+{
+	Parser_State_t State;
+
+	Bootloader_PutString("Enter bootloader...\n\r");
+
+	do
+	{
+		State = Parser_GetByte(&_Line, Bootloader_GetChar());
+
+		if(State == PARSER_STATE_DATA)
+		{
+			// Load the data bytes directly into the NVM page buffer
+			Bootloader_LoadByte(_Line.Offset + _Line.Address, _Line.Data);
+		}
+		else if(State == PARSER_STATE_SUCCESSFUL)
+		{
+			// Disable the transmitter
+			Bootloader_PutChar(XOFF);
+
+			// Write the page when the buffer is full
+			if((_Line.Type == PARSER_TYPE_DATA) && ((_NextAddress % APP_SECTION_PAGE_SIZE) == 0x00))
+			{
+				Bootloader_FlushPage();
 			}
 
 			// Enable the transmitter
 			Bootloader_PutChar(XON);
 		}
-	} while(_Line.Type != PARSER_TYPE_EOF);
+		else if(State != PARSER_STATE_BUSY)
+		{
+			// Error handling
+
+			return false;
+		}
+	} while((State != PARSER_STATE_SUCCESSFUL) || (_Line.Type != PARSER_TYPE_EOF));
+
+	Bootloader_FlushPage();
 
-	NVM_FlushFlash(Page);
+	_StartAddress = _Line.StartAddress;
 
 	return true;
 }
+#endif
 
 void Bootloader_Exit(void)
 {
@@ -179,7 +583,7 @@ void Bootloader_Exit(void)
 	EIND = 0x00;
 	asm volatile("ld   %0, Z" "\n\t"
 				 "ijmp"		  "\n\t"
-			::	 "r" (_Line.StartAddress)
+			::	 "r" (_StartAddress)
 			:    "r30", "r31"
 		);
 }
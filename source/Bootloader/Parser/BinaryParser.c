@@ -0,0 +1,185 @@
+/*
+ * BinaryParser.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Bootloader parser for the binary packet format.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Common/Parser/BinaryParser.c
+ *  @brief Bootloader parser for the binary packet format.
+ *
+ *  This file contains the implementation for the binary packet format parser.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <util/crc16.h>
+
+#include "Bootloader/Parser/BinaryParser.h"
+
+#if(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_BINARY)
+
+/** @brief States for the parsing state machine.
+ */
+typedef enum
+{
+	PARSER_INIT = 0x00,										/**< Wait for the start byte */
+	PARSER_GET_SEQUENCE = 0x01,								/**< Get the sequence number */
+	PARSER_GET_PAGE = 0x02,									/**< Get the page address */
+	PARSER_GET_LENGTH = 0x03,								/**< Get the data length */
+	PARSER_GET_DATA = 0x04,									/**< Get the data bytes */
+	PARSER_GET_CHECK = 0x05,								/**< Get the CRC */
+} StateMachine_t;
+
+/** @brief	Current state for the parser state machine.
+ */
+static StateMachine_t _ParserState;
+
+/** @brief	Byte index in the current field.
+ */
+static uint16_t _Index;
+
+/** @brief	CRC of the current packet.
+ */
+static uint16_t _CRC;
+
+/** @brief	Received CRC of the current packet.
+ */
+static uint16_t _Checksum;
+
+void Parser_Init(void)
+{
+	_ParserState = PARSER_INIT;
+}
+
+bool Parser_IsIdle(void)
+{
+	return _ParserState < PARSER_GET_DATA;
+}
+
+Parser_State_t Parser_GetByte(Parser_Packet_t* Packet, const uint8_t Received)
+{
+	if(_ParserState != PARSER_GET_CHECK)
+	{
+		_CRC = _crc_xmodem_update(_CRC, Received);
+	}
+
+	switch(_ParserState)
+	{
+		case PARSER_INIT:
+		{
+			// Ignore everything until a start byte is received
+			if((Received == PARSER_PACKET_DATA) || (Received == PARSER_PACKET_END) || (Received == PARSER_PACKET_BASE))
+			{
+				Packet->Type = Received;
+				_CRC = 0x00;
+				_Index = 0x00;
+				_ParserState = PARSER_GET_SEQUENCE;
+			}
+
+			break;
+		}
+		case PARSER_GET_SEQUENCE:
+		{
+			Packet->Sequence = Received;
+			_ParserState = PARSER_GET_PAGE;
+
+			break;
+		}
+		case PARSER_GET_PAGE:
+		{
+			if(_Index++ == 0x00)
+			{
+				Packet->Page = Received;
+			}
+			else
+			{
+				Packet->Page |= ((uint16_t)Received) << 0x08;
+				_Index = 0x00;
+				_ParserState = PARSER_GET_LENGTH;
+			}
+
+			break;
+		}
+		case PARSER_GET_LENGTH:
+		{
+			if(_Index++ == 0x00)
+			{
+				Packet->Length = Received;
+			}
+			else
+			{
+				Packet->Length |= ((uint16_t)Received) << 0x08;
+				_Index = 0x00;
+
+				if(Packet->Length > PARSER_MAX_DATA_BYTES)
+				{
+					_ParserState = PARSER_INIT;
+
+					return PARSER_STATE_OVERFLOW;
+				}
+
+				_ParserState = (Packet->Length > 0x00) ? PARSER_GET_DATA : PARSER_GET_CHECK;
+			}
+
+			break;
+		}
+		case PARSER_GET_DATA:
+		{
+			if(Packet->pBuffer != NULL)
+			{
+				Packet->pBuffer[_Index] = Received;
+			}
+
+			if(++_Index == Packet->Length)
+			{
+				_Index = 0x00;
+				_ParserState = PARSER_GET_CHECK;
+			}
+
+			break;
+		}
+		case PARSER_GET_CHECK:
+		{
+			if(_Index++ == 0x00)
+			{
+				_Checksum = Received;
+			}
+			else
+			{
+				_Checksum |= ((uint16_t)Received) << 0x08;
+				_ParserState = PARSER_INIT;
+
+				if(_Checksum == _CRC)
+				{
+					return PARSER_STATE_SUCCESSFUL;
+				}
+
+				return PARSER_STATE_ERROR;
+			}
+
+			break;
+		}
+	}
+
+	return PARSER_STATE_BUSY;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+ * DeltaPatch.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Page patch decoder for differential bootloader updates.
+
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Common/Parser/DeltaPatch.c
+ *  @brief Page patch decoder for differential bootloader updates.
+ *
+ *  This file contains the implementation for the page patch decoder.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include "Bootloader/Bootloader.h"
+
+#if(defined BOOTLOADER_USE_DELTA)
+
+/** @brief	Remaining bytes of the current operation.
+ */
+static uint8_t _Count;
+
+/** @brief	#true when the current operation replaces the old bytes.
+ */
+static bool _Replace;
+
+void Delta_Init(void)
+{
+	_Count = 0x00;
+}
+
+uint8_t Delta_Decode(const uint8_t** Input, uint16_t* Length, const uint8_t Old)
+{
+	if(_Count == 0x00)
+	{
+		// Copy the rest of the page when the patch is complete
+		if(*Length == 0x00)
+		{
+			return Old;
+		}
+
+		uint8_t Operation = *(*Input)++;
+		(*Length)--;
+
+		_Replace = Operation & 0x80;
+		_Count = (Operation & 0x7F) + 0x01;
+	}
+
+	_Count--;
+
+	if(_Replace && (*Length > 0x00))
+	{
+		(*Length)--;
+
+		return *(*Input)++;
+	}
+
+	return Old;
+}
+
+#endif
\ No newline at end of file
@@ -32,255 +32,203 @@
 
 #include "Bootloader/Parser/IntelHexParser.h"
 
-/** @brief States for the parsing state machine.
+#if(BOOTLOADER_FILE_FORMAT == HEX_FORMAT_INTEL)
+
+/** @brief	Byte positions in a record.
  */
-typedef enum
-{
-	PARSER_INIT = 0x00,										/**< Initial state */
-	PARSER_GET_SIZE = 0x01,									/**< Get the size from the line */
-	PARSER_GET_ADDRESS = 0x02,								/**< Get the address from the line */
-	PARSER_GET_TYPE = 0x03,									/**< Get the type and the data from the line */
-	PARSER_GET_CHECK = 0x05,								/**< Get the checksum from the line */
-	PARSER_HANDLE_ERROR = 0x06,								/**< Error handler */
-} StateMachine_t;
-
-/** @brief	Line buffer for the parsing state machine.
+#define PARSER_POS_LENGTH				0x00
+#define PARSER_POS_ADDRESS_HIGH			0x01
+#define PARSER_POS_ADDRESS_LOW			0x02
+#define PARSER_POS_TYPE					0x03
+#define PARSER_POS_DATA					0x04
+
+/** @brief	Marker for an invalid character in the nibble table.
+ */
+#define PARSER_INVALID					0xF0
+
+/** @brief	Nibble values for the characters '0' to 'f'. Invalid characters are marked with #PARSER_INVALID.
  */
-static uint8_t _ParserBuffer[PARSER_LENGTH_BYTES + PARSER_ADDRESS_BYTES + PARSER_TYPE_BYTES + (PARSER_MAX_DATA_BYTES * PARSER_DATA_BYTES) + PARSER_CHECK_BYTES];
+static const uint8_t _Nibble['f' - '0' + 1] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,	// '0' - '9'
+	0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,	// ':' - '@'
+	0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,	// 'A' - 'F'
+	0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,	// 'G' - '`'
+	0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,	// 'a' - 'f'
+};
 
 /** @brief	Boolean value to flag the parser as active.
  */
 static bool _IsActive;
 
-/** @brief	Current line buffer index.
+/** @brief	#true when the next character is the high nibble of a byte.
  */
-static uint8_t _Index;
+static bool _HighNibble;
 
-/** @brief	Current state for the parser state machine.
+/** @brief	Current byte position in the record.
  */
-static StateMachine_t _ParserState;
+static uint16_t _Position;
 
-/** @brief	Current state of the parsing engine.
+/** @brief	Current byte.
  */
-static Parser_State_t _ParserEngineState;
+static uint8_t _Byte;
 
-/** @brief			Convert a hexadecimal string number into an integer value.
- *  @param ASCII	Number as a string
- *  @param Length	String length
- *  @return			Integer value of the string
+/** @brief	Sum of all bytes of the record.
  */
-static uint16_t Hex2Num(const uint8_t Length)
-{
-	uint16_t Temp = 0x00;
-
-	for(uint8_t i = 0x00; i < Length; i++)
-	{
-		uint8_t c = _ParserBuffer[_Index++];
-
-		if(c >= '0' && c <= '9')
-		{
-			c -= '0';
-		}
-		else if(c >= 'A' && c <= 'F')
-		{
-			c -= 'A' - 10;
-		}
-		else if(c >= 'a' && c <= 'f')
-		{
-			c -= 'a' - 10;
-		}
+static uint8_t _Checksum;
 
-		Temp = (Temp << 0x04) + c;
-	}
+/** @brief	Collected invalid character flags of the record.
+ */
+static uint8_t _Error;
 
-	return Temp;
-}
+/** @brief	Data of an address record.
+ */
+static uint32_t _Value;
 
 void Parser_Init(void)
 {
-	_ParserState = PARSER_INIT;
 	_IsActive = false;
 }
 
-Parser_State_t Parser_GetByte(const uint8_t Received)
+Parser_State_t Parser_GetByte(Parser_Block_t* Line, const uint8_t Received)
 {
-	if(_IsActive)
+	// Each start character starts a new record
+	if(Received == PARSER_LINE_START)
+	{
+		_IsActive = true;
+		_HighNibble = true;
+		_Position = PARSER_POS_LENGTH;
+		_Checksum = 0x00;
+		_Error = 0x00;
+		_Value = 0x00;
+		Line->Valid = false;
+
+		return PARSER_STATE_BUSY;
+	}
+
+	// Ignore the line endings and everything outside of a record
+	if(!_IsActive)
+	{
+		return PARSER_STATE_BUSY;
+	}
+
+	// Decode the nibble with the lookup table. Invalid characters are collected and checked with the checksum
+	uint8_t Index = Received - '0';
+	uint8_t Nibble = (Index < sizeof(_Nibble)) ? _Nibble[Index] : PARSER_INVALID;
+	_Error |= Nibble;
+
+	if(_HighNibble)
+	{
+		_Byte = Nibble << 0x04;
+		_HighNibble = false;
+
+		return PARSER_STATE_BUSY;
+	}
+
+	_Byte |= Nibble & 0x0F;
+	_HighNibble = true;
+	_Checksum += _Byte;
+
+	switch(_Position++)
 	{
-		if(Received == PARSER_LINE_END)
+		case PARSER_POS_LENGTH:
 		{
-			_Index = 0x00;
-			_IsActive = false;
-			_ParserState = PARSER_INIT;
+			Line->Length = _Byte;
 
-			return PARSER_STATE_SUCCESSFUL;
+			return PARSER_STATE_BUSY;
 		}
-
-		if(_Index < sizeof(_ParserBuffer))
+		case PARSER_POS_ADDRESS_HIGH:
 		{
-			_ParserBuffer[_Index++] = Received;
+			Line->Address = ((uint16_t)_Byte) << 0x08;
+
+			return PARSER_STATE_BUSY;
 		}
-		else
+		case PARSER_POS_ADDRESS_LOW:
 		{
-			_Index = 0x00;
+			Line->Address |= _Byte;
 
-			return PARSER_STATE_OVERFLOW;
+			return PARSER_STATE_BUSY;
 		}
-	}
+		case PARSER_POS_TYPE:
+		{
+			Line->Type = _Byte;
 
-	// Wait for the beginning of a new line
-	if(Received == ':')
-	{
-		_Index = 0x00;
-		_IsActive = true;
-	}
+			if(_Byte > PARSER_TYPE_SLA)
+			{
+				_IsActive = false;
 
-	return PARSER_STATE_BUSY;
-}
+				return PARSER_STATE_ERROR;
+			}
 
-Parser_State_t Parser_Parse(Parser_Block_t* Line)
-{
-	_ParserEngineState = PARSER_STATE_BUSY;
+			return PARSER_STATE_BUSY;
+		}
+	}
 
-	do
+	// Data bytes
+	if(_Position <= (PARSER_POS_DATA + Line->Length))
 	{
-		switch(_ParserState)
+		if(Line->Type == PARSER_TYPE_DATA)
 		{
-			case PARSER_INIT:
+			// Pass the data byte with the address to the caller
+			if(_Position > (PARSER_POS_DATA + 0x01))
 			{
-				Line->Checksum = 0x00;
-				Line->Length = 0x00;
+				Line->Address++;
+			}
 
-				_ParserState = PARSER_GET_SIZE;
+			Line->Data = _Byte;
 
-				break;
-			}
-			case PARSER_GET_SIZE:
-			{
-				uint8_t Length = Hex2Num(PARSER_LENGTH_BYTES);
-				Line->Length = Length;
-				Line->Checksum += Length;
+			return PARSER_STATE_DATA;
+		}
 
-				_ParserState = PARSER_GET_ADDRESS;
+		_Value = (_Value << 0x08) | _Byte;
 
-				break;
-			}
-			case PARSER_GET_ADDRESS:
-			{
-				uint16_t Address = Hex2Num(PARSER_ADDRESS_BYTES);
-				Line->Address = Address;
-				Line->Checksum += (Address >> 0x08) + (Address & 0xFF);
+		return PARSER_STATE_BUSY;
+	}
 
-				_ParserState = PARSER_GET_TYPE;
+	// Checksum. The sum of all bytes including the checksum is zero for a valid record
+	_IsActive = false;
 
-				break;
-			}
-			case PARSER_GET_TYPE:
-			{
-				uint8_t Type = Hex2Num(PARSER_TYPE_BYTES);
-				Line->Type = Type;
-				Line->Checksum += Type;
-
-				switch(Type)
-				{
-					case PARSER_TYPE_DATA:
-					{
-						for(uint8_t i = 0x00; i < Line->Length; i++)
-						{
-							uint8_t Data = Hex2Num(PARSER_DATA_BYTES);
-							*(Line->pBuffer + i) = Data;
-							Line->Checksum += Data;
-						}
-
-						_ParserState = PARSER_GET_CHECK;
-
-						break;
-					}
-					case PARSER_TYPE_EOF:
-					{
-						_ParserState = PARSER_GET_CHECK;
-
-						break;
-					}
-					case PARSER_TYPE_ESA:
-					{
-						Line->Offset = 0x00;
-
-						for(uint8_t i = 0x00; i < 0x02; i++)
-						{
-							uint8_t Data = Hex2Num(PARSER_DATA_BYTES);
-							Line->Offset |= Data;
-							Line->Offset <<= 0x04;
-							Line->Checksum += Data;
-						}
-
-						// Multiply the address with 4 (according to the specification)
-						Line->Offset <<= 0x04;
-
-						_ParserState = PARSER_GET_CHECK;
-
-						break;
-					}
-					case PARSER_TYPE_SSA:
-					{
-						Line->StartAddress = 0x00;
-
-						for(uint8_t i = 0x00; i < 0x04; i++)
-						{
-							uint8_t Data = Hex2Num(PARSER_DATA_BYTES);
-							Line->StartAddress |= Data;
-							Line->StartAddress <<= 0x04;
-							Line->Checksum += Data;
-						}
-
-						_ParserState = PARSER_GET_CHECK;
-
-						break;
-					}
-					case PARSER_TYPE_ELA:
-					{
-						break;
-					}
-					case PARSER_TYPE_SLA:
-					{
-						break;
-					}
-					default:
-					{
-						_ParserState = PARSER_HANDLE_ERROR;
-
-						break;
-					}
-				}
-
-				break;
-			}
-			case PARSER_GET_CHECK:
-			{
-				uint8_t Checksum_Temp = ~(Line->Checksum & 0xFF) + 0x01;
-				Line->Checksum = Hex2Num(PARSER_CHECK_BYTES);
-
-				if(Line->Checksum == Checksum_Temp)
-				{
-					Line->Valid = true;
-					_ParserEngineState = PARSER_STATE_SUCCESSFUL;
-				}
-				else
-				{
-					Line->Valid = false;
-					_ParserEngineState = PARSER_STATE_ERROR;
-				}
-
-				break;
-			}
-			case PARSER_HANDLE_ERROR:
-			{
-				_ParserEngineState = PARSER_STATE_ERROR;
+	if((_Checksum != 0x00) || (_Error & PARSER_INVALID))
+	{
+		return PARSER_STATE_ERROR;
+	}
 
-				break;
-			}
+	switch(Line->Type)
+	{
+		case PARSER_TYPE_ESA:
+		{
+			// Multiply the segment with 16 (according to the specification)
+			Line->Offset = _Value << 0x04;
+
+			break;
+		}
+		case PARSER_TYPE_SSA:
+		{
+			// CS:IP
+			Line->StartAddress = ((_Value >> 0x10) << 0x04) + (_Value & 0xFFFF);
+
+			break;
+		}
+		case PARSER_TYPE_ELA:
+		{
+			Line->Offset = _Value << 0x10;
+
+			break;
+		}
+		case PARSER_TYPE_SLA:
+		{
+			Line->StartAddress = _Value;
+
+			break;
+		}
+		default:
+		{
+			break;
 		}
 	}
-	while(_ParserEngineState == PARSER_STATE_BUSY);
 
-	return _ParserEngineState;
-}
\ No newline at end of file
+	Line->Valid = true;
+
+	return PARSER_STATE_SUCCESSFUL;
+}
+
+#endif
\ No newline at end of file
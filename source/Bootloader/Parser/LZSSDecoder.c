@@ -0,0 +1,203 @@
+/*
+ * LZSSDecoder.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: LZSS decoder for compressed bootloader images.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Common/Parser/LZSSDecoder.c
+ *  @brief LZSS decoder for compressed bootloader images.
+ *
+ *  This file contains the implementation for the streaming LZSS decoder.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include "Bootloader/Bootloader.h"
+
+#if(defined BOOTLOADER_USE_COMPRESSION)
+
+/** @brief	Size of the history window.
+ */
+#define LZSS_WINDOW_SIZE			(0x01 << BOOTLOADER_LZSS_WINDOW_BITS)
+
+/** @brief States for the decoding state machine.
+ */
+typedef enum
+{
+	LZSS_GET_TAG = 0x00,									/**< Get the tag bit */
+	LZSS_GET_LITERAL = 0x01,								/**< Get a literal */
+	LZSS_GET_OFFSET = 0x02,									/**< Get the offset of a back reference */
+	LZSS_GET_LENGTH = 0x03,									/**< Get the length of a back reference */
+	LZSS_COPY = 0x04,										/**< Copy the back reference */
+} StateMachine_t;
+
+/** @brief	History window with the last decoded bytes.
+ */
+static uint8_t _Window[LZSS_WINDOW_SIZE];
+
+/** @brief	Write position in the history window.
+ */
+static uint16_t _Head;
+
+/** @brief	Current state for the decoding state machine.
+ */
+static StateMachine_t _DecoderState;
+
+/** @brief	Current input byte and mask for the next bit.
+ */
+static uint8_t _Byte;
+static uint8_t _Mask;
+
+/** @brief	Bits of the current field.
+ */
+static uint16_t _Field;
+static uint8_t _FieldBits;
+
+/** @brief	Offset and remaining length of the current back reference.
+ */
+static uint16_t _Offset;
+static uint8_t _Length;
+
+/** @brief			Read the bits of the current field.
+ *  @param Input	Pointer to input pointer
+ *  @param Length	Pointer to remaining input bytes
+ *  @param Bits		Field size in bits
+ *  @return			#false when more input is needed
+ */
+static bool LZSS_GetBits(const uint8_t** Input, uint16_t* Length, const uint8_t Bits)
+{
+	while(_FieldBits < Bits)
+	{
+		if(_Mask == 0x00)
+		{
+			if(*Length == 0x00)
+			{
+				return false;
+			}
+
+			_Byte = *(*Input)++;
+			(*Length)--;
+			_Mask = 0x80;
+		}
+
+		_Field = (_Field << 0x01) | ((_Byte & _Mask) ? 0x01 : 0x00);
+		_Mask >>= 0x01;
+		_FieldBits++;
+	}
+
+	return true;
+}
+
+/** @brief			Store a decoded byte in the history window.
+ *  @param Data		Decoded byte
+ */
+static void LZSS_Store(const uint8_t Data)
+{
+	_Window[_Head] = Data;
+	_Head = (_Head + 0x01) & (LZSS_WINDOW_SIZE - 0x01);
+}
+
+void LZSS_Init(void)
+{
+	_Head = 0x00;
+	_Mask = 0x00;
+	_Field = 0x00;
+	_FieldBits = 0x00;
+	_DecoderState = LZSS_GET_TAG;
+}
+
+LZSS_State_t LZSS_Decode(const uint8_t** Input, uint16_t* Length, uint8_t* Output)
+{
+	while(true)
+	{
+		switch(_DecoderState)
+		{
+			case LZSS_GET_TAG:
+			{
+				if(!LZSS_GetBits(Input, Length, 0x01))
+				{
+					return LZSS_STATE_INPUT;
+				}
+
+				_DecoderState = _Field ? LZSS_GET_LITERAL : LZSS_GET_OFFSET;
+
+				break;
+			}
+			case LZSS_GET_LITERAL:
+			{
+				if(!LZSS_GetBits(Input, Length, 0x08))
+				{
+					return LZSS_STATE_INPUT;
+				}
+
+				*Output = _Field;
+				LZSS_Store(*Output);
+				_DecoderState = LZSS_GET_TAG;
+				_Field = 0x00;
+				_FieldBits = 0x00;
+
+				return LZSS_STATE_OUTPUT;
+			}
+			case LZSS_GET_OFFSET:
+			{
+				if(!LZSS_GetBits(Input, Length, BOOTLOADER_LZSS_WINDOW_BITS))
+				{
+					return LZSS_STATE_INPUT;
+				}
+
+				_Offset = _Field + 0x01;
+				_DecoderState = LZSS_GET_LENGTH;
+
+				break;
+			}
+			case LZSS_GET_LENGTH:
+			{
+				if(!LZSS_GetBits(Input, Length, BOOTLOADER_LZSS_LENGTH_BITS))
+				{
+					return LZSS_STATE_INPUT;
+				}
+
+				_Length = _Field + 0x02;
+				_DecoderState = LZSS_COPY;
+
+				break;
+			}
+			case LZSS_COPY:
+			{
+				*Output = _Window[(_Head - _Offset) & (LZSS_WINDOW_SIZE - 0x01)];
+				LZSS_Store(*Output);
+
+				if(--_Length == 0x00)
+				{
+					_DecoderState = LZSS_GET_TAG;
+				}
+
+				return LZSS_STATE_OUTPUT;
+			}
+		}
+
+		// Start a new field
+		_Field = 0x00;
+		_FieldBits = 0x00;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -29,7 +29,7 @@
  */
 #include "Common/Font/Font.h"
 
-const uint8_t* FontTable[95] = {
+const uint8_t* const FontTable[95] PROGMEM = {
 	__Char_32, __Char_33, __Char_34, __Char_35, __Char_36, __Char_37, __Char_38, __Char_39,
 	__Char_40, __Char_41, __Char_42, __Char_43, __Char_44, __Char_45, __Char_46, __Char_47,
 	__Char_N0, __Char_N1, __Char_N2, __Char_N3, __Char_N4, __Char_N5, __Char_N6, __Char_N7,
@@ -45,20 +45,20 @@ const uint8_t* FontTable[95] = {
 };
 
 // 0x20 - 32 - ' '
-const uint8_t __Char_32[3] = {
+const uint8_t __Char_32[3] PROGMEM = {
 	2, 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 0, 0)
 };
 
 // 0x21 - 33 - '!'
-const uint8_t __Char_33[2] = {
+const uint8_t __Char_33[2] PROGMEM = {
 	1, 
 	Bits2Bytes(1, 0, 1, 1, 1, 1, 1, 0)
 };
 
 // 0x22 - 34 - '"'
-const uint8_t __Char_34[4] = {
+const uint8_t __Char_34[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 0, 0), 
@@ -66,7 +66,7 @@ const uint8_t __Char_34[4] = {
 };
 
 // 0x23 - 35 - '#'
-const uint8_t __Char_35[6] = {
+const uint8_t __Char_35[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
@@ -76,7 +76,7 @@ const uint8_t __Char_35[6] = {
 };
 
 // 0x24 - 36 - '$'
-const uint8_t __Char_36[6] = {
+const uint8_t __Char_36[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 0, 0, 1, 0, 0, 0), 
 	Bits2Bytes(0, 1, 0, 1, 0, 1, 0, 0), 
@@ -86,7 +86,7 @@ const uint8_t __Char_36[6] = {
 };
 
 // 0x25 - 37 - '%'
-const uint8_t __Char_37[6] = {
+const uint8_t __Char_37[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 0, 0, 0, 1, 1, 0), 
 	Bits2Bytes(0, 0, 1, 0, 0, 1, 1, 0), 
@@ -96,7 +96,7 @@ const uint8_t __Char_37[6] = {
 };
 
 // 0x26 - 38 - '&'
-const uint8_t __Char_38[6] = {
+const uint8_t __Char_38[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 1, 0, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 1, 0), 
@@ -106,13 +106,13 @@ const uint8_t __Char_38[6] = {
 };
 
 // 0x27 - 39 - '''
-const uint8_t __Char_39[2] = {
+const uint8_t __Char_39[2] PROGMEM = {
 	1, 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 1, 0)
 };
 
 // 0x28 - 40 - '('
-const uint8_t __Char_40[4] = {
+const uint8_t __Char_40[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 1, 0, 0, 0, 1, 0, 0), 
@@ -120,7 +120,7 @@ const uint8_t __Char_40[4] = {
 };
 
 // 0x29 - 41 - ')'
-const uint8_t __Char_41[4] = {
+const uint8_t __Char_41[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(0, 1, 0, 0, 0, 1, 0, 0), 
@@ -128,7 +128,7 @@ const uint8_t __Char_41[4] = {
 };
 
 // 0x2A - 42 - '*'
-const uint8_t __Char_42[4] = {
+const uint8_t __Char_42[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
@@ -136,7 +136,7 @@ const uint8_t __Char_42[4] = {
 };
 
 // 0x2B - 43 - '+'
-const uint8_t __Char_43[4] = {
+const uint8_t __Char_43[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 1, 1, 1, 0, 0, 0), 
@@ -144,13 +144,13 @@ const uint8_t __Char_43[4] = {
 };
 
 // 0x2C - 44 - ', '
-const uint8_t __Char_44[2] = {
+const uint8_t __Char_44[2] PROGMEM = {
 	1, 
 	Bits2Bytes(1, 1, 0, 0, 0, 0, 0, 0)
 };
 
 // 0x2D - 45 - '-'
-const uint8_t __Char_45[4] = {
+const uint8_t __Char_45[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
@@ -158,13 +158,13 @@ const uint8_t __Char_45[4] = {
 };
 
 // 0x2E - 46 - '.'
-const uint8_t __Char_46[2] = {
+const uint8_t __Char_46[2] PROGMEM = {
 	1, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0)
 };
 
 // 0x2F - 47 - '/'
-const uint8_t __Char_47[4] = {
+const uint8_t __Char_47[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 1, 0, 0, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 1, 1, 1, 0, 0, 0), 
@@ -172,7 +172,7 @@ const uint8_t __Char_47[4] = {
 };
 
 // 0x30 - 48 - '0'
-const uint8_t __Char_N0[6] = {
+const uint8_t __Char_N0[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 1, 0, 0, 0, 1, 0), 
@@ -182,7 +182,7 @@ const uint8_t __Char_N0[6] = {
 };
 
 // 0x31 - 49 - '1'
-const uint8_t __Char_N1[6] = {
+const uint8_t __Char_N1[6] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 0, 0, 0, 0, 1, 0, 0), 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
@@ -190,7 +190,7 @@ const uint8_t __Char_N1[6] = {
 };
 
 // 0x32 - 50 - '2'
-const uint8_t __Char_N2[6] = {
+const uint8_t __Char_N2[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 0, 0, 0, 0, 1, 0, 0), 
 	Bits2Bytes(1, 1, 0, 0, 0, 0, 1, 0), 
@@ -200,7 +200,7 @@ const uint8_t __Char_N2[6] = {
 };
 
 // 0x33 - 51 - '3'
-const uint8_t __Char_N3[6] = {
+const uint8_t __Char_N3[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 0, 0, 0, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
@@ -210,7 +210,7 @@ const uint8_t __Char_N3[6] = {
 };
 
 // 0x34 - 52 - '4'
-const uint8_t __Char_N4[6] = {
+const uint8_t __Char_N4[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 1, 1, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
@@ -220,7 +220,7 @@ const uint8_t __Char_N4[6] = {
 };
 
 // 0x35 - 53 - '5'
-const uint8_t __Char_N5[6] = {
+const uint8_t __Char_N5[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 0, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 0, 1, 0, 1, 0), 
@@ -230,7 +230,7 @@ const uint8_t __Char_N5[6] = {
 };
 
 // 0x36 - 54 - '6'
-const uint8_t __Char_N6[6] = {
+const uint8_t __Char_N6[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 1, 0), 
@@ -240,7 +240,7 @@ const uint8_t __Char_N6[6] = {
 };
 
 // 0x37 - 55 - '7'
-const uint8_t __Char_N7[6] = {
+const uint8_t __Char_N7[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 1, 0), 
@@ -250,7 +250,7 @@ const uint8_t __Char_N7[6] = {
 };
 
 // 0x38 - 56 - '8'
-const uint8_t __Char_N8[6] = {
+const uint8_t __Char_N8[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 1, 0, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 1, 0), 
@@ -260,7 +260,7 @@ const uint8_t __Char_N8[6] = {
 };
 
 // 0x39 - 57 - '9'
-const uint8_t __Char_N9[6] = {
+const uint8_t __Char_N9[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 0, 0, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 1, 0), 
@@ -270,19 +270,19 @@ const uint8_t __Char_N9[6] = {
 };
 
 // 0x3A - 58 - ':'
-const uint8_t __Char_58[2] = {
+const uint8_t __Char_58[2] PROGMEM = {
 	1, 
 	Bits2Bytes(0, 1, 0, 0, 0, 1, 0, 0)
 };
 
 // 0x3B - 59 - ';'
-const uint8_t __Char_59[2] = {
+const uint8_t __Char_59[2] PROGMEM = {
 	1, 
 	Bits2Bytes(1, 1, 0, 0, 0, 1, 0, 0)
 };
 
 // 0x3C - 60 - '<'
-const uint8_t __Char_60[5] = {
+const uint8_t __Char_60[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
@@ -291,7 +291,7 @@ const uint8_t __Char_60[5] = {
 };
 
 // 0x3D - 61 - '='
-const uint8_t __Char_61[5] = {
+const uint8_t __Char_61[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
@@ -300,7 +300,7 @@ const uint8_t __Char_61[5] = {
 };
 
 // 0x3E - 62 - '>'
-const uint8_t __Char_62[5] = {
+const uint8_t __Char_62[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(0, 1, 0, 0, 0, 1, 0, 0), 
@@ -309,7 +309,7 @@ const uint8_t __Char_62[5] = {
 };
 
 // 0x3F - 63 - '?'
-const uint8_t __Char_63[6] = {
+const uint8_t __Char_63[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 0, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 1, 0), 
@@ -319,7 +319,7 @@ const uint8_t __Char_63[6] = {
 };
 
 // 0x40 - 64 - '@'
-const uint8_t __Char_64[9] = {
+const uint8_t __Char_64[9] PROGMEM = {
 	8, 
 	Bits2Bytes(0, 0, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 1, 0, 0, 0, 1, 0, 0), 
@@ -332,7 +332,7 @@ const uint8_t __Char_64[9] = {
 };
 
 // 0x41 - 65 - 'A'
-const uint8_t __Char_UA[6] = {
+const uint8_t __Char_UA[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 1, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 1, 0, 0), 
@@ -342,7 +342,7 @@ const uint8_t __Char_UA[6] = {
 };
 
 // 0x42 - 66 - 'B'
-const uint8_t __Char_UB[5] = {
+const uint8_t __Char_UB[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 1, 0), 
@@ -351,7 +351,7 @@ const uint8_t __Char_UB[5] = {
 };
 
 // 0x43 - 67 - 'C'
-const uint8_t __Char_UC[5] = {
+const uint8_t __Char_UC[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
@@ -360,7 +360,7 @@ const uint8_t __Char_UC[5] = {
 };
 
 // 0x44 - 68 - 'D'
-const uint8_t __Char_UD[5] = {
+const uint8_t __Char_UD[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
@@ -369,7 +369,7 @@ const uint8_t __Char_UD[5] = {
 };
 
 // 0x45 - 69 - 'E'
-const uint8_t __Char_UE[5] = {
+const uint8_t __Char_UE[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 1, 0), 
@@ -378,7 +378,7 @@ const uint8_t __Char_UE[5] = {
 };
 
 // 0x46 - 70 - 'F'
-const uint8_t __Char_UF[5] = {
+const uint8_t __Char_UF[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 1, 0), 
@@ -387,7 +387,7 @@ const uint8_t __Char_UF[5] = {
 	};
 
 // 0x47 - 71 - 'G'
-const uint8_t __Char_UG[6] = {
+const uint8_t __Char_UG[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
@@ -397,7 +397,7 @@ const uint8_t __Char_UG[6] = {
 };
 
 // 0x48 - 72 - 'H'
-const uint8_t __Char_UH[5] = {
+const uint8_t __Char_UH[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
@@ -406,7 +406,7 @@ const uint8_t __Char_UH[5] = {
 };
 
 // 0x49 - 73 - 'I'
-const uint8_t __Char_UI[4] = {
+const uint8_t __Char_UI[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
@@ -414,7 +414,7 @@ const uint8_t __Char_UI[4] = {
 };
 
 // 0x4A - 74 - 'J'
-const uint8_t __Char_UJ[5] = {
+const uint8_t __Char_UJ[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 0, 0, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0), 
@@ -423,7 +423,7 @@ const uint8_t __Char_UJ[5] = {
 };
 
 // 0x4B - 75 - 'K'
-const uint8_t __Char_UK[6] = {
+const uint8_t __Char_UK[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
@@ -433,7 +433,7 @@ const uint8_t __Char_UK[6] = {
 };
 
 // 0x4C - 76 - 'L'
-const uint8_t __Char_UL[5] = {
+const uint8_t __Char_UL[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0), 
@@ -442,7 +442,7 @@ const uint8_t __Char_UL[5] = {
 };
 
 // 0x4D - 77 - 'M'
-const uint8_t __Char_UM[6] = {
+const uint8_t __Char_UM[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 0, 0), 
@@ -452,7 +452,7 @@ const uint8_t __Char_UM[6] = {
 };
 
 // 0x4E - 78 - 'N'
-const uint8_t __Char_UN[6] = {
+const uint8_t __Char_UN[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 0, 0), 
@@ -462,7 +462,7 @@ const uint8_t __Char_UN[6] = {
 };
 
 // 0x4F - 79 - 'O'
-const uint8_t __Char_UO[5] = {
+const uint8_t __Char_UO[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
@@ -471,7 +471,7 @@ const uint8_t __Char_UO[5] = {
 };
 
 // 0x50 - 80 - 'P'
-const uint8_t __Char_UP[5] = {
+const uint8_t __Char_UP[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 1, 0), 
@@ -480,7 +480,7 @@ const uint8_t __Char_UP[5] = {
 };
 
 // 0x51 - 81 - 'Q'
-const uint8_t __Char_UQ[6] = {
+const uint8_t __Char_UQ[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
@@ -490,7 +490,7 @@ const uint8_t __Char_UQ[6] = {
 };
 
 // 0x52 - 82 - 'R'
-const uint8_t __Char_UR[5] = {
+const uint8_t __Char_UR[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 1, 0), 
@@ -499,7 +499,7 @@ const uint8_t __Char_UR[5] = {
 };
 
 // 0x53 - 83 - 'S'
-const uint8_t __Char_US[5] = {
+const uint8_t __Char_US[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 0, 0, 1, 1, 0, 0), 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 1, 0), 
@@ -508,7 +508,7 @@ const uint8_t __Char_US[5] = {
 };
 
 // 0x54 - 84 - 'T'
-const uint8_t __Char_UT[6] = {
+const uint8_t __Char_UT[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 1, 0), 
@@ -518,7 +518,7 @@ const uint8_t __Char_UT[6] = {
 };
 
 // 0x55 - 85 - 'U'
-const uint8_t __Char_UU[5] = {
+const uint8_t __Char_UU[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0), 
@@ -527,7 +527,7 @@ const uint8_t __Char_UU[5] = {
 };
 
 // 0x56 - 86 - 'V'
-const uint8_t __Char_UV[6] = {
+const uint8_t __Char_UV[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 0, 0, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 1, 1, 0, 0, 0, 0), 
@@ -537,7 +537,7 @@ const uint8_t __Char_UV[6] = {
 };
 
 // 0x57 - 87 - 'W'
-const uint8_t __Char_UW[6] = {
+const uint8_t __Char_UW[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 1, 0, 0, 0, 0, 0, 0), 
@@ -547,7 +547,7 @@ const uint8_t __Char_UW[6] = {
 };
 
 // 0x58 - 88 - 'X'
-const uint8_t __Char_UX[6] = {
+const uint8_t __Char_UX[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 1, 0, 0, 0, 1, 1, 0), 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
@@ -557,7 +557,7 @@ const uint8_t __Char_UX[6] = {
 };
 
 // 0x59 - 89 - 'Y'
-const uint8_t __Char_UY[6] = {
+const uint8_t __Char_UY[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 0, 1, 0, 0, 0), 
@@ -567,7 +567,7 @@ const uint8_t __Char_UY[6] = {
 };
 
 // 0x5A - 90 - 'Z'
-const uint8_t __Char_UZ[6] = {
+const uint8_t __Char_UZ[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 1, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(1, 0, 1, 0, 0, 0, 1, 0), 
@@ -577,7 +577,7 @@ const uint8_t __Char_UZ[6] = {
 };
 
 // 0x5B - 91 - '['
-const uint8_t __Char_91[4] = {
+const uint8_t __Char_91[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
@@ -585,7 +585,7 @@ const uint8_t __Char_91[4] = {
 };
 
 // 0x5C - 92 - '\'
-const uint8_t __Char_92[4] = {
+const uint8_t __Char_92[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 1, 0), 
 	Bits2Bytes(0, 0, 1, 1, 1, 0, 0, 0), 
@@ -593,13 +593,13 @@ const uint8_t __Char_92[4] = {
 };
 
 // 0x5D - 93 - ']'
-const uint8_t __Char_93[4] = {3, 
+const uint8_t __Char_93[4] PROGMEM = {3, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0)};
 
 // 0x5E - 94 - '^'
-const uint8_t __Char_94[4] = {
+const uint8_t __Char_94[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 0, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 1, 0), 
@@ -607,7 +607,7 @@ const uint8_t __Char_94[4] = {
 };
 
 // 0x5F - 95 - '_'
-const uint8_t __Char_95[4] = {
+const uint8_t __Char_95[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0), 
@@ -615,14 +615,14 @@ const uint8_t __Char_95[4] = {
 };
 
 // 0x60 - 96 - '`'
-const uint8_t __Char_96[3] = {
+const uint8_t __Char_96[3] PROGMEM = {
 	2, 
 	Bits2Bytes(0, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(0, 0, 0, 0, 0, 1, 0, 0)
 };
 
 // 0x61 - 97 - 'a'
-const uint8_t __Char_la[5] = {
+const uint8_t __Char_la[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 1, 0, 0, 0), 
@@ -631,7 +631,7 @@ const uint8_t __Char_la[5] = {
 };
 
 // 0x62 - 98 - 'b'
-const uint8_t __Char_lb[5] = {
+const uint8_t __Char_lb[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(1, 0, 0, 0, 1, 0, 0, 0), 
@@ -640,7 +640,7 @@ const uint8_t __Char_lb[5] = {
 };
 
 // 0x63 - 99 - 'c'
-const uint8_t __Char_lc[5] = {
+const uint8_t __Char_lc[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 1, 0, 0, 0), 
@@ -649,7 +649,7 @@ const uint8_t __Char_lc[5] = {
 };
 
 // 0x64 - 100 - 'd'
-const uint8_t __Char_ld[5] = {
+const uint8_t __Char_ld[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 1, 0, 0, 0), 
@@ -658,7 +658,7 @@ const uint8_t __Char_ld[5] = {
 };
 
 // 0x65 - 101 - 'e'
-const uint8_t __Char_le[5] = {
+const uint8_t __Char_le[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 1, 0, 1, 0, 0, 0), 
@@ -667,7 +667,7 @@ const uint8_t __Char_le[5] = {
 };
 
 // 0x66 - 102 - 'f'
-const uint8_t __Char_lf[4] = {
+const uint8_t __Char_lf[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 0, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 1, 0), 
@@ -675,7 +675,7 @@ const uint8_t __Char_lf[4] = {
 };
 
 // 0x67 - 103 - 'g'
-const uint8_t __Char_lg[5] = {
+const uint8_t __Char_lg[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 1, 0, 1, 0, 0, 0), 
@@ -684,7 +684,7 @@ const uint8_t __Char_lg[5] = {
 };
 
 // 0x68 - 104 - 'h'
-const uint8_t __Char_lh[5] = {
+const uint8_t __Char_lh[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
@@ -693,20 +693,20 @@ const uint8_t __Char_lh[5] = {
 };
 
 // 0x69 - 105 - 'i'
-const uint8_t __Char_li[2] = {
+const uint8_t __Char_li[2] PROGMEM = {
 	1, 
 	Bits2Bytes(1, 1, 1, 1, 1, 0, 1, 0)
 };
 
 // 0x6A - 106 - 'j'
-const uint8_t __Char_lj[3] = {
+const uint8_t __Char_lj[3] PROGMEM = {
 	2, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0), 
 	Bits2Bytes(0, 1, 1, 1, 1, 0, 1, 0)
 };
 
 // 0x6B - 107 - 'k'
-const uint8_t __Char_lk[5] = {
+const uint8_t __Char_lk[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0), 
 	Bits2Bytes(0, 0, 1, 0, 0, 0, 0, 0), 
@@ -715,13 +715,13 @@ const uint8_t __Char_lk[5] = {
 };
 
 // 0x6C - 108 - 'l'
-const uint8_t __Char_ll[2] = {
+const uint8_t __Char_ll[2] PROGMEM = {
 	1, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0)
 };
 
 // 0x6D - 109 - 'm'
-const uint8_t __Char_lm[6] = {
+const uint8_t __Char_lm[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 1, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 0, 1, 0, 0, 0), 
@@ -731,7 +731,7 @@ const uint8_t __Char_lm[6] = {
 };
 
 // 0x6E - 110 - 'n'
-const uint8_t __Char_ln[5] = {
+const uint8_t __Char_ln[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
@@ -740,7 +740,7 @@ const uint8_t __Char_ln[5] = {
 };
 
 // 0x6F - 111 - 'o'
-const uint8_t __Char_lo[5] = {
+const uint8_t __Char_lo[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 1, 0, 0, 0), 
@@ -749,7 +749,7 @@ const uint8_t __Char_lo[5] = {
 };
 
 // 0x70 - 112 - 'p'
-const uint8_t __Char_lp[5] = {
+const uint8_t __Char_lp[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 1, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
@@ -758,7 +758,7 @@ const uint8_t __Char_lp[5] = {
 };
 
 // 0x71 - 113 - 'q'
-const uint8_t __Char_lq[5] = {
+const uint8_t __Char_lq[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 1, 0, 1, 0, 0, 0), 
@@ -767,7 +767,7 @@ const uint8_t __Char_lq[5] = {
 };
 
 // 0x72 - 114 - 'r'
-const uint8_t __Char_lr[4] = {
+const uint8_t __Char_lr[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 1, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
@@ -775,7 +775,7 @@ const uint8_t __Char_lr[4] = {
 };
 
 // 0x73 - 115 - 's'
-const uint8_t __Char_ls[5] = {
+const uint8_t __Char_ls[5] PROGMEM = {
 	4, 
 	Bits2Bytes(1, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(1, 0, 1, 0, 1, 0, 0, 0), 
@@ -784,7 +784,7 @@ const uint8_t __Char_ls[5] = {
 };
 
 // 0x74 - 116 - 't'
-const uint8_t __Char_lt[4] = {
+const uint8_t __Char_lt[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 0, 0, 1, 0, 0, 0), 
 	Bits2Bytes(0, 1, 1, 1, 1, 1, 0, 0), 
@@ -792,7 +792,7 @@ const uint8_t __Char_lt[4] = {
 };
 
 // 0x75 - 117 - 'u'
-const uint8_t __Char_lu[5] = {
+const uint8_t __Char_lu[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 1, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 0, 0), 
@@ -801,7 +801,7 @@ const uint8_t __Char_lu[5] = {
 };
 
 // 0x76 - 118 - 'v'
-const uint8_t __Char_lv[6] = {
+const uint8_t __Char_lv[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 0, 1, 1, 0, 0, 0), 
 	Bits2Bytes(0, 1, 1, 0, 0, 0, 0, 0), 
@@ -811,7 +811,7 @@ const uint8_t __Char_lv[6] = {
 };
 
 // 0x77 - 119 - 'w'
-const uint8_t __Char_lw[6] = {
+const uint8_t __Char_lw[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 1, 1, 1, 0, 0, 0), 
 	Bits2Bytes(1, 1, 0, 0, 0, 0, 0, 0), 
@@ -821,7 +821,7 @@ const uint8_t __Char_lw[6] = {
 };
 
 // 0x78 - 120 - 'x'
-const uint8_t __Char_lx[6] = {
+const uint8_t __Char_lx[6] PROGMEM = {
 	5, 
 	Bits2Bytes(1, 0, 0, 0, 1, 0, 0, 0), 
 	Bits2Bytes(0, 1, 0, 1, 0, 0, 0, 0), 
@@ -831,7 +831,7 @@ const uint8_t __Char_lx[6] = {
 };
 
 // 0x79 - 121 - 'y'
-const uint8_t __Char_ly[5] = {
+const uint8_t __Char_ly[5] PROGMEM = {
 	4, 
 	Bits2Bytes(0, 0, 0, 1, 1, 0, 0, 0), 
 	Bits2Bytes(1, 0, 1, 0, 0, 0, 0, 0), 
@@ -840,7 +840,7 @@ const uint8_t __Char_ly[5] = {
 };
 
 // 0x7A - 122 - 'z'
-const uint8_t __Char_lz[4] = {
+const uint8_t __Char_lz[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 1, 0, 0, 1, 0, 0, 0), 
 	Bits2Bytes(1, 0, 1, 0, 1, 0, 0, 0), 
@@ -848,7 +848,7 @@ const uint8_t __Char_lz[4] = {
 };
 
 // 0x7B - 123 - '{'
-const uint8_t __Char_123[4] = {
+const uint8_t __Char_123[4] PROGMEM = {
 	3, 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(0, 1, 1, 0, 1, 1, 0, 0), 
@@ -856,13 +856,13 @@ const uint8_t __Char_123[4] = {
 };
 
 // 0x7C - 124 - '|'
-const uint8_t __Char_124[2] = {
+const uint8_t __Char_124[2] PROGMEM = {
 	1, 
 	Bits2Bytes(1, 1, 1, 1, 1, 1, 1, 0)
 };
 
 // 0x7D - 125 - '}'
-const uint8_t __Char_125[4] = {
+const uint8_t __Char_125[4] PROGMEM = {
 	3, 
 	Bits2Bytes(1, 0, 0, 0, 0, 0, 1, 0), 
 	Bits2Bytes(0, 1, 1, 0, 1, 1, 0, 0), 
@@ -870,7 +870,7 @@ const uint8_t __Char_125[4] = {
 };
 
 // 0x7E - 126 - '~'
-const uint8_t __Char_126[6] = {
+const uint8_t __Char_126[6] PROGMEM = {
 	5, 
 	Bits2Bytes(0, 0, 0, 1, 0, 0, 0, 0), 
 	Bits2Bytes(0, 0, 0, 0, 1, 0, 0, 0), 
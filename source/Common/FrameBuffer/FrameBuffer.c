@@ -36,18 +36,27 @@ static uint8_t __Width;
 static uint8_t __Height;
 static uint8_t __Pages;
 static uint8_t* __Buffer;
+static FrameBuffer_Dirty_t* __Dirty;
 
-void FrameBuffer_Init(const uint8_t Width, const uint8_t Height, const uint8_t Pages, uint8_t* Buffer)
+void FrameBuffer_Init(const uint8_t Width, const uint8_t Height, const uint8_t Pages, uint8_t* Buffer, FrameBuffer_Dirty_t* Dirty)
 {
 	__Width = Width;
 	__Height = Height;
 	__Pages = Pages;
 	__Buffer = Buffer;
+	__Dirty = Dirty;
+
+	for(uint8_t Page = 0x00; Page < __Pages; Page++)
+	{
+		FrameBuffer_ClearDirty(Page);
+	}
 }
 
 void FrameBuffer_WriteByte(const uint8_t Page, const uint8_t Column, const uint8_t Data)
 {
 	*(__Buffer + (Page * __Width) + Column) = Data;
+
+	FrameBuffer_MarkDirty(Page, Column, Column);
 }
 
 uint8_t FrameBuffer_ReadByte(const uint8_t Page, const uint8_t Column)
@@ -58,19 +67,81 @@ uint8_t FrameBuffer_ReadByte(const uint8_t Page, const uint8_t Column)
 void FrameBuffer_WritePage(const uint8_t Page, const uint8_t Column, const uint8_t Length, const uint8_t* Data)
 {
 	uint8_t* Start = __Buffer + ((Page * __Width) + Column);
-	
-	while(*Data)
+
+	for(uint8_t i = 0x00; i < Length; i++)
 	{
 		*Start++ = *Data++;
 	}
+
+	if(Length > 0x00)
+	{
+		FrameBuffer_MarkDirty(Page, Column, Column + Length - 0x01);
+	}
 }
 
 void FrameBuffer_ReadPage(const uint8_t Page, const uint8_t Column, const uint8_t Length, uint8_t* Data)
 {
 	uint8_t* Start = __Buffer + ((Page * __Width) + Column);
-	
-	while(*Data)
+
+	for(uint8_t i = 0x00; i < Length; i++)
 	{
 		*Data++ = *Start++;
 	}
+}
+
+uint8_t* FrameBuffer_GetPointer(const uint8_t Page, const uint8_t Column)
+{
+	return __Buffer + (Page * __Width) + Column;
+}
+
+void FrameBuffer_MarkDirty(const uint8_t Page, const uint8_t Start, const uint8_t End)
+{
+	if(__Dirty == NULL)
+	{
+		return;
+	}
+
+	FrameBuffer_Dirty_t* Dirty = __Dirty + Page;
+
+	if(Start < Dirty->Start)
+	{
+		Dirty->Start = Start;
+	}
+
+	if(End > Dirty->End)
+	{
+		Dirty->End = End;
+	}
+}
+
+bool FrameBuffer_GetDirty(const uint8_t Page, uint8_t* Start, uint8_t* End)
+{
+	if(__Dirty == NULL)
+	{
+		return false;
+	}
+
+	FrameBuffer_Dirty_t* Dirty = __Dirty + Page;
+
+	if(Dirty->Start > Dirty->End)
+	{
+		return false;
+	}
+
+	*Start = Dirty->Start;
+	*End = Dirty->End;
+
+	return true;
+}
+
+void FrameBuffer_ClearDirty(const uint8_t Page)
+{
+	if(__Dirty == NULL)
+	{
+		return;
+	}
+
+	// An empty range is marked with a start column behind the end column
+	(__Dirty + Page)->Start = 0xFF;
+	(__Dirty + Page)->End = 0x00;
 }
\ No newline at end of file
@@ -30,6 +30,8 @@
  *  @author Daniel Kampert
  */
 
+#include <string.h>
+
 #include "Peripheral/MCP2515/MCP2515.h"
 
 /** @defgroup MCP2515
@@ -44,6 +46,7 @@
 		#define MCP2515_CMD_BITMODIFY			0x05
 		#define MCP2515_CMD_RTS(Buffer)			(0x80 | Buffer)
 		#define MCP2515_CMD_READ_RX(Buffer)		(0x90 | (Buffer << 0x02))
+		#define MCP2515_CMD_LOAD_TX(Buffer)		(0x40 | (Buffer << 0x01))
 		#define MCP2515_CMD_READ_STATUS			0xA0
 		#define MCP2515_CMD_READ_RX_STATUS		0xB0
 		#define MCP2515_CMD_RESET				0xC0
@@ -251,8 +254,11 @@
 		#define MCP2515_RXM0					0x05
 		#define MCP2515_MLOA					0x05
 		#define MCP2515_ABAT					0x04
+		#define MCP2515_SRR						0x04
 		#define MCP2515_TXERR					0x04
 		#define MCP2515_OSM						0x03
+		#define MCP2515_IDE						0x03
+		#define MCP2515_EXIDE					0x03
 		#define MCP2515_TXREQ					0x03
 		#define MCP2515_BUKT					0x02
 		#define MCP2515_B2RTSM					0x02
@@ -263,22 +269,28 @@
 	/** @} */ // end of MCP2515-Control-Flags
 /** @} */ // end of MCP2515
 
+#if(defined MCP2515_USE_STATISTICS)
+	#define MCP2515_COUNT(Counter)								(__MCP2515_Statistics.Counter++)
+#else
+	#define MCP2515_COUNT(Counter)								((void)0)
+#endif
+
 #if(MCU_ARCH == MCU_ARCH_AVR8)
 	#define MCP2515_SPI_INIT(Config)							SPIM_Init(Config)
-	#define MCP2515_SPI_TRANSMIT(Command)						SPIM_SendData(Command)
-	#define MCP2515_SPI_CHIP_SELECT()							SPIM_SelectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS))
+	#define MCP2515_SPI_TRANSMIT(Command)						(MCP2515_COUNT(SPIBytes), SPIM_SendData(Command))
+	#define MCP2515_SPI_CHIP_SELECT()							(MCP2515_COUNT(SPITransactions), SPIM_SelectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS)))
 	#define MCP2515_SPI_CHIP_DESELECT()							SPIM_DeselectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS))
 #elif(MCU_ARCH == MCU_ARCH_XMEGA)
 	#if(MCP2515_INTERFACE_TYPE == INTERFACE_USART_SPI)
 		#define MCP2515_SPI_INIT(Config)						USART_SPI_Init(Config)
-		#define MCP2515_SPI_TRANSMIT(Command)					USART_SPI_SendData(&MCP2515_INTERFACE, Command)
-		#define MCP2515_SPI_CHIP_SELECT()						USART_SPI_SelectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS))
+		#define MCP2515_SPI_TRANSMIT(Command)					(MCP2515_COUNT(SPIBytes), USART_SPI_SendData(&MCP2515_INTERFACE, Command))
+		#define MCP2515_SPI_CHIP_SELECT()						(MCP2515_COUNT(SPITransactions), USART_SPI_SelectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS)))
 		#define MCP2515_SPI_CHIP_DESELECT()						USART_SPI_DeselectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS))
 
 	 #elif(MCP2515_INTERFACE_TYPE == INTERFACE_SPI) 
 		#define MCP2515_SPI_INIT(Config)						SPIM_Init(Config)
-		#define MCP2515_SPI_TRANSMIT(Command)					SPIM_SendData(&MCP2515_INTERFACE, Command)
-		#define MCP2515_SPI_CHIP_SELECT()						SPIM_SelectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS))
+		#define MCP2515_SPI_TRANSMIT(Command)					(MCP2515_COUNT(SPIBytes), SPIM_SendData(&MCP2515_INTERFACE, Command))
+		#define MCP2515_SPI_CHIP_SELECT()						(MCP2515_COUNT(SPITransactions), SPIM_SelectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS)))
 		#define MCP2515_SPI_CHIP_DESELECT()						SPIM_DeselectDevice(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS))
 	 #else
 		 #error "Interface not supported for MCP2515!"
@@ -301,6 +313,52 @@
 
 static uint8_t __TxBufferFull = 0x00;
 
+#if(defined MCP2515_USE_STATISTICS)
+	static MCP2515_Statistics_t __MCP2515_Statistics;
+#endif
+
+/*
+ *	Filter group for the filter planner. All identifiers with (ID & Care) == Value are accepted.
+*/
+typedef struct
+{
+	uint32_t Value;
+	uint32_t Care;
+} MCP2515_FilterGroup_t;
+
+#if(defined MCP2515_USE_TX_QUEUE)
+	/*
+	 *	Transmit queue. The entries are stored in a pool and linked into one list for each priority.
+	*/
+	#define MCP2515_TX_QUEUE_NONE								0xFF
+
+	static struct
+	{
+		MCP2515_Frame_t Frame;
+		uint8_t Next;
+	} __TxQueue[MCP2515_TX_QUEUE_SIZE];
+
+	static uint8_t __TxQueueFree;
+	static uint8_t __TxQueueHead[MCP2515_PRIO_HIGHEST + 0x01];
+	static uint8_t __TxQueueTail[MCP2515_PRIO_HIGHEST + 0x01];
+
+	/*
+	 *	Transmit buffers used by the queue and the priority of the loaded messages
+	*/
+	static volatile uint8_t __TxQueueBusy;
+	static MCP2515_MessagePriority_t __TxQueuePriority[0x03];
+#endif
+
+#if(defined MCP2515_USE_RX_FIFO)
+	/*
+	 *	Receive FIFO. The interrupt handler only writes the head and the application only writes the tail.
+	*/
+	static MCP2515_Frame_t __RxFIFO[MCP2515_RX_FIFO_SIZE];
+	static volatile uint8_t __RxHead;
+	static volatile uint8_t __RxTail;
+	static MCP2515_RxStatistics_t __RxStatistics;
+#endif
+
 /** @brief			Send a bit modify to the CAN controller.
  *  @param Address	Register address
  *  @param Mask		Register mask
@@ -370,6 +428,247 @@ static uint8_t MCP2515_ReadRxStatus(void)
 	return Data;
 }
 
+#if(defined MCP2515_USE_RX_FIFO)
+	/** @brief			Copy a receive buffer into the receive FIFO.
+	 *					NOTE: The READ RX BUFFER instruction clears the receive interrupt flag when the chip select is released.
+	 *  @param Buffer	Receive buffer
+	 */
+	static void MCP2515_DrainRxBuffer(const MCP2515_ReceiveBuffer_t Buffer)
+	{
+		uint8_t Head = __RxHead;
+		uint8_t Next = (Head + 0x01) & (MCP2515_RX_FIFO_SIZE - 0x01);
+		MCP2515_Frame_t* Frame = &__RxFIFO[Head];
+
+		MCP2515_SPI_CHIP_SELECT();
+		MCP2515_SPI_TRANSMIT(MCP2515_CMD_READ_RX(Buffer));
+
+		uint8_t SIDH = MCP2515_SPI_TRANSMIT(0xFF);
+		uint8_t SIDL = MCP2515_SPI_TRANSMIT(0xFF);
+		uint8_t EID8 = MCP2515_SPI_TRANSMIT(0xFF);
+		uint8_t EID0 = MCP2515_SPI_TRANSMIT(0xFF);
+		uint8_t DLC = MCP2515_SPI_TRANSMIT(0xFF);
+
+		uint8_t Length = DLC & 0x0F;
+		if(Length > MCP2515_MAX_DATABYTES)
+		{
+			Length = MCP2515_MAX_DATABYTES;
+		}
+
+		// Release the receive buffer when the FIFO is full
+		if(Next == __RxTail)
+		{
+			MCP2515_SPI_CHIP_DESELECT();
+
+			__RxStatistics.SoftwareOverflows++;
+
+			return;
+		}
+
+		for(uint8_t i = 0x00; i < Length; i++)
+		{
+			Frame->Data[i] = MCP2515_SPI_TRANSMIT(0xFF);
+		}
+
+		MCP2515_SPI_CHIP_DESELECT();
+
+		Frame->Length = Length;
+		Frame->ID = ((uint16_t)SIDH << 0x03) | (SIDL >> 0x05);
+
+		if(SIDL & (0x01 << MCP2515_IDE))
+		{
+			Frame->ID = (Frame->ID << 0x12) | ((uint32_t)(SIDL & 0x03) << 0x10) | ((uint16_t)EID8 << 0x08) | EID0;
+			Frame->Type = (DLC & (0x01 << MCP2515_RTR)) ? MCP2515_EXTENDED_REMOTE : MCP2515_EXTENDED_DATA;
+		}
+		else
+		{
+			Frame->Type = (SIDL & (0x01 << MCP2515_SRR)) ? MCP2515_STANDARD_REMOTE : MCP2515_STANDARD_DATA;
+		}
+
+		__RxStatistics.Frames++;
+		__RxHead = Next;
+	}
+#endif
+
+/** @brief	Read the status of the transmit and receive buffers.
+ *  @return	Status
+ */
+static uint8_t MCP2515_ReadStatus(void)
+{
+	uint8_t Data = 0x00;
+
+	MCP2515_SPI_CHIP_SELECT();
+
+	MCP2515_SPI_TRANSMIT(MCP2515_CMD_READ_STATUS);
+	Data = MCP2515_SPI_TRANSMIT(0xFF);
+
+	MCP2515_SPI_CHIP_DESELECT();
+
+	return Data;
+}
+
+/** @brief				Write multiple registers with a single WRITE instruction.
+ *  @param Address		Address of the first register
+ *  @param Data			Pointer to register data
+ *  @param Length		Number of registers
+ */
+static void MCP2515_WriteRegisters(const uint8_t Address, const uint8_t* Data, const uint8_t Length)
+{
+	MCP2515_SPI_CHIP_SELECT();
+
+	MCP2515_SPI_TRANSMIT(MCP2515_CMD_WRITE);
+	MCP2515_SPI_TRANSMIT(Address);
+
+	for(uint8_t i = 0x00; i < Length; i++)
+	{
+		MCP2515_SPI_TRANSMIT(*Data++);
+	}
+
+	MCP2515_SPI_CHIP_DESELECT();
+}
+
+/** @brief				Convert an identifier into the register layout (SIDH, SIDL, EID8, EID0) of the CAN controller.
+ *  @param ID			Standard or extended identifier
+ *  @param Extended		#true for an extended identifier
+ *  @param Data			Pointer to register data
+ */
+static void MCP2515_EncodeIdentifier(const uint32_t ID, const bool Extended, uint8_t* Data)
+{
+	if(Extended)
+	{
+		Data[0] = ID >> 0x15;
+		Data[1] = ((ID >> 0x0D) & 0xE0) | (0x01 << MCP2515_EXIDE) | ((ID >> 0x10) & 0x03);
+		Data[2] = ID >> 0x08;
+		Data[3] = ID;
+	}
+	else
+	{
+		Data[0] = ID >> 0x03;
+		Data[1] = (ID & 0x07) << 0x05;
+		Data[2] = 0x00;
+		Data[3] = 0x00;
+	}
+}
+
+/** @brief			Load a message into a transmit buffer with a single LOAD TX BUFFER instruction.
+ *  @param Index	Transmit buffer index (0 - 2)
+ *  @param Type		Message type
+ *  @param ID		Message ID
+ *  @param Length	Message length
+ *  @param Data		Pointer to message data
+ */
+static void MCP2515_LoadTxBuffer(const uint8_t Index, const MCP2515_MessageType_t Type, const uint32_t ID, uint8_t Length, const uint8_t* Data)
+{
+	uint8_t Identifier[0x04];
+
+	if(Length > MCP2515_MAX_DATABYTES)
+	{
+		Length = MCP2515_MAX_DATABYTES;
+	}
+
+	MCP2515_EncodeIdentifier(ID, (Type == MCP2515_EXTENDED_DATA) || (Type == MCP2515_EXTENDED_REMOTE), Identifier);
+
+	MCP2515_SPI_CHIP_SELECT();
+
+	MCP2515_SPI_TRANSMIT(MCP2515_CMD_LOAD_TX(Index));
+	for(uint8_t i = 0x00; i < 0x04; i++)
+	{
+		MCP2515_SPI_TRANSMIT(Identifier[i]);
+	}
+
+	// Remote frames don't contain data
+	if((Type == MCP2515_STANDARD_REMOTE) || (Type == MCP2515_EXTENDED_REMOTE))
+	{
+		MCP2515_SPI_TRANSMIT((0x01 << MCP2515_RTR) | Length);
+	}
+	else
+	{
+		MCP2515_SPI_TRANSMIT(Length);
+
+		for(uint8_t i = 0x00; i < Length; i++)
+		{
+			MCP2515_SPI_TRANSMIT(*Data++);
+		}
+	}
+
+	MCP2515_SPI_CHIP_DESELECT();
+}
+
+/** @brief		Check if the message ID is valid for the message type.
+ *  @param Type	Message type
+ *  @param ID	Message ID
+ *  @return		#true if the ID is valid
+ */
+static bool MCP2515_CheckIdentifier(const MCP2515_MessageType_t Type, const uint32_t ID)
+{
+	if((Type == MCP2515_EXTENDED_DATA) || (Type == MCP2515_EXTENDED_REMOTE))
+	{
+		return ID <= 0x1FFFFFFF;
+	}
+
+	return ID <= 0x7FF;
+}
+
+#if(defined MCP2515_USE_TX_QUEUE)
+	/** @brief	Load the queued messages into the free transmit buffers.
+	 *			NOTE: The CAN controller transmits the buffer with the highest index first when two buffers have the same
+	 *			priority. A message is only loaded into a buffer below all pending buffers with the same priority to keep
+	 *			the order of the messages.
+	 *			Buffers claimed by #MCP2515_PrepareMessage are used too.
+	 */
+	static void MCP2515_RefillTx(void)
+	{
+		for(int8_t Priority = MCP2515_PRIO_HIGHEST; Priority >= MCP2515_PRIO_LOWEST; Priority--)
+		{
+			while(__TxQueueHead[Priority] != MCP2515_TX_QUEUE_NONE)
+			{
+				uint8_t Used = __TxQueueBusy | __TxBufferFull;
+
+				// Get the lowest pending buffer with the same priority
+				int8_t Index = 0x03;
+				for(uint8_t i = 0x00; i < 0x03; i++)
+				{
+					if((Used & (0x01 << i)) && (__TxQueuePriority[i] == (MCP2515_MessagePriority_t)Priority))
+					{
+						Index = i;
+						break;
+					}
+				}
+
+				// Get the highest free buffer below
+				while((--Index >= 0x00) && (Used & (0x01 << Index)));
+
+				if(Index < 0x00)
+				{
+					break;
+				}
+
+				uint8_t Entry = __TxQueueHead[Priority];
+				MCP2515_Frame_t* Frame = &__TxQueue[Entry].Frame;
+
+				MCP2515_LoadTxBuffer(Index, Frame->Type, Frame->ID, Frame->Length, Frame->Data);
+				MCP2515_BitModify(MCP2515_REGISTER_TXB0CTRL + (Index << 0x04), 0x03, Priority);
+
+				MCP2515_SPI_CHIP_SELECT();
+				MCP2515_SPI_TRANSMIT(MCP2515_CMD_RTS(0x01 << Index));
+				MCP2515_SPI_CHIP_DESELECT();
+
+				__TxQueueBusy |= (0x01 << Index);
+				__TxQueuePriority[Index] = Priority;
+
+				// Move the entry back to the free list
+				__TxQueueHead[Priority] = __TxQueue[Entry].Next;
+				if(__TxQueueHead[Priority] == MCP2515_TX_QUEUE_NONE)
+				{
+					__TxQueueTail[Priority] = MCP2515_TX_QUEUE_NONE;
+				}
+
+				__TxQueue[Entry].Next = __TxQueueFree;
+				__TxQueueFree = Entry;
+			}
+		}
+	}
+#endif
+
 /** @brief	MCP2515 interrupt handler.
  */
 static inline void MCP2515_Interrupthandler(void)
@@ -377,6 +676,8 @@ static inline void MCP2515_Interrupthandler(void)
 	// Get all active interrupt flags
 	uint8_t Status = MCP2515_ReadRegister(MCP2515_REGISTER_CANINTF);
 
+	MCP2515_COUNT(Interrupts);
+
 	// Message error interrupt
 	if(Status & (0x01 << MCP2515_IF_MER))
 	{
@@ -402,7 +703,16 @@ static inline void MCP2515_Interrupthandler(void)
 		// Read the error flags
 		// ToDo: How to clear error flags in callback?
 		uint8_t ErrorFlags = MCP2515_ReadRegister(MCP2515_REGISTER_EFLG);
-		
+
+		#if(defined MCP2515_USE_RX_FIFO)
+			// Count and clear the receive buffer overflows
+			if(ErrorFlags & ((0x01 << MCP2515_RX1OVR) | (0x01 << MCP2515_RX0OVR)))
+			{
+				__RxStatistics.HardwareOverflows++;
+				MCP2515_BitModify(MCP2515_REGISTER_EFLG, (0x01 << MCP2515_RX1OVR) | (0x01 << MCP2515_RX0OVR), 0x00);
+			}
+		#endif
+
 		// Error callback
 		if(__MCP2515_Callbacks.ErrorCallback != NULL)
 		{
@@ -413,15 +723,54 @@ static inline void MCP2515_Interrupthandler(void)
 	// Transmit buffer n full interrupt
 	if((Status & (0x01 << MCP2515_IF_TX2)) || (Status & (0x01 << MCP2515_IF_TX1)) || (Status & (0x01 << MCP2515_IF_TX0)))
 	{
-		MCP2515_CLEAR_IF((0x01 << MCP2515_IF_TX2) | (0x01 << MCP2515_IF_TX1) | (0x01 << MCP2515_IF_TX0));
+		// Only clear the active flags, because a new flag can be set after reading the status
+		MCP2515_CLEAR_IF(Status & ((0x01 << MCP2515_IF_TX2) | (0x01 << MCP2515_IF_TX1) | (0x01 << MCP2515_IF_TX0)));
 
 		// Clear the transmit buffer full bits
 		__TxBufferFull &= ~((Status >> 0x02) & 0x07);
+
+		#if(defined MCP2515_USE_STATISTICS)
+			for(uint8_t i = MCP2515_IF_TX0; i <= MCP2515_IF_TX2; i++)
+			{
+				if(Status & (0x01 << i))
+				{
+					__MCP2515_Statistics.TxFrames++;
+				}
+			}
+		#endif
+
+		#if(defined MCP2515_USE_TX_QUEUE)
+			__TxQueueBusy &= ~((Status >> 0x02) & 0x07);
+			MCP2515_RefillTx();
+		#endif
+
+		if(__MCP2515_Callbacks.TxCallback != NULL)
+		{
+			__MCP2515_Callbacks.TxCallback();
+		}
 	}
 
 	// Receive buffer n full interrupt
 	if((Status & (0x01 << MCP2515_IF_RX1)) || (Status & (0x01 << MCP2515_IF_RX0)))
 	{
+		#if(defined MCP2515_USE_STATISTICS)
+			__MCP2515_Statistics.RxFrames += ((Status >> MCP2515_IF_RX0) & 0x01) + ((Status >> MCP2515_IF_RX1) & 0x01);
+		#endif
+
+		#if(defined MCP2515_USE_RX_FIFO)
+			// Drain both buffers with a single instruction for each buffer. RXB0 is read first, because it holds
+			// the older message when the rollover mode is enabled.
+			if(Status & (0x01 << MCP2515_IF_RX0))
+			{
+				MCP2515_DrainRxBuffer(MCP2515_RX0);
+			}
+
+			if(Status & (0x01 << MCP2515_IF_RX1))
+			{
+				MCP2515_DrainRxBuffer(MCP2515_RX1);
+			}
+		#endif
+
 		// General message callback for all messages
 		if(__MCP2515_Callbacks.RxCallback != NULL)
 		{
@@ -475,6 +824,20 @@ void MCP2515_Init(SPIM_Config_t* Config, const MCP2515_Config_t* DeviceConfig)
 {
 	__TxBufferFull = 0x00;
 
+	#if(defined MCP2515_USE_TX_QUEUE)
+		// Link all queue entries into the free list
+		for(uint8_t i = 0x00; i < MCP2515_TX_QUEUE_SIZE; i++)
+		{
+			__TxQueue[i].Next = i + 0x01;
+		}
+
+		__TxQueue[MCP2515_TX_QUEUE_SIZE - 0x01].Next = MCP2515_TX_QUEUE_NONE;
+		__TxQueueFree = 0x00;
+		__TxQueueBusy = 0x00;
+		memset(__TxQueueHead, MCP2515_TX_QUEUE_NONE, sizeof(__TxQueueHead));
+		memset(__TxQueueTail, MCP2515_TX_QUEUE_NONE, sizeof(__TxQueueTail));
+	#endif
+
 	// Initialize the CS Pin
 	GPIO_SetDirection(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS), GPIO_DIRECTION_OUT);
 	GPIO_Set(GET_PERIPHERAL(MCP2515_SS), GET_INDEX(MCP2515_SS));
@@ -586,7 +949,7 @@ void MCP2515_InstallCallback(const MCP2515_Config_t* Config)
 	{
 		if(Config->TxCallback != NULL)
 		{
-			__MCP2515_Callbacks.RxCallback = Config->TxCallback;
+			__MCP2515_Callbacks.TxCallback = Config->TxCallback;
 		}
 	}
 
@@ -647,6 +1010,110 @@ MCP2515_DeviceMode_t MCP2515_GetDeviceMode(void)
 	return ((MCP2515_ReadRegister(MCP2515_REGISTER_CANSTAT) & 0xE0) >> 0x05);
 }
 
+/** @brief			Get the number of identifiers covered by a filter group.
+ *  @param Care		Bits which have to match
+ *  @param Width	Identifier width
+ *  @return			Number of identifiers
+ */
+static uint32_t MCP2515_GroupSize(const uint32_t Care, const uint8_t Width)
+{
+	uint8_t DontCare = Width;
+
+	for(uint8_t i = 0x00; i < Width; i++)
+	{
+		if(Care & ((uint32_t)0x01 << i))
+		{
+			DontCare--;
+		}
+	}
+
+	return (uint32_t)0x01 << DontCare;
+}
+
+/** @brief			Merge the two filter groups which add the least number of unwanted identifiers.
+ *  @param Groups	Pointer to filter groups
+ *  @param Count	Number of filter groups
+ *  @param Width	Identifier width
+ *  @return			New number of filter groups
+ */
+static uint8_t MCP2515_MergeGroups(MCP2515_FilterGroup_t* Groups, uint8_t Count, const uint8_t Width)
+{
+	uint8_t A = 0x00;
+	uint8_t B = 0x01;
+	int32_t BestCost = INT32_MAX;
+
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		for(uint8_t j = i + 0x01; j < Count; j++)
+		{
+			uint32_t Care = Groups[i].Care & Groups[j].Care & ~(Groups[i].Value ^ Groups[j].Value);
+			int32_t Cost = MCP2515_GroupSize(Care, Width) - MCP2515_GroupSize(Groups[i].Care, Width) - MCP2515_GroupSize(Groups[j].Care, Width);
+
+			if(Cost < BestCost)
+			{
+				BestCost = Cost;
+				A = i;
+				B = j;
+			}
+		}
+	}
+
+	Groups[A].Care &= Groups[B].Care & ~(Groups[A].Value ^ Groups[B].Value);
+	Groups[A].Value &= Groups[A].Care;
+	Groups[B] = Groups[--Count];
+
+	return Count;
+}
+
+/** @brief			Get the number of identifiers accepted by a receive buffer.
+ *  @param Groups	Pointer to filter groups
+ *  @param Select	Bit mask with the filter groups used by the receive buffer
+ *  @param Count	Number of filter groups
+ *  @param Width	Identifier width
+ *  @param Mask		Pointer to resulting buffer mask
+ *  @return			Number of accepted identifiers
+ */
+static uint32_t MCP2515_BufferCoverage(const MCP2515_FilterGroup_t* Groups, const uint8_t Select, const uint8_t Count, const uint8_t Width, uint32_t* Mask)
+{
+	uint32_t Care = ((uint32_t)0x01 << Width) - 0x01;
+	uint8_t Filters = 0x00;
+
+	// All filters of a receive buffer share the mask
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		if(Select & (0x01 << i))
+		{
+			Care &= Groups[i].Care;
+		}
+	}
+
+	// Count the different filter values for this mask
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		if(Select & (0x01 << i))
+		{
+			bool Duplicate = false;
+			for(uint8_t j = 0x00; j < i; j++)
+			{
+				if((Select & (0x01 << j)) && ((Groups[i].Value & Care) == (Groups[j].Value & Care)))
+				{
+					Duplicate = true;
+					break;
+				}
+			}
+
+			if(!Duplicate)
+			{
+				Filters++;
+			}
+		}
+	}
+
+	*Mask = Care;
+
+	return Filters * MCP2515_GroupSize(Care, Width);
+}
+
 void MCP2515_SwitchFilter(const MCP2515_ReceiveBuffer_t Buffer, const MCP2515_FilterRule_t Filter)
 {
 	MCP2515_BitModify(MCP2515_REGISTER_RXB0CTRL + ((Buffer & 0x01) << 0x04), (0x01 << MCP2515_RXM1) | (0x01 << MCP2515_RXM0), Filter << MCP2515_RXM0);
@@ -730,6 +1197,219 @@ void MCP2515_ConfigFilter(const MCP2515_FilterConfig_t* Config)
 	MCP2515_SetDeviceMode(Mode);
 }
 
+MCP2515_ErrorCode_t MCP2515_PlanFilters(const MCP2515_IDRange_t* Ranges, const uint8_t Count, const bool UseExtended, MCP2515_FilterPlan_t* Plan)
+{
+	MCP2515_FilterGroup_t Groups[MCP2515_FILTER_GROUPS + 0x01];
+	uint8_t Width = UseExtended ? 29 : 11;
+	uint32_t MaxID = ((uint32_t)0x01 << Width) - 0x01;
+	uint8_t GroupCount = 0x00;
+
+	if((Count == 0x00) || (Ranges == NULL))
+	{
+		return MCP2515_INVALID_IDENTIFIER;
+	}
+
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		if((Ranges[i].Start > Ranges[i].End) || (Ranges[i].End > MaxID))
+		{
+			return MCP2515_INVALID_IDENTIFIER;
+		}
+	}
+
+	Plan->Wanted = 0x00;
+
+	// Visit the ranges sorted by the first identifier and merge overlapping and adjacent ranges, so each identifier
+	// is counted once. Split the merged ranges into aligned blocks and merge the blocks until they fit into the working buffer.
+	uint32_t From = 0x00;
+	while(1)
+	{
+		bool Found = false;
+		uint32_t Start = 0x00;
+		for(uint8_t i = 0x00; i < Count; i++)
+		{
+			uint32_t First = (Ranges[i].Start > From) ? Ranges[i].Start : From;
+
+			if((Ranges[i].End >= From) && (!Found || (First < Start)))
+			{
+				Start = First;
+				Found = true;
+			}
+		}
+
+		if(!Found)
+		{
+			break;
+		}
+
+		uint32_t End = Start;
+		bool Extended;
+		do
+		{
+			Extended = false;
+			for(uint8_t i = 0x00; i < Count; i++)
+			{
+				if((Ranges[i].Start <= (End + 0x01)) && (Ranges[i].End > End))
+				{
+					End = Ranges[i].End;
+					Extended = true;
+				}
+			}
+		} while(Extended);
+
+		Plan->Wanted += End - Start + 0x01;
+		From = End + 0x01;
+
+		while(1)
+		{
+			// Get the largest aligned block which starts at the current identifier
+			uint8_t Bits = 0x00;
+			while((Bits < Width) && !(Start & ((uint32_t)0x01 << Bits)) && ((Start + ((uint32_t)0x02 << Bits) - 0x01) <= End))
+			{
+				Bits++;
+			}
+
+			Groups[GroupCount].Value = Start;
+			Groups[GroupCount].Care = MaxID & ~(((uint32_t)0x01 << Bits) - 0x01);
+
+			if(++GroupCount > MCP2515_FILTER_GROUPS)
+			{
+				GroupCount = MCP2515_MergeGroups(Groups, GroupCount, Width);
+			}
+
+			uint32_t Last = Start + ((uint32_t)0x01 << Bits) - 0x01;
+			if(Last >= End)
+			{
+				break;
+			}
+
+			Start = Last + 0x01;
+		}
+
+		if(End == MaxID)
+		{
+			break;
+		}
+	}
+
+	// The CAN controller has six filters
+	while(GroupCount > 0x06)
+	{
+		GroupCount = MCP2515_MergeGroups(Groups, GroupCount, Width);
+	}
+
+	// Try all assignments with one or two groups for RXB0 and up to four groups for RXB1
+	uint8_t BestSelect = 0x00;
+	uint32_t Mask[2];
+	Plan->Accepted = UINT32_MAX;
+	for(uint8_t Select = 0x01; Select < (0x01 << GroupCount); Select++)
+	{
+		uint8_t Used = 0x00;
+		for(uint8_t i = 0x00; i < GroupCount; i++)
+		{
+			if(Select & (0x01 << i))
+			{
+				Used++;
+			}
+		}
+
+		if((Used > 0x02) || ((GroupCount - Used) > 0x04))
+		{
+			continue;
+		}
+
+		uint8_t Other = ((0x01 << GroupCount) - 0x01) & ~Select;
+		uint32_t Accepted = MCP2515_BufferCoverage(Groups, Select, GroupCount, Width, &Mask[0]);
+		if(Other)
+		{
+			Accepted += MCP2515_BufferCoverage(Groups, Other, GroupCount, Width, &Mask[1]);
+		}
+
+		if(Accepted < Plan->Accepted)
+		{
+			Plan->Accepted = Accepted;
+			BestSelect = Select;
+		}
+	}
+
+	// Get the filter values for the best assignment. Unused filters repeat the first filter of the buffer.
+	uint8_t Other = ((0x01 << GroupCount) - 0x01) & ~BestSelect;
+	MCP2515_BufferCoverage(Groups, BestSelect, GroupCount, Width, &Plan->Mask[0]);
+	if(Other)
+	{
+		MCP2515_BufferCoverage(Groups, Other, GroupCount, Width, &Plan->Mask[1]);
+	}
+	else
+	{
+		Other = BestSelect;
+		Plan->Mask[1] = Plan->Mask[0];
+	}
+
+	uint8_t Filter = 0x00;
+	for(uint8_t i = 0x00; i < GroupCount; i++)
+	{
+		if(BestSelect & (0x01 << i))
+		{
+			Plan->Filter[Filter++] = Groups[i].Value & Plan->Mask[0];
+		}
+	}
+
+	for(; Filter < 0x02; Filter++)
+	{
+		Plan->Filter[Filter] = Plan->Filter[0];
+	}
+
+	for(uint8_t i = 0x00; i < GroupCount; i++)
+	{
+		if(Other & (0x01 << i))
+		{
+			Plan->Filter[Filter++] = Groups[i].Value & Plan->Mask[1];
+		}
+	}
+
+	for(; Filter < 0x06; Filter++)
+	{
+		Plan->Filter[Filter] = Plan->Filter[0x02];
+	}
+
+	// Expected ratio of unwanted messages for equally distributed identifiers
+	Plan->FalseAcceptRatio = 0x00;
+	if(Plan->Accepted > Plan->Wanted)
+	{
+		Plan->FalseAcceptRatio = ((uint64_t)(Plan->Accepted - Plan->Wanted) * 1000) / Plan->Accepted;
+	}
+
+	// Write all masks and filters in a single configuration mode session
+	uint8_t Registers[0x0C];
+	MCP2515_DeviceMode_t Mode = MCP2515_GetDeviceMode();
+
+	MCP2515_SetDeviceMode(MCP2515_CONFIG_MODE);
+	while(MCP2515_GetDeviceMode() != MCP2515_CONFIG_MODE);
+
+	for(uint8_t i = 0x00; i < 0x03; i++)
+	{
+		MCP2515_EncodeIdentifier(Plan->Filter[i], UseExtended, &Registers[i << 0x02]);
+	}
+	MCP2515_WriteRegisters(MCP2515_REGISTER_RXF0SIDH, Registers, 0x0C);
+
+	for(uint8_t i = 0x00; i < 0x03; i++)
+	{
+		MCP2515_EncodeIdentifier(Plan->Filter[i + 0x03], UseExtended, &Registers[i << 0x02]);
+	}
+	MCP2515_WriteRegisters(MCP2515_REGISTER_RXF3SIDH, Registers, 0x0C);
+
+	MCP2515_EncodeIdentifier(Plan->Mask[0], UseExtended, &Registers[0]);
+	MCP2515_EncodeIdentifier(Plan->Mask[1], UseExtended, &Registers[4]);
+	MCP2515_WriteRegisters(MCP2515_REGISTER_RXM0SIDH, Registers, 0x08);
+
+	MCP2515_SwitchFilter(MCP2515_RX0, MCP2515_FILTER_RECEIVE_ALL);
+	MCP2515_SwitchFilter(MCP2515_RX1, MCP2515_FILTER_RECEIVE_ALL);
+
+	MCP2515_SetDeviceMode(Mode);
+
+	return MCP2515_NO_ERROR;
+}
+
 void MCP2515_RequestTransmission(const MCP2515_TransmitBuffer_t Buffer)
 {
 	uint8_t Buffer_Int = Buffer & 0x07;
@@ -756,7 +1436,16 @@ void MCP2515_RequestTransmission(const MCP2515_TransmitBuffer_t Buffer)
 		MCP2515_SPI_CHIP_DESELECT();
 	#endif
 
-	__TxBufferFull &= ~Buffer_Int;
+	// The transmit interrupt modifies the bitmaps
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		// Keep the buffer reserved until the transmit interrupt, so the queue doesn't overwrite the pending message
+		#if(defined MCP2515_USE_TX_QUEUE)
+			__TxQueueBusy |= Buffer_Int;
+		#endif
+
+		__TxBufferFull &= ~Buffer_Int;
+	}
 }
 
 void MPC2515_AbortTransmission(const MCP2515_TransmitBuffer_t Buffer)
@@ -845,86 +1534,143 @@ void MCP2515_ReadMessage(CAN_Message_t* Message)
 
 MCP2515_ErrorCode_t MCP2515_PrepareMessage(CAN_Message_t* Message, const MCP2515_MessagePriority_t Priority)
 {
-	if(Message->ID > 0x7FF)
+	if(!MCP2515_CheckIdentifier(Message->Type, Message->ID))
 	{
 		return MCP2515_INVALID_IDENTIFIER;
 	}
-	
-	// Check for an empty transmit buffer. First check the internal bitmap and then check 
-	// the TXREQ bit in the second step
-	uint8_t Buffer = 0x00;
-	if(!(__TxBufferFull & MCP2515_TX0))
-	{
-		if(!(MCP2515_ReadRegister(MCP2515_REGISTER_TXB0CTRL) & MCP2515_TXREQ))
-		{
-			Buffer = MCP2515_REGISTER_TXB0CTRL;
-		}
 
-		__TxBufferFull |= MCP2515_TX0;
-	}
-	else if(!(__TxBufferFull & MCP2515_TX1))
+	// Check for an empty transmit buffer. First check the internal bitmap and then check
+	// the TXREQ bits (bit 2, 4 and 6 of the status) in the second step
+	uint8_t Status = MCP2515_ReadStatus();
+	uint8_t Index = 0x00;
+
+	// The transmit interrupt modifies the bitmaps and the queue can claim a buffer
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
 	{
-		if(!(MCP2515_ReadRegister(MCP2515_REGISTER_TXB1CTRL) & MCP2515_TXREQ))
+		uint8_t Used = __TxBufferFull;
+
+		#if(defined MCP2515_USE_TX_QUEUE)
+			Used |= __TxQueueBusy;
+		#endif
+
+		for(; Index < 0x03; Index++)
 		{
-			Buffer = MCP2515_REGISTER_TXB1CTRL;
+			if(!(Used & (0x01 << Index)) && !(Status & (0x01 << ((Index << 0x01) + 0x02))))
+			{
+				break;
+			}
 		}
 
-		__TxBufferFull |= MCP2515_TX1;
-	}
-	else if(!(__TxBufferFull & MCP2515_TX2))
-	{
-		if(!(MCP2515_ReadRegister(MCP2515_REGISTER_TXB2CTRL) & MCP2515_TXREQ))
+		// All Tx buffers are full - cancel transmission
+		if(Index == 0x03)
 		{
-			Buffer = MCP2515_REGISTER_TXB2CTRL;
+			return MCP2515_TX_BUFFER_FULL;
 		}
 
-		__TxBufferFull |= MCP2515_TX2;
-	}
+		__TxBufferFull |= (0x01 << Index);
 
-	// All Tx buffers are full - cancel transmission
-	if(Buffer == 0x00)
-	{
-		return MCP2515_TX_BUFFER_FULL;
+		#if(defined MCP2515_USE_TX_QUEUE)
+			__TxQueuePriority[Index] = Priority & 0x03;
+		#endif
 	}
 
-	// Delete TXREQ Bit
-	MCP2515_BitModify(Buffer, (0x01 << MCP2515_TXREQ), 0x00);
-
-	// Set the message id
-	MCP2515_WriteRegister(Buffer + 0x02, (Message->ID & 0x07) << 0x05);
-	MCP2515_WriteRegister(Buffer + 0x01, Message->ID >> 0x03);
+	MCP2515_LoadTxBuffer(Index, Message->Type, Message->ID, Message->Length, Message->pData);
 
 	// Set the message priority
-	MCP2515_BitModify(Buffer, 0x03, Priority & 0x03);
+	MCP2515_BitModify(MCP2515_REGISTER_TXB0CTRL + (Index << 0x04), 0x03, Priority & 0x03);
+
+	return MCP2515_NO_ERROR;
+}
 
-	switch(Message->Type)
+#if(defined MCP2515_USE_TX_QUEUE)
+	MCP2515_ErrorCode_t MCP2515_Enqueue(const MCP2515_Frame_t* Frame, const MCP2515_MessagePriority_t Priority)
 	{
-		case MCP2515_STANDARD_DATA:
+		if(!MCP2515_CheckIdentifier(Frame->Type, Frame->ID))
 		{
-			MCP2515_WriteRegister(Buffer + 0x05, (Message->Length & 0x0F));
+			return MCP2515_INVALID_IDENTIFIER;
+		}
+
+		uint8_t Level = Priority & 0x03;
 
-			for(uint8_t DataByte = 0x00; DataByte < MCP2515_MAX_DATABYTES; DataByte++)
+		// The transmit interrupt modifies the queue
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			uint8_t Entry = __TxQueueFree;
+			if(Entry == MCP2515_TX_QUEUE_NONE)
 			{
-				MCP2515_WriteRegister(Buffer + 0x06 + DataByte, *(Message->pData++));
+				return MCP2515_TX_QUEUE_FULL;
 			}
 
-			break;
+			__TxQueueFree = __TxQueue[Entry].Next;
+			__TxQueue[Entry].Frame = *Frame;
+			__TxQueue[Entry].Next = MCP2515_TX_QUEUE_NONE;
+
+			// Append the entry to the list of the priority
+			if(__TxQueueTail[Level] == MCP2515_TX_QUEUE_NONE)
+			{
+				__TxQueueHead[Level] = Entry;
+			}
+			else
+			{
+				__TxQueue[__TxQueueTail[Level]].Next = Entry;
+			}
+
+			__TxQueueTail[Level] = Entry;
+
+			MCP2515_RefillTx();
 		}
-		case MCP2515_STANDARD_REMOTE:
+
+		return MCP2515_NO_ERROR;
+	}
+#endif
+
+#if(defined MCP2515_USE_RX_FIFO)
+	bool MCP2515_Dequeue(MCP2515_Frame_t* Frame)
+	{
+		uint8_t Tail = __RxTail;
+
+		if(Tail == __RxHead)
 		{
-			MCP2515_WriteRegister(Buffer + 0x05, (Message->Length & 0x0F) + (0x01 << MCP2515_RTR));
+			return false;
+		}
 
-			break;
+		*Frame = __RxFIFO[Tail];
+		__RxTail = (Tail + 0x01) & (MCP2515_RX_FIFO_SIZE - 0x01);
+
+		return true;
+	}
+
+	void MCP2515_GetRxStatistics(MCP2515_RxStatistics_t* Statistics)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			*Statistics = __RxStatistics;
 		}
-		case MCP2515_EXTENDED_DATA:
+	}
+
+	void MCP2515_ResetRxStatistics(void)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
 		{
-			break;
+			memset(&__RxStatistics, 0x00, sizeof(MCP2515_RxStatistics_t));
 		}
-		case MCP2515_EXTENDED_REMOTE:
+	}
+#endif
+
+#if(defined MCP2515_USE_STATISTICS)
+	void MCP2515_GetStatistics(MCP2515_Statistics_t* Statistics)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
 		{
-			break;
+			*Statistics = __MCP2515_Statistics;
 		}
 	}
 
-	return MCP2515_NO_ERROR;
-}
\ No newline at end of file
+	void MCP2515_ResetStatistics(void)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			memset(&__MCP2515_Statistics, 0x00, sizeof(MCP2515_Statistics_t));
+		}
+	}
+#endif
\ No newline at end of file
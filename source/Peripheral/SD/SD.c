@@ -31,6 +31,8 @@
  *  @bug No known bugs.
  */
 
+#include <string.h>
+
 #include "Peripheral/SD/SD.h"
 
 /** @defgroup SD
@@ -56,6 +58,7 @@
 		#define SD_CMD_SET_BLOCKLEN							16
 		#define SD_CMD_READ_SINGLE_BLOCK					17
 		#define SD_CMD_READ_MULTIPLE_BLOCK					18
+		#define SD_CMD_SET_WR_BLK_ERASE_COUNT				23
 		#define SD_CMD_WRITE_SINGLE_BLOCK					24
 		#define SD_CMD_WRITE_MULTIPLE_BLOCK					25
 		#define SD_CMD_PROGRAMM_CSD							27
@@ -69,8 +72,10 @@
 		#define SD_CMD_LOCK_UNLOCK							42
 		#define SD_CMD_APP_CMD								55
 		#define SD_CMD_READ_OCR								58
+		#define SD_CMD_CRC_ON_OFF							59
 		 
 		#define SD_CMD_ACMD13								(0x80 | SD_CMD_SEND_STATUS)
+		#define SD_CMD_ACMD23								(0x80 | SD_CMD_SET_WR_BLK_ERASE_COUNT)
 		#define SD_CMD_ACMD41								(0x80 | SD_CMD_APP_SEND_OP_COND)
 	/** @} */ // end of Commands
 
@@ -81,6 +86,8 @@
 		#define SD_TOKEN_DATA_CMD25							0xFC								/**< Data token for CMD25 */
 		#define SD_TOKEN_STOP								0xFD								/**< Stop token for CMD25 */
 		#define SD_TOKEN_DATA								0xFE								/**< Data token for CMD17/28/24 */
+		#define SD_TOKEN_DATA_ACCEPTED						0x05								/**< Data response: Data accepted */
+		#define SD_TOKEN_DATA_CRC_ERROR						0x0B								/**< Data response: Data rejected due to a CRC error */
 	/** @} */ // end of Token
 
 	/** @defgroup SD-Errors
@@ -140,6 +147,128 @@
 */	
 static SD_CardType_t __CardType = SD_VER_UNKNOWN;
 
+/*
+ *	Multiple block write in progress
+*/
+static bool __StreamOpen = false;
+
+/*
+ *	The card is programming the last data block
+*/
+static volatile bool __CardBusy = false;
+static uint32_t __BusyPolls;
+
+#if(defined SD_USE_STATISTICS)
+	static SD_Statistics_t __Statistics;
+#endif
+
+#if(defined SD_USE_DMA)
+	/*
+	 *	Asynchronous transfer state
+	*/
+	static volatile SD_AsyncState_t __AsyncState = SD_ASYNC_IDLE;
+	static SD_AsyncCallback_t __AsyncCallback;
+	static const uint8_t* __AsyncBuffer;
+	static bool __AsyncWrite;
+
+	/*
+	 *	Checksum of the data block. The checksum of a write transfer is calculated before the transfer
+	 *	and the checksum of a read transfer is checked by SD_PollAsync, so the DMA interrupt doesn't process the data block.
+	*/
+	static uint16_t __AsyncCRC;
+	#if(defined SD_USE_CRC)
+		static volatile bool __AsyncCheck = false;
+	#endif
+
+	/*
+	 *	Dummy bytes for the DMA transfers
+	*/
+	static uint8_t __AsyncFill = 0xFF;
+	static uint8_t __AsyncDiscard;
+#endif
+
+#if(defined SD_USE_CRC)
+	/*
+	 *	Lookup table for the CRC16 (CCITT, polynomial 0x1021) of the data blocks
+	*/
+	static const uint16_t __SD_CRC16Table[256] PROGMEM = 
+	{
+		0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+		0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+		0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+		0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+		0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+		0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+		0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+		0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+		0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+		0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+		0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+		0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+		0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+		0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+		0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+		0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+		0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+		0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+		0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+		0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+		0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+		0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+		0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+		0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+		0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+		0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+		0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+		0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+		0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+		0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+		0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+		0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+	};
+
+	/** @brief			Update the CRC16 checksum of a data block.
+	 *  @param CRC		Current checksum
+	 *  @param Data		Data byte
+	 *  @return			New checksum
+	 */
+	static inline uint16_t SD_CRC16(const uint16_t CRC, const uint8_t Data) __attribute__ ((always_inline));
+	static inline uint16_t SD_CRC16(const uint16_t CRC, const uint8_t Data)
+	{
+		return (CRC << 0x08) ^ pgm_read_word(&__SD_CRC16Table[(CRC >> 0x08) ^ Data]);
+	}
+
+	/** @brief			Calculate the CRC7 checksum of a command frame.
+	 *  @param Command	Command code
+	 *  @param Arg		Command argument
+	 *  @return			Checksum with stop bit
+	 */
+	static uint8_t SD_CRC7(const uint8_t Command, const uint32_t Arg)
+	{
+		uint8_t CRC = 0x00;
+		uint8_t Frame[5] = {Command, (Arg >> 0x18) & 0xFF, (Arg >> 0x10) & 0xFF, (Arg >> 0x08) & 0xFF, Arg & 0xFF};
+
+		for(uint8_t i = 0x00; i < sizeof(Frame); i++)
+		{
+			uint8_t Data = Frame[i];
+
+			for(uint8_t j = 0x00; j < 0x08; j++)
+			{
+				CRC <<= 0x01;
+
+				if((Data ^ CRC) & 0x80)
+				{
+					CRC ^= 0x09;
+				}
+
+				Data <<= 0x01;
+			}
+		}
+
+		return ((CRC & 0x7F) << 0x01) | 0x01;
+	}
+#endif
+
 /*
  *	Current SD card status
 */
@@ -164,14 +293,101 @@ static SD_Status_t __CardStatus;
 	}
 #endif
 
-/** @brief	Select the SD card
+/** @brief		Check the busy state of the SD card once.
+ *  @return		#true if the card is still programming
  */
-static void SD_Select(void)
+static bool SD_PollBusy(void)
 {
+	if(!__CardBusy)
+	{
+		return false;
+	}
+
+	// The card is released during the programming when no stream is open
+	if(!__StreamOpen)
+	{
+		SD_SPIM_CHIP_SELECT(GET_PERIPHERAL(SD_SS), GET_INDEX(SD_SS));
+	}
+
+	// The card holds the data line low until the programming is finished
+	uint8_t Response = SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+
+	if(!__StreamOpen)
+	{
+		SD_SPIM_CHIP_DESELECT(GET_PERIPHERAL(SD_SS), GET_INDEX(SD_SS));
+	}
+
+	__BusyPolls++;
+
+	if(Response == 0xFF)
+	{
+		__CardBusy = false;
+
+		#if(defined SD_USE_STATISTICS)
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+			{
+				if(__BusyPolls > __Statistics.MaxBusyPolls)
+				{
+					__Statistics.MaxBusyPolls = __BusyPolls;
+				}
+			}
+		#endif
+	}
+
+	return __CardBusy;
+}
+
+/** @brief	Mark the card as busy after a data block or a stop token.
+ */
+static void SD_SetBusy(void)
+{
+	__BusyPolls = 0x00;
+	__CardBusy = true;
+}
+
+/** @brief		Wait until a running transfer is finished and the card has finished the programming.
+ *  @return		Error code
+ */
+static const SD_Error_t SD_WaitReady(void)
+{
+	#if(defined SD_USE_DMA)
+		while(SD_PollAsync() == SD_ASYNC_TRANSFER);
+	#endif
+
+	while(SD_PollBusy())
+	{
+		if(__BusyPolls >= SD_BUSY_TIMEOUT)
+		{
+			// Give up and release the card, so the application can reinitialize it
+			__CardBusy = false;
+
+			#if(defined SD_USE_STATISTICS)
+				ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+				{
+					__Statistics.Timeouts++;
+				}
+			#endif
+
+			return SD_TIMEOUT;
+		}
+	}
+
+	return SD_SUCCESSFULL;
+}
+
+/** @brief		Select the SD card
+ *  @return		Error code
+ */
+static const SD_Error_t SD_Select(void)
+{
+	SD_Error_t ErrorCode = SD_WaitReady();
+
 	// Create 8 clock pulse before activating the card
 	SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
 
 	SD_SPIM_CHIP_SELECT(GET_PERIPHERAL(SD_SS), GET_INDEX(SD_SS));
+
+	return ErrorCode;
 }
 
 /** @brief	Deselect the SD card
@@ -200,7 +416,10 @@ static const uint8_t SD_SendCommand(const uint8_t Command, const uint32_t Arg)
 	// Dummy CRC + Stop
 	uint8_t Checksum = 0x01;
 
-	SD_Select();
+	if(SD_Select() != SD_SUCCESSFULL)
+	{
+		return SD_TIMEOUT;
+	}
 
 	// Send ACMD<n> command
 	if(CommandTemp & 0x80)
@@ -221,16 +440,20 @@ static const uint8_t SD_SendCommand(const uint8_t Command, const uint32_t Arg)
 	SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), (Arg >> 0x08) & 0xFF);
 	SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), Arg);
 
-	if(CommandTemp == SD_ID_TO_CMD(SD_CMD_GO_IDLE))
-	{
-		// Valid CRC for CMD0(0)
-		Checksum = 0x95;
-	}
-	else if(CommandTemp == SD_ID_TO_CMD(SD_CMD_IF_COND))
-	{
-		// Valid CRC for CMD8(0x1AA)
-		Checksum = 0x87;
-	}
+	#if(defined SD_USE_CRC)
+		Checksum = SD_CRC7(CommandTemp, Arg);
+	#else
+		if(CommandTemp == SD_ID_TO_CMD(SD_CMD_GO_IDLE))
+		{
+			// Valid CRC for CMD0(0)
+			Checksum = 0x95;
+		}
+		else if(CommandTemp == SD_ID_TO_CMD(SD_CMD_IF_COND))
+		{
+			// Valid CRC for CMD8(0x1AA)
+			Checksum = 0x87;
+		}
+	#endif
 
 	SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), Checksum);
 
@@ -259,74 +482,220 @@ static const uint8_t SD_SendCommand(const uint8_t Command, const uint32_t Arg)
 	return SD_NO_RESPONSE;
 }
 
-/** @brief			Read a single block of data from the SD card.
+/** @brief			Get the error code for the response of a command.
+ *  @param Response	Response of #SD_SendCommand
+ *  @return			Error code
+ */
+static const SD_Error_t SD_CommandError(const uint8_t Response)
+{
+	// #SD_SendCommand returns #SD_TIMEOUT when the card doesn't leave the busy state before the command
+	if((Response == SD_SUCCESSFULL) || (Response == SD_TIMEOUT))
+	{
+		return Response;
+	}
+
+	return SD_NO_RESPONSE;
+}
+
+/** @brief			Receive a data block from the SD card.
  *  @param Length	Block length
  *  @param Buffer	Pointer to data buffer
- *  @return			Error code
+ *  @return			CRC16 checksum of the data
  */
-static const SD_Error_t SD_ReadBlock(const uint32_t Length, uint8_t* Buffer)
+static uint16_t SD_ReceiveData(const uint16_t Length, uint8_t* Buffer)
+{
+	uint16_t CRC = 0x00;
+
+	#if((MCU_ARCH == MCU_ARCH_XMEGA) && (SD_INTERFACE_TYPE == INTERFACE_USART_SPI))
+		USART_t* Device = &CONCAT(SD_INTERFACE);
+
+		// Keep the next dummy byte in the transmit buffer while the current byte is received
+		Device->DATA = 0xFF;
+		for(uint16_t i = 0x00; i < Length; i++)
+		{
+			if(i < (Length - 0x01))
+			{
+				while(!(Device->STATUS & USART_DREIF_bm));
+				Device->DATA = 0xFF;
+			}
+
+			while(!(Device->STATUS & USART_RXCIF_bm));
+			uint8_t Data = Device->DATA;
+			*Buffer++ = Data;
+
+			#if(defined SD_USE_CRC)
+				CRC = SD_CRC16(CRC, Data);
+			#endif
+		}
+
+		// All bytes are shifted out, so clear the flag for the blocking transfer functions
+		Device->STATUS = USART_TXCIF_bm;
+	#else
+		for(uint16_t i = 0x00; i < Length; i++)
+		{
+			uint8_t Data = SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+			*Buffer++ = Data;
+
+			#if(defined SD_USE_CRC)
+				CRC = SD_CRC16(CRC, Data);
+			#endif
+		}
+	#endif
+
+	return CRC;
+}
+
+/** @brief			Transmit a data block to the SD card.
+ *  @param Length	Block length
+ *  @param Buffer	Pointer to data buffer
+ *  @return			CRC16 checksum of the data
+ */
+static uint16_t SD_TransmitData(const uint16_t Length, const uint8_t* Buffer)
+{
+	uint16_t CRC = 0x00;
+
+	#if((MCU_ARCH == MCU_ARCH_XMEGA) && (SD_INTERFACE_TYPE == INTERFACE_USART_SPI))
+		USART_t* Device = &CONCAT(SD_INTERFACE);
+
+		// Keep the next byte in the transmit buffer and discard the received bytes
+		for(uint16_t i = 0x00; i < Length; i++)
+		{
+			uint8_t Data = *Buffer++;
+
+			while(!(Device->STATUS & USART_DREIF_bm));
+			Device->DATA = Data;
+
+			#if(defined SD_USE_CRC)
+				CRC = SD_CRC16(CRC, Data);
+			#endif
+
+			if(i > 0x00)
+			{
+				while(!(Device->STATUS & USART_RXCIF_bm));
+				(void)Device->DATA;
+			}
+		}
+
+		// Wait for the last byte
+		while(!(Device->STATUS & USART_RXCIF_bm));
+		(void)Device->DATA;
+		Device->STATUS = USART_TXCIF_bm;
+	#else
+		for(uint16_t i = 0x00; i < Length; i++)
+		{
+			uint8_t Data = *Buffer++;
+			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), Data);
+
+			#if(defined SD_USE_CRC)
+				CRC = SD_CRC16(CRC, Data);
+			#endif
+		}
+	#endif
+
+	return CRC;
+}
+
+/** @brief		Wait for the data token of a read command.
+ *  @return		Error code
+ */
+static const SD_Error_t SD_WaitDataToken(void)
 {
 	uint8_t Response = 0xFF;
 
-	// Wait for the data token
 	Wait = 0x00;
 	while((++Wait < 0x2710) && (Response == 0xFF))
 	{
 		Response = SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
-		if(Wait >= 0x2710)
-		{
-			SD_Deselect();
+	}
 
-			return SD_NO_RESPONSE;
-		}
+	// Timeout or error token
+	if(Response != SD_TOKEN_DATA)
+	{
+		return SD_NO_RESPONSE;
 	}
 
-	// Get the data
-	for(uint32_t i = 0x00; i < Length; i++)
+	return SD_SUCCESSFULL;
+}
+
+/** @brief			Read a single block of data from the SD card.
+ *  @param Length	Block length
+ *  @param Buffer	Pointer to data buffer
+ *  @return			Error code
+ */
+static const SD_Error_t SD_ReadBlock(const uint32_t Length, uint8_t* Buffer)
+{
+	// Wait for the data token
+	if(SD_WaitDataToken() != SD_SUCCESSFULL)
 	{
-		*Buffer++ = SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+		SD_Deselect();
+
+		return SD_NO_RESPONSE;
 	}
 
-	// Skip checksum
-	SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
-	SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+	// Get the data
+	uint16_t CRC = SD_ReceiveData(Length, Buffer);
+
+	#if(defined SD_USE_CRC)
+		uint16_t Checksum = ((uint16_t)SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF)) << 0x08;
+		Checksum |= SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+
+		if(Checksum != CRC)
+		{
+			return SD_CRC_ERROR;
+		}
+	#else
+		// Skip checksum
+		(void)CRC;
+		SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+		SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+	#endif
 
 	return SD_SUCCESSFULL;
 }
 
-/** @brief			Read a single block of data from the SD card.
+/** @brief			Write a single block of data to the SD card.
  *  @param Buffer	Pointer to data buffer
  *  @param Length	Block length
- *  @param Token	Stop token
+ *  @param Token	Data token or stop token
  *  @return			Error code
  */
 static const SD_Error_t SD_WriteBlock(const uint8_t* Buffer, const uint32_t Length, const uint8_t Token)
 {
-	uint8_t* Buffer_Temp = (uint8_t*)Buffer;
-
 	// Send the token
 	SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), Token);
 	if(Token != SD_TOKEN_STOP)
 	{
 		// Send the data
-		for(uint32_t i = 0x00; i < Length; i++)
-		{
-			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), *Buffer_Temp++);
-		}
-
-		// Skip checksum
-		SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
-		SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+		uint16_t CRC = SD_TransmitData(Length, Buffer);
+
+		#if(defined SD_USE_CRC)
+			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), CRC >> 0x08);
+			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), CRC & 0xFF);
+		#else
+			// Skip checksum
+			(void)CRC;
+			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+		#endif
 
 		// Get the response
-		if((SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF) & 0x1F) != 0x05)
+		uint8_t Response = SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF) & 0x1F;
+		if(Response == SD_TOKEN_DATA_CRC_ERROR)
+		{
+			return SD_CRC_ERROR;
+		}
+		else if(Response != SD_TOKEN_DATA_ACCEPTED)
 		{
 			return SD_NO_RESPONSE;
 		}
+
+		#if(defined SD_USE_STATISTICS)
+			__Statistics.Writes++;
+		#endif
 	}
 
-	// Wait until the card clears busy state
-	while(SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF) != 0xFF);
+	// Don't wait for the programming. The busy state is checked before the next access to the card.
+	SD_SetBusy();
 
 	return SD_SUCCESSFULL;
 }
@@ -515,8 +884,13 @@ const SD_Error_t SD_Init(SPIM_Config_t* Config)
 		return ErrorCode;
 	}
 
-	// Change the frequency back to the old value
-	SD_SPIM_SET_CLOCK(&CONCAT(SD_INTERFACE), OldFreq, SysClock_GetClockPer());
+	// Switch to the full speed or change the frequency back to the old value
+	#if(defined SD_CLOCK)
+		(void)OldFreq;
+		SD_SPIM_SET_CLOCK(&CONCAT(SD_INTERFACE), SD_CLOCK, SysClock_GetClockPer());
+	#else
+		SD_SPIM_SET_CLOCK(&CONCAT(SD_INTERFACE), OldFreq, SysClock_GetClockPer());
+	#endif
 
 	// Set the block length to 512 (only necessary if the card is not a SDXC or SDHX card)
 	if((__CardType != SD_VER_2_HI) && (__CardType != SD_VER_2_STD))
@@ -528,6 +902,12 @@ const SD_Error_t SD_Init(SPIM_Config_t* Config)
 		}
 	}
 
+	// Enable the CRC check of the SD card
+	#if(defined SD_USE_CRC)
+		ErrorCode = SD_SendCommand(SD_ID_TO_CMD(SD_CMD_CRC_ON_OFF), 0x01);
+		SD_Deselect();
+	#endif
+
 	return ErrorCode;
 }
 
@@ -557,9 +937,13 @@ const SD_Error_t SD_Init(SPIM_Config_t* Config)
 	}
 #endif
 
-void SD_Sync(void)
+const SD_Error_t SD_Sync(void)
 {
+	SD_Error_t ErrorCode = SD_WaitReady();
+
 	SD_Deselect();
+
+	return ErrorCode;
 }
 
 const SD_Error_t SD_GetCSD(SD_CSD_t* CSD)
@@ -715,16 +1099,15 @@ const SD_CardType_t SD_GetCardType(void)
 
 const SD_Error_t SD_ReadDataBlock(const uint32_t Address, uint8_t* Buffer)
 {
-	if((SD_SendCommand(SD_ID_TO_CMD(SD_CMD_READ_SINGLE_BLOCK), Address) == SD_SUCCESSFULL) && (SD_ReadBlock(SD_BLOCK_SIZE, Buffer) == SD_SUCCESSFULL))
+	SD_Error_t ErrorCode = SD_CommandError(SD_SendCommand(SD_ID_TO_CMD(SD_CMD_READ_SINGLE_BLOCK), Address));
+	if(ErrorCode == SD_SUCCESSFULL)
 	{
-		SD_Deselect();
-
-		return SD_SUCCESSFULL;
+		ErrorCode = SD_ReadBlock(SD_BLOCK_SIZE, Buffer);
 	}
 
 	SD_Deselect();
 
-	return SD_NO_RESPONSE;
+	return ErrorCode;
 }
 
 const SD_Error_t SD_ReadDataBlocks(const uint32_t Address, const uint32_t Blocks, uint8_t* Buffer)
@@ -732,11 +1115,12 @@ const SD_Error_t SD_ReadDataBlocks(const uint32_t Address, const uint32_t Blocks
 	SD_Error_t ErrorCode;
 
 	// Send the command
-	if(SD_SendCommand(SD_ID_TO_CMD(SD_CMD_READ_MULTIPLE_BLOCK), Address) != SD_SUCCESSFULL)
+	ErrorCode = SD_CommandError(SD_SendCommand(SD_ID_TO_CMD(SD_CMD_READ_MULTIPLE_BLOCK), Address));
+	if(ErrorCode != SD_SUCCESSFULL)
 	{
 		SD_Deselect();
 
-		return SD_NO_RESPONSE;
+		return ErrorCode;
 	}
 
 	// Read all data
@@ -745,6 +1129,9 @@ const SD_Error_t SD_ReadDataBlocks(const uint32_t Address, const uint32_t Blocks
 		ErrorCode = SD_ReadBlock(SD_BLOCK_SIZE, Buffer);
 		if(ErrorCode != SD_SUCCESSFULL)
 		{
+			// Leave the multiple block read mode
+			SD_SendCommand(SD_ID_TO_CMD(SD_CMD_STOP_TRANSMISSION), 0x00);
+
 			SD_Deselect();
 
 			return ErrorCode;
@@ -763,48 +1150,416 @@ const SD_Error_t SD_ReadDataBlocks(const uint32_t Address, const uint32_t Blocks
 
 const SD_Error_t SD_WriteDataBlock(const uint32_t Address, const uint8_t* Buffer)
 {
-	if((SD_SendCommand(SD_ID_TO_CMD(SD_CMD_WRITE_SINGLE_BLOCK), Address) == SD_SUCCESSFULL) && (SD_WriteBlock(Buffer, SD_BLOCK_SIZE, SD_TOKEN_DATA) == SD_SUCCESSFULL))
+	SD_Error_t ErrorCode = SD_CommandError(SD_SendCommand(SD_ID_TO_CMD(SD_CMD_WRITE_SINGLE_BLOCK), Address));
+	if(ErrorCode == SD_SUCCESSFULL)
 	{
-		SD_Deselect();
-
-		return SD_SUCCESSFULL;
+		ErrorCode = SD_WriteBlock(Buffer, SD_BLOCK_SIZE, SD_TOKEN_DATA);
 	}
 
 	SD_Deselect();
 
-	return SD_NO_RESPONSE;
+	return ErrorCode;
 }
 
 const SD_Error_t SD_WriteDataBlocks(const uint32_t Address, const uint32_t Blocks, const uint8_t* Buffer)
 {
-	SD_Error_t ErrorCode;
-
-	// Send the command
-	if(SD_SendCommand(SD_ID_TO_CMD(SD_CMD_WRITE_MULTIPLE_BLOCK), Address) != SD_SUCCESSFULL)
+	SD_Error_t ErrorCode = SD_OpenStream(Address, Blocks);
+	if(ErrorCode != SD_SUCCESSFULL)
 	{
-		SD_Deselect();
-
-		return SD_NO_RESPONSE;
+		return ErrorCode;
 	}
 
 	// Write all data
 	for(uint32_t i = 0x00; i < Blocks; i++)
 	{
-		ErrorCode = SD_WriteBlock(Buffer, SD_BLOCK_SIZE, SD_TOKEN_DATA_CMD25);
+		ErrorCode = SD_AppendStream(Buffer);
 		if(ErrorCode != SD_SUCCESSFULL)
 		{
-			SD_Deselect();
-
 			return ErrorCode;
 		}
 
 		Buffer += SD_BLOCK_SIZE;
 	}
 
+	return SD_CloseStream();
+}
+
+const SD_Error_t SD_OpenStream(const uint32_t Address, const uint32_t Blocks)
+{
+	if(__StreamOpen)
+	{
+		return SD_PARAMETER_ERROR;
+	}
+
+	// Set the number of blocks to pre-erase (only supported by SD cards)
+	if((Blocks > 0x00) && (__CardType != SD_MMC))
+	{
+		SD_SendCommand(SD_ID_TO_CMD(SD_CMD_ACMD23), Blocks & 0x7FFFFF);
+		SD_Deselect();
+	}
+
+	// Send the command and keep the card selected for the data blocks
+	SD_Error_t ErrorCode = SD_CommandError(SD_SendCommand(SD_ID_TO_CMD(SD_CMD_WRITE_MULTIPLE_BLOCK), Address));
+	if(ErrorCode != SD_SUCCESSFULL)
+	{
+		SD_Deselect();
+
+		return ErrorCode;
+	}
+
+	__StreamOpen = true;
+
+	return SD_SUCCESSFULL;
+}
+
+const SD_Error_t SD_AppendStream(const uint8_t* Buffer)
+{
+	if(!__StreamOpen)
+	{
+		return SD_PARAMETER_ERROR;
+	}
+
+	SD_Error_t ErrorCode = SD_WaitReady();
+	if(ErrorCode != SD_SUCCESSFULL)
+	{
+		SD_CloseStream();
+
+		return ErrorCode;
+	}
+
+	ErrorCode = SD_WriteBlock(Buffer, SD_BLOCK_SIZE, SD_TOKEN_DATA_CMD25);
+	if(ErrorCode != SD_SUCCESSFULL)
+	{
+		// Abort the transmission
+		SD_CloseStream();
+	}
+
+	return ErrorCode;
+}
+
+const SD_Error_t SD_CloseStream(void)
+{
+	if(!__StreamOpen)
+	{
+		return SD_PARAMETER_ERROR;
+	}
+
+	SD_Error_t ErrorCode = SD_WaitReady();
+
 	// Send stop token
 	SD_WriteBlock(NULL, 0, SD_TOKEN_STOP);
 
 	SD_Deselect();
 
-	return SD_SUCCESSFULL;
-}
\ No newline at end of file
+	__StreamOpen = false;
+
+	return ErrorCode;
+}
+
+const bool SD_IsBusy(void)
+{
+	#if(defined SD_USE_DMA)
+		return SD_PollAsync() != SD_ASYNC_IDLE;
+	#else
+		return SD_PollBusy();
+	#endif
+}
+
+#if(defined SD_USE_STATISTICS)
+	void SD_GetStatistics(SD_Statistics_t* Statistics)
+	{
+		// The DMA interrupt can modify the statistics
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			*Statistics = __Statistics;
+		}
+	}
+
+	void SD_ResetStatistics(void)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			memset(&__Statistics, 0x00, sizeof(SD_Statistics_t));
+		}
+	}
+#endif
+
+#if(defined SD_USE_DMA)
+	#if(defined SD_USE_CRC)
+		/** @brief			Calculate the CRC16 checksum of a data block.
+		 *  @param Buffer	Pointer to data buffer
+		 *  @param Length	Block length
+		 *  @return			Checksum
+		 */
+		static uint16_t SD_CalcCRC16(const uint8_t* Buffer, const uint16_t Length)
+		{
+			uint16_t CRC = 0x00;
+
+			for(uint16_t i = 0x00; i < Length; i++)
+			{
+				CRC = SD_CRC16(CRC, *Buffer++);
+			}
+
+			return CRC;
+		}
+	#endif
+
+	/** @brief			DMA transaction complete callback for the receive channel.
+	 *  @param Channel	DMA channel
+	 */
+	static void SD_DMACallback(const uint8_t Channel)
+	{
+		SD_Error_t ErrorCode = SD_SUCCESSFULL;
+
+		// All bytes are shifted out, so clear the flag for the blocking transfer functions
+		(&CONCAT(SD_INTERFACE))->STATUS = USART_TXCIF_bm;
+
+		if(__AsyncWrite)
+		{
+			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), __AsyncCRC >> 0x08);
+			SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), __AsyncCRC & 0xFF);
+
+			// Get the response
+			uint8_t Response = SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF) & 0x1F;
+			if(Response == SD_TOKEN_DATA_CRC_ERROR)
+			{
+				ErrorCode = SD_CRC_ERROR;
+			}
+			else if(Response != SD_TOKEN_DATA_ACCEPTED)
+			{
+				ErrorCode = SD_NO_RESPONSE;
+			}
+
+			// The busy state of the card is checked by SD_PollAsync
+			if(ErrorCode == SD_SUCCESSFULL)
+			{
+				SD_SetBusy();
+
+				#if(defined SD_USE_STATISTICS)
+					__Statistics.Writes++;
+				#endif
+			}
+
+			__AsyncState = SD_ASYNC_IDLE;
+		}
+		else
+		{
+			__AsyncCRC = ((uint16_t)SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF)) << 0x08;
+			__AsyncCRC |= SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), 0xFF);
+
+			// The checksum is checked by SD_PollAsync and the transfer remains active until the check is done
+			#if(defined SD_USE_CRC)
+				__AsyncCheck = true;
+			#else
+				__AsyncState = SD_ASYNC_IDLE;
+			#endif
+		}
+
+		// Release the card. An open stream keeps the card selected.
+		if(!__StreamOpen)
+		{
+			SD_Deselect();
+		}
+
+		#if(defined SD_USE_CRC)
+			if(__AsyncCheck)
+			{
+				return;
+			}
+		#endif
+
+		if(__AsyncCallback != NULL)
+		{
+			__AsyncCallback(ErrorCode);
+		}
+	}
+
+	/** @brief			Start the DMA transfer of a data block.
+	 *  @param Buffer	Pointer to data buffer
+	 *  @param Write	#true for a transfer to the SD card
+	 */
+	static void SD_DMAStart(const uint8_t* Buffer, const bool Write)
+	{
+		USART_t* Device = &CONCAT(SD_INTERFACE);
+
+		// The receive channel reads every byte from the interface and signals the end of the transfer
+		DMA_TransferConfig_t Config = {
+			.Channel = &SD_DMA_RX_CHANNEL,
+			.EnableSingleShot = true,
+			.EnableRepeatMode = false,
+			.BurstLength = DMA_BURSTLENGTH_1,
+			.SrcReload = DMA_ADDRESS_RELOAD_NONE,
+			.DstReload = DMA_ADDRESS_RELOAD_NONE,
+			.SrcAddrMode = DMA_ADDRESS_MODE_FIXED,
+			.DstAddrMode = Write ? DMA_ADDRESS_MODE_FIXED : DMA_ADDRESS_MODE_INC,
+			.TriggerSource = SD_DMA_RX_TRIGGER,
+			.TransferCount = SD_BLOCK_SIZE,
+			.RepeatCount = 0x00,
+			.SrcAddress = (uintptr_t)&Device->DATA,
+			.DstAddress = Write ? (uintptr_t)&__AsyncDiscard : (uintptr_t)Buffer,
+		};
+
+		DMA_InterruptConfig_t DMAInterrupt = {
+			.Channel = &SD_DMA_RX_CHANNEL,
+			.Source = DMA_TRANSACTION_INTERRUPT,
+			.InterruptLevel = SD_DMA_INT_LEVEL,
+			.Callback = SD_DMACallback,
+		};
+
+		// Calculate the checksum before the transfer, because the DMA interrupt sends it
+		#if(defined SD_USE_CRC)
+			if(Write)
+			{
+				__AsyncCRC = SD_CalcCRC16(Buffer, SD_BLOCK_SIZE);
+			}
+		#else
+			__AsyncCRC = 0xFFFF;
+		#endif
+
+		__AsyncBuffer = Buffer;
+		__AsyncWrite = Write;
+		__AsyncState = SD_ASYNC_TRANSFER;
+
+		DMA_Channel_Config(&Config);
+		DMA_Channel_InstallCallback(&DMAInterrupt);
+
+		// The transmit channel sends the data or dummy bytes
+		Config.Channel = &SD_DMA_TX_CHANNEL;
+		Config.SrcAddrMode = Write ? DMA_ADDRESS_MODE_INC : DMA_ADDRESS_MODE_FIXED;
+		Config.DstAddrMode = DMA_ADDRESS_MODE_FIXED;
+		Config.TriggerSource = SD_DMA_TX_TRIGGER;
+		Config.SrcAddress = Write ? (uintptr_t)Buffer : (uintptr_t)&__AsyncFill;
+		Config.DstAddress = (uintptr_t)&Device->DATA;
+		DMA_Channel_Config(&Config);
+
+		// Enable the receive channel first, because the empty data register triggers the transmit channel immediately
+		DMA_Channel_Enable(&SD_DMA_RX_CHANNEL);
+		DMA_Channel_Enable(&SD_DMA_TX_CHANNEL);
+	}
+
+	const SD_Error_t SD_ReadDataBlockAsync(const uint32_t Address, uint8_t* Buffer, SD_AsyncCallback_t Callback)
+	{
+		if(__StreamOpen)
+		{
+			return SD_PARAMETER_ERROR;
+		}
+
+		if(SD_PollAsync() == SD_ASYNC_TRANSFER)
+		{
+			return SD_BUSY;
+		}
+
+		// The card can still program the last data block
+		SD_Error_t ErrorCode = SD_WaitReady();
+		if(ErrorCode != SD_SUCCESSFULL)
+		{
+			return ErrorCode;
+		}
+
+		if((SD_SendCommand(SD_ID_TO_CMD(SD_CMD_READ_SINGLE_BLOCK), Address) != SD_SUCCESSFULL) || (SD_WaitDataToken() != SD_SUCCESSFULL))
+		{
+			SD_Deselect();
+
+			return SD_NO_RESPONSE;
+		}
+
+		__AsyncCallback = Callback;
+		SD_DMAStart(Buffer, false);
+
+		return SD_SUCCESSFULL;
+	}
+
+	const SD_Error_t SD_WriteDataBlockAsync(const uint32_t Address, const uint8_t* Buffer, SD_AsyncCallback_t Callback)
+	{
+		if(__StreamOpen)
+		{
+			return SD_PARAMETER_ERROR;
+		}
+
+		if(SD_PollAsync() == SD_ASYNC_TRANSFER)
+		{
+			return SD_BUSY;
+		}
+
+		// The card can still program the last data block
+		SD_Error_t ErrorCode = SD_WaitReady();
+		if(ErrorCode != SD_SUCCESSFULL)
+		{
+			return ErrorCode;
+		}
+
+		if(SD_SendCommand(SD_ID_TO_CMD(SD_CMD_WRITE_SINGLE_BLOCK), Address) != SD_SUCCESSFULL)
+		{
+			SD_Deselect();
+
+			return SD_NO_RESPONSE;
+		}
+
+		// Send the token
+		SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), SD_TOKEN_DATA);
+
+		__AsyncCallback = Callback;
+		SD_DMAStart(Buffer, true);
+
+		return SD_SUCCESSFULL;
+	}
+
+	const SD_Error_t SD_AppendStreamAsync(const uint8_t* Buffer, SD_AsyncCallback_t Callback)
+	{
+		if(!__StreamOpen)
+		{
+			return SD_PARAMETER_ERROR;
+		}
+
+		if(SD_PollAsync() == SD_ASYNC_TRANSFER)
+		{
+			return SD_BUSY;
+		}
+
+		// The card can still program the last data block
+		SD_Error_t ErrorCode = SD_WaitReady();
+		if(ErrorCode != SD_SUCCESSFULL)
+		{
+			return ErrorCode;
+		}
+
+		// Send the token
+		SD_SPIM_TRANSMIT(&CONCAT(SD_INTERFACE), SD_TOKEN_DATA_CMD25);
+
+		__AsyncCallback = Callback;
+		SD_DMAStart(Buffer, true);
+
+		return SD_SUCCESSFULL;
+	}
+
+	const SD_AsyncState_t SD_PollAsync(void)
+	{
+		#if(defined SD_USE_CRC)
+			// Check the received data block outside of the DMA interrupt
+			if(__AsyncCheck)
+			{
+				SD_Error_t ErrorCode = SD_SUCCESSFULL;
+
+				__AsyncCheck = false;
+				if(__AsyncCRC != SD_CalcCRC16(__AsyncBuffer, SD_BLOCK_SIZE))
+				{
+					ErrorCode = SD_CRC_ERROR;
+				}
+
+				__AsyncState = SD_ASYNC_IDLE;
+
+				if(__AsyncCallback != NULL)
+				{
+					__AsyncCallback(ErrorCode);
+				}
+			}
+		#endif
+
+		if(__AsyncState == SD_ASYNC_TRANSFER)
+		{
+			return SD_ASYNC_TRANSFER;
+		}
+
+		return SD_PollBusy() ? SD_ASYNC_BUSY : SD_ASYNC_IDLE;
+	}
+#endif
\ No newline at end of file
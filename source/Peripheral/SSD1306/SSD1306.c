@@ -192,6 +192,32 @@ void Display_WriteData(const uint8_t Data)
 	SSD1306_SPIM_CHIP_DESELECT(GET_PERIPHERAL(SSD1306_SS), GET_INDEX(SSD1306_SS));
 }
 
+void Display_WriteDataBytes(const uint8_t* Data, const uint8_t Length)
+{
+	SSD1306_SPIM_CHIP_SELECT(GET_PERIPHERAL(SSD1306_SS), GET_INDEX(SSD1306_SS));
+	GPIO_Set(GET_PERIPHERAL(SSD1306_DATA), GET_INDEX(SSD1306_DATA));
+
+	for(uint8_t i = 0x00; i < Length; i++)
+	{
+		SSD1306_SPIM_TRANSMIT(*Data++);
+	}
+
+	GPIO_Clear(GET_PERIPHERAL(SSD1306_DATA), GET_INDEX(SSD1306_DATA));
+	SSD1306_SPIM_CHIP_DESELECT(GET_PERIPHERAL(SSD1306_SS), GET_INDEX(SSD1306_SS));
+}
+
+void Display_BeginData(void)
+{
+	SSD1306_SPIM_CHIP_SELECT(GET_PERIPHERAL(SSD1306_SS), GET_INDEX(SSD1306_SS));
+	GPIO_Set(GET_PERIPHERAL(SSD1306_DATA), GET_INDEX(SSD1306_DATA));
+}
+
+void Display_EndData(void)
+{
+	GPIO_Clear(GET_PERIPHERAL(SSD1306_DATA), GET_INDEX(SSD1306_DATA));
+	SSD1306_SPIM_CHIP_DESELECT(GET_PERIPHERAL(SSD1306_SS), GET_INDEX(SSD1306_SS));
+}
+
 void Display_SetPage(const uint8_t Page)
 {
 	SSD1306_WriteCommand(SSD1306_CMD_PAGE_ADDRESS(Page & 0x0F));
@@ -279,6 +279,32 @@ void Display_WriteData(const uint8_t Data)
 	ST7565R_SPIM_CHIP_DESELECT(GET_PERIPHERAL(ST7565R_SS), GET_INDEX(ST7565R_SS));
 }
 
+void Display_WriteDataBytes(const uint8_t* Data, const uint8_t Length)
+{
+	ST7565R_SPIM_CHIP_SELECT(GET_PERIPHERAL(ST7565R_SS), GET_INDEX(ST7565R_SS));
+	GPIO_Set(GET_PERIPHERAL(ST7565R_REGISTER_SELECT), GET_INDEX(ST7565R_REGISTER_SELECT));
+
+	for(uint8_t i = 0x00; i < Length; i++)
+	{
+		ST7565R_SPIM_TRANSMIT(*Data++);
+	}
+
+	GPIO_Clear(GET_PERIPHERAL(ST7565R_REGISTER_SELECT), GET_INDEX(ST7565R_REGISTER_SELECT));
+	ST7565R_SPIM_CHIP_DESELECT(GET_PERIPHERAL(ST7565R_SS), GET_INDEX(ST7565R_SS));
+}
+
+void Display_BeginData(void)
+{
+	ST7565R_SPIM_CHIP_SELECT(GET_PERIPHERAL(ST7565R_SS), GET_INDEX(ST7565R_SS));
+	GPIO_Set(GET_PERIPHERAL(ST7565R_REGISTER_SELECT), GET_INDEX(ST7565R_REGISTER_SELECT));
+}
+
+void Display_EndData(void)
+{
+	GPIO_Clear(GET_PERIPHERAL(ST7565R_REGISTER_SELECT), GET_INDEX(ST7565R_REGISTER_SELECT));
+	ST7565R_SPIM_CHIP_DESELECT(GET_PERIPHERAL(ST7565R_SS), GET_INDEX(ST7565R_SS));
+}
+
 void Display_SetPage(const uint8_t Page)
 {
 	ST7565R_WriteCommand(ST7565R_CMD_PAGE_ADDRESS(Page & 0x0F));
@@ -30,12 +30,54 @@
  *  @author Daniel Kampert
  */
 
+#include <string.h>
+
 #include "Services/DisplayManager/DisplayManager.h"
 
 extern SPIM_Config_t _DisplayManagerConfig;
 
 static uint8_t _DisplayMgrBuffer[DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE];
 
+#if(defined DISPLAYMANAGER_USE_DEFERRED)
+	static FrameBuffer_Dirty_t _DisplayMgrDirty[DISPLAYMANAGER_LCD_PAGES];
+#endif
+
+#if(defined DISPLAYMANAGER_USE_STATISTICS)
+	DisplayManager_Statistics_t _DisplayMgrStatistics;
+#endif
+
+/** @brief			Transmit a column range of a page from the frame buffer to the display.
+ *  @param Page		Display page
+ *  @param Start	First column
+ *  @param End		Last column
+ */
+static void DisplayManager_WriteSpan(const uint8_t Page, const uint8_t Start, const uint8_t End)
+{
+	Display_SetPage(Page);
+	Display_SetColumn(Start);
+	Display_WriteDataBytes(FrameBuffer_GetPointer(Page, Start), End - Start + 0x01);
+
+	#if(defined DISPLAYMANAGER_USE_STATISTICS)
+		_DisplayMgrStatistics.Commands += 0x02;
+		_DisplayMgrStatistics.DataBytes += End - Start + 0x01;
+	#endif
+}
+
+/** @brief			Update a modified column range of a page.
+ *					NOTE: The range is only marked as modified when #DISPLAYMANAGER_USE_DEFERRED is set.
+ *  @param Page		Display page
+ *  @param Start	First column
+ *  @param End		Last column
+ */
+static void DisplayManager_UpdateSpan(const uint8_t Page, const uint8_t Start, const uint8_t End)
+{
+	#if(defined DISPLAYMANAGER_USE_DEFERRED)
+		FrameBuffer_MarkDirty(Page, Start, End);
+	#else
+		DisplayManager_WriteSpan(Page, Start, End);
+	#endif
+}
+
 /** @brief			Write a single byte to the display.
  *  @param Page		Display page
  *  @param Column	Display column
@@ -45,9 +87,17 @@ static void DisplayManager_WriteByte(const uint8_t Page, const uint8_t Column, c
 {
 	FrameBuffer_WriteByte(Page, Column, Data);
 
-	Display_SetPage(Page);
-	Display_SetColumn(Column);
-	Display_WriteData(Data);
+	// The frame buffer keeps track of the modified byte in deferred mode
+	#if(!defined DISPLAYMANAGER_USE_DEFERRED)
+		Display_SetPage(Page);
+		Display_SetColumn(Column);
+		Display_WriteData(Data);
+
+		#if(defined DISPLAYMANAGER_USE_STATISTICS)
+			_DisplayMgrStatistics.Commands += 0x02;
+			_DisplayMgrStatistics.DataBytes++;
+		#endif
+	#endif
 }
 
 /** @brief			Read a single byte from the display.
@@ -60,16 +110,58 @@ static uint8_t DisplayManager_ReadByte(const uint8_t Page, const uint8_t Column)
 	return FrameBuffer_ReadByte(Page, Column);
 }
 
+/** @brief			Read one page of a bitmap column.
+ *  @param Bitmap	Pointer to bitmap object
+ *  @param Row		Page of the bitmap
+ *  @param Column	Column of the bitmap
+ *  @param Data		Pointer to bitmap data
+ *  @param Mask		Pointer to pixel mask
+ */
+static void DisplayManager_ReadBitmap(const Bitmap_t* Bitmap, const uint8_t Row, const uint8_t Column, uint8_t* Data, uint8_t* Mask)
+{
+	uint16_t Offset = (Row * Bitmap->Width) + Column;
+	uint8_t Lines = Bitmap->Height - (Row * DISPLAYMANAGER_LCD_PIXEL_PER_BYTE);
+
+	// Mask out the unused lines of the last page
+	*Mask = (Lines < DISPLAYMANAGER_LCD_PIXEL_PER_BYTE) ? (0xFF >> (DISPLAYMANAGER_LCD_PIXEL_PER_BYTE - Lines)) : 0xFF;
+
+	if(Bitmap->Type == MEMORY_PROGMEM)
+	{
+		*Data = pgm_read_byte(Bitmap->Data.Flash + Offset);
+
+		if(Bitmap->Mask != NULL)
+		{
+			*Mask &= pgm_read_byte(Bitmap->Mask + Offset);
+		}
+	}
+	else
+	{
+		*Data = *(Bitmap->Data.RAM + Offset);
+
+		if(Bitmap->Mask != NULL)
+		{
+			*Mask &= *(Bitmap->Mask + Offset);
+		}
+	}
+
+	*Data &= *Mask;
+}
+
 void DisplayManager_Init(void)
 {
 	Display_Init(&_DisplayManagerConfig);
 
 	// Initialize the frame buffer
-	FrameBuffer_Init(DISPLAYMANAGER_LCD_WIDTH, DISPLAYMANAGER_LCD_HEIGHT / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE, DISPLAYMANAGER_LCD_PAGES, _DisplayMgrBuffer);
+	#if(defined DISPLAYMANAGER_USE_DEFERRED)
+		FrameBuffer_Init(DISPLAYMANAGER_LCD_WIDTH, DISPLAYMANAGER_LCD_HEIGHT / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE, DISPLAYMANAGER_LCD_PAGES, _DisplayMgrBuffer, _DisplayMgrDirty);
+	#else
+		FrameBuffer_Init(DISPLAYMANAGER_LCD_WIDTH, DISPLAYMANAGER_LCD_HEIGHT / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE, DISPLAYMANAGER_LCD_PAGES, _DisplayMgrBuffer, NULL);
+	#endif
 
 	Display_SetStartLine(0);
 
 	DisplayManager_Clear();
+	DisplayManager_Flush();
 }
 
 void DisplayManager_SwitchBacklight(const bool Enable)
@@ -77,25 +169,63 @@ void DisplayManager_SwitchBacklight(const bool Enable)
 	Display_SwitchBacklight(Enable);	
 }
 
-void DisplayManager_Clear(void)
+void DisplayManager_Flush(void)
 {
+	uint8_t Start;
+	uint8_t End;
+
+	// Wait for an active DMA transmission
+	#if(defined DISPLAYMANAGER_USE_DMA)
+		while(DisplayManager_IsBusy());
+	#endif
+
+	#if(defined DISPLAYMANAGER_USE_STATISTICS)
+		_DisplayMgrStatistics.Flushes++;
+	#endif
+
 	for(uint8_t Page = 0x00; Page < DISPLAYMANAGER_LCD_PAGES; Page++)
 	{
-		for(uint8_t Column = 0x00; Column < DISPLAYMANAGER_LCD_WIDTH; Column++)
+		if(FrameBuffer_GetDirty(Page, &Start, &End))
 		{
-			DisplayManager_WriteByte(Page, Column, 0x00);
+			DisplayManager_WriteSpan(Page, Start, End);
+			FrameBuffer_ClearDirty(Page);
 		}
 	}
 }
 
+#if(defined DISPLAYMANAGER_USE_STATISTICS)
+	void DisplayManager_GetStatistics(DisplayManager_Statistics_t* Statistics)
+	{
+		// The DMA interrupt can modify the statistics
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			*Statistics = _DisplayMgrStatistics;
+		}
+	}
+
+	void DisplayManager_ResetStatistics(void)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			memset(&_DisplayMgrStatistics, 0x00, sizeof(DisplayManager_Statistics_t));
+		}
+	}
+#endif
+
+void DisplayManager_Clear(void)
+{
+	for(uint8_t Page = 0x00; Page < DISPLAYMANAGER_LCD_PAGES; Page++)
+	{
+		DisplayManager_ClearLine(Page);
+	}
+}
+
 void DisplayManager_ClearLine(const uint8_t Line)
 {
 	uint8_t Page = Line & (DISPLAYMANAGER_LCD_PAGES - 0x01);
 
-	for(uint8_t Column = 0x00; Column < DISPLAYMANAGER_LCD_WIDTH; Column++)
-	{
-		DisplayManager_WriteByte(Page, Column, 0x00);
-	}
+	memset(FrameBuffer_GetPointer(Page, 0x00), 0x00, DISPLAYMANAGER_LCD_WIDTH);
+	DisplayManager_UpdateSpan(Page, 0x00, DISPLAYMANAGER_LCD_WIDTH - 0x01);
 }
 
 void DisplayManager_ClearColumn(const uint8_t Column)
@@ -135,4 +265,176 @@ void DisplayManager_DrawPixel(const uint8_t x, const uint8_t y, const PixelMask_
 
 	// Write the new value to the display
 	DisplayManager_WriteByte(Page, x, Byte);
+}
+
+void DisplayManager_FillArea(const uint8_t x, const uint8_t y, const uint8_t Width, const uint8_t Height, const PixelMask_t Mask)
+{
+	// Check if the area is outside of the screen
+	if((x > (DISPLAYMANAGER_LCD_WIDTH - 1)) || (y > (DISPLAYMANAGER_LCD_HEIGHT - 1)) || (Width == 0x00) || (Height == 0x00))
+	{
+		return;
+	}
+
+	// Clip the area at the screen borders
+	uint8_t LastColumn = ((uint16_t)x + Width > DISPLAYMANAGER_LCD_WIDTH) ? (DISPLAYMANAGER_LCD_WIDTH - 1) : (x + Width - 1);
+	uint8_t LastLine = ((uint16_t)y + Height > DISPLAYMANAGER_LCD_HEIGHT) ? (DISPLAYMANAGER_LCD_HEIGHT - 1) : (y + Height - 1);
+	uint8_t FirstPage = y / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE;
+	uint8_t LastPage = LastLine / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE;
+	uint8_t Columns = LastColumn - x + 1;
+
+	for(uint8_t Page = FirstPage; Page <= LastPage; Page++)
+	{
+		uint8_t ByteMask = 0xFF;
+
+		// Mask out the unused lines of the first and the last page
+		if(Page == FirstPage)
+		{
+			ByteMask &= 0xFF << (y - (Page * DISPLAYMANAGER_LCD_PIXEL_PER_BYTE));
+		}
+
+		if(Page == LastPage)
+		{
+			ByteMask &= 0xFF >> ((DISPLAYMANAGER_LCD_PIXEL_PER_BYTE - 1) - (LastLine - (Page * DISPLAYMANAGER_LCD_PIXEL_PER_BYTE)));
+		}
+
+		uint8_t* Data = FrameBuffer_GetPointer(Page, x);
+
+		if(ByteMask == 0xFF)
+		{
+			memset(Data, (Mask == PIXELMASK_SET) ? 0xFF : 0x00, Columns);
+		}
+		else if(Mask == PIXELMASK_SET)
+		{
+			for(uint8_t i = 0x00; i < Columns; i++)
+			{
+				*Data++ |= ByteMask;
+			}
+		}
+		else
+		{
+			for(uint8_t i = 0x00; i < Columns; i++)
+			{
+				*Data++ &= ~ByteMask;
+			}
+		}
+
+		DisplayManager_UpdateSpan(Page, x, LastColumn);
+	}
+}
+
+void DisplayManager_DrawColumns(const uint8_t Page, const uint8_t x, const uint8_t* Data, const uint8_t Length, const PixelMask_t Mask)
+{
+	// Check if the columns are outside of the screen
+	if((Page > (DISPLAYMANAGER_LCD_PAGES - 1)) || (x > (DISPLAYMANAGER_LCD_WIDTH - 1)) || (Length == 0x00))
+	{
+		return;
+	}
+
+	// Clip the columns at the screen border
+	uint8_t LastColumn = ((uint16_t)x + Length > DISPLAYMANAGER_LCD_WIDTH) ? (DISPLAYMANAGER_LCD_WIDTH - 1) : (x + Length - 1);
+	uint8_t* Buffer = FrameBuffer_GetPointer(Page, x);
+
+	for(uint8_t i = x; i <= LastColumn; i++)
+	{
+		if(Mask == PIXELMASK_SET)
+		{
+			*Buffer++ |= *Data++;
+		}
+		else
+		{
+			*Buffer++ &= ~(*Data++);
+		}
+	}
+
+	DisplayManager_UpdateSpan(Page, x, LastColumn);
+}
+
+void DisplayManager_BlitBitmap(const int16_t x, const int16_t y, const Bitmap_t* Bitmap, const RasterOp_t Operation)
+{
+	if((Bitmap->Width == 0x00) || (Bitmap->Height == 0x00))
+	{
+		return;
+	}
+
+	// Clip the bitmap at the screen borders
+	int16_t FirstColumn = (x < 0) ? 0 : x;
+	int16_t LastColumn = x + Bitmap->Width - 1;
+	if(LastColumn > (DISPLAYMANAGER_LCD_WIDTH - 1))
+	{
+		LastColumn = DISPLAYMANAGER_LCD_WIDTH - 1;
+	}
+
+	// Round down to the page of the first line, even for negative coordinates
+	int16_t BasePage = (y < 0) ? ((y - (DISPLAYMANAGER_LCD_PIXEL_PER_BYTE - 1)) / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE) : (y / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE);
+	uint8_t Shift = y - (BasePage * DISPLAYMANAGER_LCD_PIXEL_PER_BYTE);
+	int16_t FirstPage = (BasePage < 0) ? 0 : BasePage;
+	int16_t LastPage = BasePage + ((Shift + Bitmap->Height - 1) / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE);
+	if(LastPage > (DISPLAYMANAGER_LCD_PAGES - 1))
+	{
+		LastPage = DISPLAYMANAGER_LCD_PAGES - 1;
+	}
+
+	if((FirstColumn > LastColumn) || (FirstPage > LastPage))
+	{
+		return;
+	}
+
+	uint8_t Rows = (Bitmap->Height + (DISPLAYMANAGER_LCD_PIXEL_PER_BYTE - 1)) / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE;
+
+	for(int16_t Page = FirstPage; Page <= LastPage; Page++)
+	{
+		// Bitmap page for the lower lines of the display page. The upper lines are taken from the previous bitmap page.
+		uint8_t Row = Page - BasePage;
+		uint8_t* Buffer = FrameBuffer_GetPointer(Page, FirstColumn);
+
+		for(int16_t Column = FirstColumn; Column <= LastColumn; Column++)
+		{
+			uint8_t Data = 0x00;
+			uint8_t Mask = 0x00;
+			uint8_t Temp_Data;
+			uint8_t Temp_Mask;
+
+			if(Row < Rows)
+			{
+				DisplayManager_ReadBitmap(Bitmap, Row, Column - x, &Data, &Mask);
+				Data <<= Shift;
+				Mask <<= Shift;
+			}
+
+			if(Shift && (Row > 0x00))
+			{
+				DisplayManager_ReadBitmap(Bitmap, Row - 1, Column - x, &Temp_Data, &Temp_Mask);
+				Data |= Temp_Data >> (DISPLAYMANAGER_LCD_PIXEL_PER_BYTE - Shift);
+				Mask |= Temp_Mask >> (DISPLAYMANAGER_LCD_PIXEL_PER_BYTE - Shift);
+			}
+
+			switch(Operation)
+			{
+				case RASTEROP_SET:
+				{
+					*Buffer |= Data;
+					break;
+				}
+				case RASTEROP_CLEAR:
+				{
+					*Buffer &= ~Data;
+					break;
+				}
+				case RASTEROP_XOR:
+				{
+					*Buffer ^= Data;
+					break;
+				}
+				case RASTEROP_COPY:
+				{
+					*Buffer = (*Buffer & ~Mask) | Data;
+					break;
+				}
+			}
+
+			Buffer++;
+		}
+
+		DisplayManager_UpdateSpan(Page, FirstColumn, LastColumn);
+	}
 }
\ No newline at end of file
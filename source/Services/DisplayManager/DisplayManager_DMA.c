@@ -0,0 +1,234 @@
+/*
+ * DisplayManager_DMA.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: DMA refresh engine for the display manager service.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Services/DisplayManager/DisplayManager_DMA.c
+ *  @brief DMA refresh engine for the display manager service.
+ *
+ *  This contains the implementation of the asynchronous display refresh. Each modified page
+ *  is transmitted with a single DMA transaction, which is triggered by the data register of the
+ *  display interface.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <string.h>
+
+#include "Services/DisplayManager/DisplayManager.h"
+
+#if(defined DISPLAYMANAGER_USE_DMA)
+
+#if(DISPLAY_INTERFACE_TYPE == INTERFACE_USART_SPI)
+	#define DISPLAYMANAGER_DMA_DEVICE						((USART_t*)&CONCAT(DISPLAY_INTERFACE))
+#elif(DISPLAY_INTERFACE_TYPE == INTERFACE_SPI)
+	#define DISPLAYMANAGER_DMA_DEVICE						((SPI_t*)&CONCAT(DISPLAY_INTERFACE))
+#else
+	#error "Interface not supported for display manager DMA!"
+#endif
+
+static volatile bool _DisplayMgrDMABusy;
+static volatile uint8_t _DisplayMgrDMAPage;
+static DisplayManager_Callback_t _DisplayMgrDMACallback;
+static FrameBuffer_Dirty_t _DisplayMgrDMASpans[DISPLAYMANAGER_LCD_PAGES];
+
+#if(defined DISPLAYMANAGER_USE_STATISTICS)
+	extern DisplayManager_Statistics_t _DisplayMgrStatistics;
+#endif
+
+#if(defined DISPLAYMANAGER_DMA_DOUBLE_BUFFER)
+	static uint8_t _DisplayMgrDMABuffer[DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE];
+#endif
+
+/** @brief			Get the source address for the DMA transmission.
+ *  @param Page		Display page
+ *  @param Column	Display column
+ *  @return			Pointer to data
+ */
+static uint8_t* DisplayManager_DMASource(const uint8_t Page, const uint8_t Column)
+{
+	#if(defined DISPLAYMANAGER_DMA_DOUBLE_BUFFER)
+		return _DisplayMgrDMABuffer + (Page * DISPLAYMANAGER_LCD_WIDTH) + Column;
+	#else
+		return FrameBuffer_GetPointer(Page, Column);
+	#endif
+}
+
+/** @brief	Wait until the last byte of a DMA transmission is shifted out.
+ */
+static void DisplayManager_DMAWaitComplete(void)
+{
+	#if(DISPLAY_INTERFACE_TYPE == INTERFACE_USART_SPI)
+		while(!(DISPLAYMANAGER_DMA_DEVICE->STATUS & USART_TXCIF_bm));
+		DISPLAYMANAGER_DMA_DEVICE->STATUS = USART_TXCIF_bm;
+
+		// Discard the received bytes, because the interface is shared with the blocking functions
+		while(DISPLAYMANAGER_DMA_DEVICE->STATUS & USART_RXCIF_bm)
+		{
+			(void)DISPLAYMANAGER_DMA_DEVICE->DATA;
+		}
+	#elif(DISPLAY_INTERFACE_TYPE == INTERFACE_SPI)
+		while(!(DISPLAYMANAGER_DMA_DEVICE->STATUS & SPI_IF_bm));
+		(void)DISPLAYMANAGER_DMA_DEVICE->DATA;
+	#endif
+}
+
+/** @brief		Start the DMA transmission of the next modified page.
+ *  @return		#false if there are no modified pages left
+ */
+static bool DisplayManager_DMAStartPage(void)
+{
+	while(_DisplayMgrDMAPage < DISPLAYMANAGER_LCD_PAGES)
+	{
+		FrameBuffer_Dirty_t* Span = &_DisplayMgrDMASpans[_DisplayMgrDMAPage];
+
+		if(Span->Start <= Span->End)
+		{
+			DMA_TransferConfig_t Config = {
+				.Channel = &DISPLAYMANAGER_DMA_CHANNEL,
+				.EnableSingleShot = true,
+				.EnableRepeatMode = false,
+				.BurstLength = DMA_BURSTLENGTH_1,
+				.SrcReload = DMA_ADDRESS_RELOAD_NONE,
+				.DstReload = DMA_ADDRESS_RELOAD_NONE,
+				.SrcAddrMode = DMA_ADDRESS_MODE_INC,
+				.DstAddrMode = DMA_ADDRESS_MODE_FIXED,
+				.TriggerSource = DISPLAYMANAGER_DMA_TRIGGER,
+				.TransferCount = Span->End - Span->Start + 0x01,
+				.RepeatCount = 0x00,
+				.SrcAddress = (uintptr_t)DisplayManager_DMASource(_DisplayMgrDMAPage, Span->Start),
+				.DstAddress = (uintptr_t)&DISPLAYMANAGER_DMA_DEVICE->DATA,
+			};
+
+			Display_SetPage(_DisplayMgrDMAPage);
+			Display_SetColumn(Span->Start);
+			Display_BeginData();
+
+			#if(defined DISPLAYMANAGER_USE_STATISTICS)
+				_DisplayMgrStatistics.Commands += 0x02;
+				_DisplayMgrStatistics.DataBytes += Config.TransferCount;
+			#endif
+
+			DMA_Channel_Config(&Config);
+
+			#if(DISPLAY_INTERFACE_TYPE == INTERFACE_USART_SPI)
+				// The empty data register triggers the first transfer
+				DISPLAYMANAGER_DMA_DEVICE->STATUS = USART_TXCIF_bm;
+				DMA_Channel_Enable(&DISPLAYMANAGER_DMA_CHANNEL);
+			#elif(DISPLAY_INTERFACE_TYPE == INTERFACE_SPI)
+				// The SPI interrupt flag is set after the first byte, so the first transfer has to be requested by software
+				DMA_Channel_StartTransfer(&DISPLAYMANAGER_DMA_CHANNEL);
+			#endif
+
+			return true;
+		}
+
+		_DisplayMgrDMAPage++;
+	}
+
+	return false;
+}
+
+/** @brief			DMA transaction complete callback.
+ *  @param Channel	DMA channel
+ */
+static void DisplayManager_DMACallback(const uint8_t Channel)
+{
+	DisplayManager_DMAWaitComplete();
+	Display_EndData();
+
+	_DisplayMgrDMAPage++;
+
+	if(!DisplayManager_DMAStartPage())
+	{
+		_DisplayMgrDMABusy = false;
+
+		if(_DisplayMgrDMACallback != NULL)
+		{
+			_DisplayMgrDMACallback();
+		}
+	}
+}
+
+bool DisplayManager_FlushAsync(DisplayManager_Callback_t Callback)
+{
+	if(_DisplayMgrDMABusy)
+	{
+		return false;
+	}
+
+	#if(defined DISPLAYMANAGER_USE_STATISTICS)
+		_DisplayMgrStatistics.Flushes++;
+	#endif
+
+	// Take a snapshot of the modified columns, so the application can continue drawing during the transmission
+	for(uint8_t Page = 0x00; Page < DISPLAYMANAGER_LCD_PAGES; Page++)
+	{
+		FrameBuffer_Dirty_t* Span = &_DisplayMgrDMASpans[Page];
+
+		if(FrameBuffer_GetDirty(Page, &Span->Start, &Span->End))
+		{
+			#if(defined DISPLAYMANAGER_DMA_DOUBLE_BUFFER)
+				memcpy(DisplayManager_DMASource(Page, Span->Start), FrameBuffer_GetPointer(Page, Span->Start), Span->End - Span->Start + 0x01);
+			#endif
+
+			FrameBuffer_ClearDirty(Page);
+		}
+		else
+		{
+			Span->Start = 0xFF;
+			Span->End = 0x00;
+		}
+	}
+
+	DMA_InterruptConfig_t DMAInterrupt = {
+		.Channel = &DISPLAYMANAGER_DMA_CHANNEL,
+		.Source = DMA_TRANSACTION_INTERRUPT,
+		.InterruptLevel = DISPLAYMANAGER_DMA_INT_LEVEL,
+		.Callback = DisplayManager_DMACallback,
+	};
+
+	DMA_Channel_InstallCallback(&DMAInterrupt);
+
+	_DisplayMgrDMACallback = Callback;
+	_DisplayMgrDMAPage = 0x00;
+	_DisplayMgrDMABusy = true;
+
+	if(!DisplayManager_DMAStartPage())
+	{
+		_DisplayMgrDMABusy = false;
+
+		if(_DisplayMgrDMACallback != NULL)
+		{
+			_DisplayMgrDMACallback();
+		}
+	}
+
+	return true;
+}
+
+bool DisplayManager_IsBusy(void)
+{
+	return _DisplayMgrDMABusy;
+}
+
+#endif
@@ -31,6 +31,120 @@
 #include <stdlib.h>
 #include "Services/DisplayManager/DisplayManager.h"
 
+/** @brief	Character object with the character columns shifted to the target line.
+ */
+typedef struct
+{
+	uint8_t ASCII;										/**< ASCII code of the character */
+	uint8_t Shift;										/**< Line offset inside of the display page */
+	uint8_t Columns;									/**< Width of the character */
+	uint8_t Age;										/**< Number of cache accesses since the last use of the character */
+	uint8_t Lower[FONT_MAX_WIDTH];						/**< Character columns for the first display page */
+	uint8_t Upper[FONT_MAX_WIDTH];						/**< Character columns for the second display page */
+} DisplayManager_Glyph_t;
+
+#if(defined DISPLAYMANAGER_USE_GLYPH_CACHE)
+	static DisplayManager_Glyph_t _DisplayMgrGlyphCache[DISPLAYMANAGER_GLYPH_CACHE_SIZE];
+#endif
+
+/** @brief			Load a character from the font table and shift the columns to the given line.
+ *  @param ASCII	ASCII code of the character
+ *  @param Shift	Line offset inside of the display page
+ *  @param Glyph	Pointer to character object
+ */
+static void DisplayManager_LoadGlyph(const uint8_t ASCII, const uint8_t Shift, DisplayManager_Glyph_t* Glyph)
+{
+	const uint8_t* Layout = (const uint8_t*)pgm_read_word(&FontTable[ASCII - 32]);
+
+	Glyph->ASCII = ASCII;
+	Glyph->Shift = Shift;
+	Glyph->Columns = pgm_read_byte(Layout++);
+
+	for(uint8_t i = 0x00; i < Glyph->Columns; i++)
+	{
+		uint8_t Column = pgm_read_byte(Layout++);
+
+		// Split the column into two bytes when the line isn't page aligned
+		Glyph->Lower[i] = Column << Shift;
+		Glyph->Upper[i] = Shift ? (Column >> (DISPLAYMANAGER_LCD_PIXEL_PER_BYTE - Shift)) : 0x00;
+	}
+}
+
+#if(defined DISPLAYMANAGER_USE_GLYPH_CACHE)
+	/** @brief			Get a character from the glyph cache.
+	 *					NOTE: The least recently used character is replaced on a cache miss.
+	 *  @param ASCII	ASCII code of the character
+	 *  @param Shift	Line offset inside of the display page
+	 *  @return			Pointer to character object
+	 */
+	static const DisplayManager_Glyph_t* DisplayManager_GetGlyph(const uint8_t ASCII, const uint8_t Shift)
+	{
+		DisplayManager_Glyph_t* Glyph = NULL;
+		DisplayManager_Glyph_t* Oldest = _DisplayMgrGlyphCache;
+
+		for(uint8_t i = 0x00; i < DISPLAYMANAGER_GLYPH_CACHE_SIZE; i++)
+		{
+			DisplayManager_Glyph_t* Entry = &_DisplayMgrGlyphCache[i];
+
+			if((Entry->ASCII == ASCII) && (Entry->Shift == Shift))
+			{
+				Glyph = Entry;
+			}
+			else if(Entry->Age < 0xFF)
+			{
+				Entry->Age++;
+			}
+
+			if(Entry->Age > Oldest->Age)
+			{
+				Oldest = Entry;
+			}
+		}
+
+		if(Glyph == NULL)
+		{
+			Glyph = Oldest;
+			DisplayManager_LoadGlyph(ASCII, Shift, Glyph);
+		}
+
+		Glyph->Age = 0x00;
+
+		return Glyph;
+	}
+#endif
+
+/** @brief			Draw a vertical span between two lines.
+ *					NOTE: The span is clipped at the display borders.
+ *  @param x		x coordinate
+ *  @param y1		Start coordinate (y direction)
+ *  @param y2		End coordinate (y direction)
+ *  @param Mask		Pixel mask
+ */
+static void DisplayManager_DrawSpan(const int16_t x, int16_t y1, int16_t y2, const PixelMask_t Mask)
+{
+	if((x < 0) || (x > (DISPLAYMANAGER_LCD_WIDTH - 1)))
+	{
+		return;
+	}
+
+	if(y1 < 0)
+	{
+		y1 = 0;
+	}
+
+	if(y2 > (DISPLAYMANAGER_LCD_HEIGHT - 1))
+	{
+		y2 = DISPLAYMANAGER_LCD_HEIGHT - 1;
+	}
+
+	if(y1 > y2)
+	{
+		return;
+	}
+
+	DisplayManager_FillArea(x, y1, 1, y2 - y1 + 1, Mask);
+}
+
 /*
 	Using Bresenham algorithm to draw the line
 */
@@ -114,13 +228,7 @@ void DisplayManager_DrawHorizontalLine(const uint8_t x, const uint8_t y, const u
 		return;
 	}
 
-	for(uint8_t i = 0x00; i < Length; i++)
-	{
-		for(uint8_t j = 0x00; j < Width; j++)
-		{
-			DisplayManager_DrawPixel(x + i, y + j, Mask);
-		}
-	}
+	DisplayManager_FillArea(x, y, Length, Width, Mask);
 }
 
 void DisplayManager_DrawVerticalLine(const uint8_t x, const uint8_t y, const uint8_t Length, const uint8_t Width, const PixelMask_t Mask)
@@ -129,14 +237,8 @@ void DisplayManager_DrawVerticalLine(const uint8_t x, const uint8_t y, const uin
 	{
 		return;
 	}
-	
-	for(uint8_t i = 0x00; i < Length; i++)
-	{
-		for(uint8_t j = 0x00; j < Width; j++)
-		{
-			DisplayManager_DrawPixel(x + j, y + i, Mask);
-		}
-	}
+
+	DisplayManager_FillArea(x, y, Width, Length, Mask);
 }
 
 void DisplayManager_DrawRect(const uint8_t x, const uint8_t y, const uint8_t Width, const uint8_t Height, const FillOptions_t Fill, const uint8_t LineWidth, const PixelMask_t Mask)
@@ -147,19 +249,18 @@ void DisplayManager_DrawRect(const uint8_t x, const uint8_t y, const uint8_t Wid
 		return;
 	}
 
-	DisplayManager_DrawHorizontalLine(x, y, Width, LineWidth, Mask);
-	DisplayManager_DrawVerticalLine(x + Width - LineWidth, y, Height, LineWidth, Mask);
-	DisplayManager_DrawHorizontalLine(x, y + Height - LineWidth, Width, LineWidth, Mask);
-	DisplayManager_DrawVerticalLine(x, y, Height, LineWidth, Mask);
-	
 	// Fill the rectangle
 	if(Fill == FILL_SOLID)
 	{
-		for(uint8_t i = 0x00; i < Height; i += LineWidth)
-		{
-			DisplayManager_DrawHorizontalLine(x, y + i, Width, LineWidth, Mask);
-		}
+		DisplayManager_FillArea(x, y, Width, Height, Mask);
+
+		return;
 	}
+
+	DisplayManager_DrawHorizontalLine(x, y, Width, LineWidth, Mask);
+	DisplayManager_DrawVerticalLine(x + Width - LineWidth, y, Height, LineWidth, Mask);
+	DisplayManager_DrawHorizontalLine(x, y + Height - LineWidth, Width, LineWidth, Mask);
+	DisplayManager_DrawVerticalLine(x, y, Height, LineWidth, Mask);
 }
 
 void DisplayManager_DrawCircle(const uint8_t x, const uint8_t y, const uint8_t Radius, const FillOptions_t Fill, const PixelMask_t Mask)
@@ -200,14 +301,11 @@ void DisplayManager_DrawCircle(const uint8_t x, const uint8_t y, const uint8_t R
 		}
 		else
 		{
-			DisplayManager_DrawVerticalLine(x + OffsetY, y - OffsetX, OffsetX + 1, 1, Mask);
-			DisplayManager_DrawVerticalLine(x + OffsetX, y - OffsetY, OffsetY + 1, 1, Mask);
-			DisplayManager_DrawVerticalLine(x - OffsetY, y - OffsetX, OffsetX + 1, 1, Mask);
-			DisplayManager_DrawVerticalLine(x - OffsetX, y - OffsetY, OffsetY + 1, 1, Mask);
-			DisplayManager_DrawVerticalLine(x - OffsetY, y, OffsetX + 1, 1, Mask);
-			DisplayManager_DrawVerticalLine(x - OffsetX, y, OffsetY + 1, 1, Mask);
-			DisplayManager_DrawVerticalLine(x + OffsetY, y, OffsetX + 1, 1, Mask);
-			DisplayManager_DrawVerticalLine(x + OffsetX, y, OffsetY + 1, 1, Mask);
+			// Fill the circle with vertical spans through the center line
+			DisplayManager_DrawSpan(x + OffsetX, y - OffsetY, y + OffsetY, Mask);
+			DisplayManager_DrawSpan(x - OffsetX, y - OffsetY, y + OffsetY, Mask);
+			DisplayManager_DrawSpan(x + OffsetY, y - OffsetX, y + OffsetX, Mask);
+			DisplayManager_DrawSpan(x - OffsetY, y - OffsetX, y + OffsetX, Mask);
 		}
 
 		if(Error < 0x00) 
@@ -307,26 +405,26 @@ void DisplayManager_DrawCircleSegment(const uint8_t x, const uint8_t y, const ui
 		{
 			if(Segment & CIRCLE_SEGMENT_QUADRANT1)
 			{
-				DisplayManager_DrawVerticalLine(x + OffsetY, y - OffsetX, OffsetX + 1, 1, Mask);
-				DisplayManager_DrawVerticalLine(x + OffsetX, y - OffsetY, OffsetY + 1, 1, Mask);
+				DisplayManager_DrawSpan(x + OffsetY, y - OffsetX, y, Mask);
+				DisplayManager_DrawSpan(x + OffsetX, y - OffsetY, y, Mask);
 			}
 				
 			if(Segment & CIRCLE_SEGMENT_QUADRANT2)
 			{
-				DisplayManager_DrawVerticalLine(x - OffsetY, y - OffsetX, OffsetX + 1, 1, Mask);
-				DisplayManager_DrawVerticalLine(x - OffsetX, y - OffsetY, OffsetY + 1, 1, Mask);
+				DisplayManager_DrawSpan(x - OffsetY, y - OffsetX, y, Mask);
+				DisplayManager_DrawSpan(x - OffsetX, y - OffsetY, y, Mask);
 			}
 			
 			if(Segment & CIRCLE_SEGMENT_QUADRANT3)
 			{
-				DisplayManager_DrawVerticalLine(x - OffsetY, y, OffsetX + 1, 1, Mask);
-				DisplayManager_DrawVerticalLine(x - OffsetX, y, OffsetY + 1, 1, Mask);
+				DisplayManager_DrawSpan(x - OffsetY, y, y + OffsetX, Mask);
+				DisplayManager_DrawSpan(x - OffsetX, y, y + OffsetY, Mask);
 			}
 			
 			if(Segment & CIRCLE_SEGMENT_QUADRANT4)
 			{
-				DisplayManager_DrawVerticalLine(x + OffsetY, y, OffsetX + 1, 1, Mask);
-				DisplayManager_DrawVerticalLine(x + OffsetX, y, OffsetY + 1, 1, Mask);
+				DisplayManager_DrawSpan(x + OffsetY, y, y + OffsetX, Mask);
+				DisplayManager_DrawSpan(x + OffsetX, y, y + OffsetY, Mask);
 			}
 		}
 
@@ -346,60 +444,24 @@ void DisplayManager_DrawCircleSegment(const uint8_t x, const uint8_t y, const ui
 
 void DisplayManager_DrawBitmap(const uint8_t x, const uint8_t y, const Bitmap_t* Bitmap)
 {
-	uint8_t i = 0x00;
-	uint8_t Height = 0x00;
-
-	if(((x + Bitmap->Width) > (DISPLAYMANAGER_LCD_WIDTH - 1)) || ((y + Bitmap->Height) > (DISPLAYMANAGER_LCD_HEIGHT - 1)))
-	{
-		return;
-	}
-
-	while(Height < Bitmap->Height)
-	{
-		for(uint8_t j = 0x00; j < Bitmap->Width; j++)
-		{
-			uint8_t Byte = 0x00;
-			
-			if(Bitmap->Type == MEMORY_PROGMEM)
-			{
-				Byte = pgm_read_byte(Bitmap->Data.Flash + (i * Bitmap->Width) + j);
-			}
-			else if(Bitmap->Type == MEMORY_RAM)
-			{
-				Byte = *(Bitmap->Data.RAM + (i * Bitmap->Width) + j);
-			}
-				
-			for(uint8_t k = 0x00; k < 0x08; k++)
-			{
-				// Draw a pixel if the current LSB is set
-				if(Byte & 0x01)
-				{
-					DisplayManager_DrawPixel(x + j, y + i * DISPLAYMANAGER_LCD_PIXEL_PER_BYTE + k, PIXELMASK_SET);
-				}
-						
-				// Shift the mask
-				Byte = Byte >> 0x01;
-			}
-		}
-		
-		if((Height + DISPLAYMANAGER_LCD_PIXEL_PER_BYTE) < Bitmap->Height)
-		{
-			Height += DISPLAYMANAGER_LCD_PIXEL_PER_BYTE;
-		}
-		else
-		{
-			Height += Bitmap->Height - Height;
-		}
-		
-		i++;
-	}
+	DisplayManager_BlitBitmap(x, y, Bitmap, RASTEROP_SET);
 }
 
 uint8_t DisplayManager_DrawString(const uint8_t x, const uint8_t y, const char* String)
 {
 	uint8_t x_temp = x;
 	uint8_t y_temp = y;
-	
+	const DisplayManager_Glyph_t* Glyph;
+
+	#if(!defined DISPLAYMANAGER_USE_GLYPH_CACHE)
+		DisplayManager_Glyph_t Character;
+
+		Glyph = &Character;
+	#endif
+
+	// The line offset doesn't change with a line break, because the font height is a multiple of the page height
+	uint8_t Shift = y % DISPLAYMANAGER_LCD_PIXEL_PER_BYTE;
+
 	while(*String)
 	{
 		// Get the character from string
@@ -408,42 +470,31 @@ uint8_t DisplayManager_DrawString(const uint8_t x, const uint8_t y, const char*
 		// Check if character is valid
 		if((ASCII > 31) && (ASCII < 127))
 		{
-			// Get the font layout for the character
-			const uint8_t* Layout = FontTable[ASCII - 32];
-			
-			uint8_t Columns = *Layout++;
+			// Get the shifted font layout for the character
+			#if(defined DISPLAYMANAGER_USE_GLYPH_CACHE)
+				Glyph = DisplayManager_GetGlyph(ASCII, Shift);
+			#else
+				DisplayManager_LoadGlyph(ASCII, Shift, &Character);
+			#endif
 
 			// Add line break
-			if((x_temp + Columns) > DISPLAYMANAGER_LCD_WIDTH)
+			if((x_temp + Glyph->Columns) > DISPLAYMANAGER_LCD_WIDTH)
 			{
 				x_temp = 0x00;
 				y_temp += FONT_HEIGHT;
 			}
 
-			// Loop over the columns layout (first item is the column count)
-			for(uint8_t i = 0x00; i < Columns; i++)
+			// Copy the columns into the frame buffer
+			uint8_t Page = y_temp / DISPLAYMANAGER_LCD_PIXEL_PER_BYTE;
+			DisplayManager_DrawColumns(Page, x_temp, Glyph->Lower, Glyph->Columns, PIXELMASK_SET);
+
+			if(Shift)
 			{
-				// Get the bit mask
-				uint8_t Mask = *Layout++;
-				
-				for(uint8_t j = 0x00; j < 0x08; j++)
-				{
-					// Draw a pixel if the current LSB is set
-					if(Mask & 0x01)
-					{
-						DisplayManager_DrawPixel(x_temp, y_temp + j, PIXELMASK_SET);
-					}
-					
-					// Shift the mask
-					Mask = Mask >> 0x01;
-				}
-				
-				// Next column
-				x_temp++;
+				DisplayManager_DrawColumns(Page + 1, x_temp, Glyph->Upper, Glyph->Columns, PIXELMASK_SET);
 			}
-			
-			// Add one pixel spacing between the characters
-			x_temp++;
+
+			// Next character with one pixel spacing between the characters
+			x_temp += Glyph->Columns + 1;
 		}
 	}
 	
@@ -28,9 +28,12 @@
  *  @author Daniel Kampert
  */
 
+#include <string.h>
+
 #include "fatfs-r0.13c/source/ff.h"
 #include "fatfs-r0.13c/source/diskio.h"
 
+#include "Services/FatFs/FatFs.h"
 #include "Peripheral/SD/SD.h"
 
 #define DEV_MMC					0							/**< Map MMC/SD card to physical drive 0 */
@@ -47,6 +50,44 @@ SPIM_Config_t __InterfaceConfig = {
 static volatile DSTATUS __MMCStatus = STA_NOINIT;
 static volatile DSTATUS __USBStatus = STA_NOINIT;
 
+#if(defined FATFS_USE_CACHE)
+	/** @brief Sector cache entry.
+	 */
+	typedef struct
+	{
+		DWORD Sector;									/**< Cached sector */
+		bool Valid;										/**< Entry contains a sector */
+		bool Dirty;										/**< Entry is modified and has to be written back */
+		bool Referenced;								/**< Second chance flag */
+	} MMC_CacheEntry_t;
+
+	#if(defined FATFS_CACHE_ADDRESS)
+		#define MMC_CACHE_BUFFER(Index)					((uint8_t*)FATFS_CACHE_ADDRESS + ((uint16_t)(Index) * SD_BLOCK_SIZE))
+	#else
+		static uint8_t __MMCCacheData[FATFS_CACHE_SECTORS][SD_BLOCK_SIZE];
+		#define MMC_CACHE_BUFFER(Index)					(__MMCCacheData[Index])
+	#endif
+
+	static MMC_CacheEntry_t __MMCCache[FATFS_CACHE_SECTORS];
+	static uint8_t __MMCCacheHand;
+	static DWORD __MMCCachePinStart;
+	static DWORD __MMCCachePinCount;
+	static FatFs_CacheStatistics_t __MMCCacheStatistics;
+#endif
+
+#if(defined SD_USE_DMA)
+	// Result of the last asynchronous transfer
+	static volatile SD_Error_t __MMCAsyncError;
+
+	/** @brief			Completion callback for the asynchronous SD card transfers.
+	 *  @param Error	Transfer result
+	 */
+	static void MMC_AsyncCallback(const SD_Error_t Error)
+	{
+		__MMCAsyncError = Error;
+	}
+#endif
+
 DSTATUS disk_initialize(
 	BYTE pdrv				/* Physical drive number to identify the drive */
 )
@@ -96,6 +137,332 @@ uint32_t get_fattime(void)
 	return 1555997382;
 }
 
+/** @brief			Read data blocks from the SD card.
+ *  @param Buffer	Pointer to data buffer
+ *  @param Sector	Start sector
+ *  @param Count	Number of sectors
+ *  @return			Result code
+ */
+static DRESULT MMC_Read(BYTE* Buffer, const DWORD Sector, const UINT Count)
+{
+	// Read a single block
+	if(Count == 1)
+	{
+		#if(defined SD_USE_DMA)
+			if(SD_ReadDataBlockAsync(Sector, Buffer, MMC_AsyncCallback) == SD_SUCCESSFULL)
+			{
+				while(SD_PollAsync() != SD_ASYNC_IDLE);
+
+				if(__MMCAsyncError == SD_SUCCESSFULL)
+				{
+					return RES_OK;
+				}
+			}
+		#else
+			if(SD_ReadDataBlock(Sector, Buffer) == SD_SUCCESSFULL)
+			{
+				return RES_OK;
+			}
+		#endif
+	}
+	// Read multiple blocks
+	else
+	{
+		if(SD_ReadDataBlocks(Sector, Count, Buffer) == SD_SUCCESSFULL)
+		{
+			return RES_OK;
+		}
+	}
+
+	return RES_ERROR;
+}
+
+/** @brief			Write data blocks to the SD card.
+ *  @param Buffer	Pointer to data buffer
+ *  @param Sector	Start sector
+ *  @param Count	Number of sectors
+ *  @return			Result code
+ */
+static DRESULT MMC_Write(const BYTE* Buffer, const DWORD Sector, const UINT Count)
+{
+	// Write a single block
+	if(Count == 1)
+	{
+		#if(defined SD_USE_DMA)
+			// Only wait until the data are transmitted. The card finishes the programming in the background
+			// and the next access or CTRL_SYNC waits for the card with a timeout.
+			if(SD_WriteDataBlockAsync(Sector, Buffer, MMC_AsyncCallback) == SD_SUCCESSFULL)
+			{
+				while(SD_PollAsync() == SD_ASYNC_TRANSFER);
+
+				if(__MMCAsyncError == SD_SUCCESSFULL)
+				{
+					return RES_OK;
+				}
+			}
+		#else
+			if(SD_WriteDataBlock(Sector, Buffer) == SD_SUCCESSFULL)
+			{
+				return RES_OK;
+			}
+		#endif
+	}
+	// Write multiple blocks
+	else
+	{
+		if(SD_WriteDataBlocks(Sector, Count, Buffer) == SD_SUCCESSFULL)
+		{
+			return RES_OK;
+		}
+	}
+
+	return RES_ERROR;
+}
+
+#if(defined FATFS_USE_CACHE)
+	/** @brief			Write a modified cache entry back to the SD card.
+	 *  @param Index	Cache entry
+	 *  @return			Result code
+	 */
+	static DRESULT MMC_CacheWriteBack(const uint8_t Index)
+	{
+		MMC_CacheEntry_t* Entry = &__MMCCache[Index];
+
+		if(Entry->Valid && Entry->Dirty)
+		{
+			if(MMC_Write(MMC_CACHE_BUFFER(Index), Entry->Sector, 1) != RES_OK)
+			{
+				return RES_ERROR;
+			}
+
+			Entry->Dirty = false;
+			__MMCCacheStatistics.WriteBacks++;
+		}
+
+		return RES_OK;
+	}
+
+	/** @brief			Write all modified cache entries back to the SD card.
+	 *  @return			Result code
+	 */
+	static DRESULT MMC_CacheFlush(void)
+	{
+		DRESULT Result = RES_OK;
+
+		for(uint8_t i = 0x00; i < FATFS_CACHE_SECTORS; i++)
+		{
+			if(MMC_CacheWriteBack(i) != RES_OK)
+			{
+				Result = RES_ERROR;
+			}
+		}
+
+		return Result;
+	}
+
+	/** @brief			Check if a sector is part of the pinned region.
+	 *  @param Sector	Sector
+	 *  @return			#true if the sector is pinned
+	 */
+	static bool MMC_CacheIsPinned(const DWORD Sector)
+	{
+		return (Sector >= __MMCCachePinStart) && ((Sector - __MMCCachePinStart) < __MMCCachePinCount);
+	}
+
+	/** @brief			Search a sector in the cache.
+	 *  @param Sector	Sector
+	 *  @return			Cache entry or #FATFS_CACHE_SECTORS if the sector is not cached
+	 */
+	static uint8_t MMC_CacheFind(const DWORD Sector)
+	{
+		for(uint8_t i = 0x00; i < FATFS_CACHE_SECTORS; i++)
+		{
+			if(__MMCCache[i].Valid && (__MMCCache[i].Sector == Sector))
+			{
+				return i;
+			}
+		}
+
+		return FATFS_CACHE_SECTORS;
+	}
+
+	/** @brief			Get a free cache entry for a new sector.
+	 *					NOTE: The entries are replaced with the second chance algorithm. Entries of the pinned region
+	 *					are only replaced if no other entry is available.
+	 *  @param Sector	Sector
+	 *  @param Index	Pointer to cache entry
+	 *  @return			Result code
+	 */
+	static DRESULT MMC_CacheAllocate(const DWORD Sector, uint8_t* Index)
+	{
+		uint8_t Victim = FATFS_CACHE_SECTORS;
+
+		// Two rounds clear all reference flags, so the third round finds an unpinned entry if there is one
+		for(uint16_t i = 0x00; i < (FATFS_CACHE_SECTORS * 0x03); i++)
+		{
+			MMC_CacheEntry_t* Entry = &__MMCCache[__MMCCacheHand];
+			uint8_t Current = __MMCCacheHand;
+
+			if(++__MMCCacheHand == FATFS_CACHE_SECTORS)
+			{
+				__MMCCacheHand = 0x00;
+			}
+
+			if(!Entry->Valid)
+			{
+				Victim = Current;
+				break;
+			}
+
+			if(Entry->Referenced)
+			{
+				Entry->Referenced = false;
+				continue;
+			}
+
+			if(!MMC_CacheIsPinned(Entry->Sector))
+			{
+				Victim = Current;
+				break;
+			}
+		}
+
+		// All entries are pinned
+		if(Victim == FATFS_CACHE_SECTORS)
+		{
+			Victim = __MMCCacheHand;
+		}
+
+		if(MMC_CacheWriteBack(Victim) != RES_OK)
+		{
+			return RES_ERROR;
+		}
+
+		__MMCCache[Victim].Valid = false;
+		__MMCCache[Victim].Sector = Sector;
+		*Index = Victim;
+
+		return RES_OK;
+	}
+
+	/** @brief			Read data blocks through the sector cache.
+	 *  @param Buffer	Pointer to data buffer
+	 *  @param Sector	Start sector
+	 *  @param Count	Number of sectors
+	 *  @return			Result code
+	 */
+	static DRESULT MMC_CacheRead(BYTE* Buffer, const DWORD Sector, const UINT Count)
+	{
+		// Multiple blocks are read from the SD card directly and patched with the modified cache entries
+		if(Count > 1)
+		{
+			if(MMC_Read(Buffer, Sector, Count) != RES_OK)
+			{
+				return RES_ERROR;
+			}
+
+			for(uint8_t i = 0x00; i < FATFS_CACHE_SECTORS; i++)
+			{
+				MMC_CacheEntry_t* Entry = &__MMCCache[i];
+
+				if(Entry->Valid && Entry->Dirty && (Entry->Sector >= Sector) && ((Entry->Sector - Sector) < Count))
+				{
+					memcpy(Buffer + ((Entry->Sector - Sector) * SD_BLOCK_SIZE), MMC_CACHE_BUFFER(i), SD_BLOCK_SIZE);
+				}
+			}
+
+			return RES_OK;
+		}
+
+		uint8_t Index = MMC_CacheFind(Sector);
+		if(Index < FATFS_CACHE_SECTORS)
+		{
+			__MMCCacheStatistics.Hits++;
+		}
+		else
+		{
+			__MMCCacheStatistics.Misses++;
+
+			if((MMC_CacheAllocate(Sector, &Index) != RES_OK) || (MMC_Read(MMC_CACHE_BUFFER(Index), Sector, 1) != RES_OK))
+			{
+				return RES_ERROR;
+			}
+
+			__MMCCache[Index].Valid = true;
+			__MMCCache[Index].Dirty = false;
+		}
+
+		__MMCCache[Index].Referenced = true;
+		memcpy(Buffer, MMC_CACHE_BUFFER(Index), SD_BLOCK_SIZE);
+
+		return RES_OK;
+	}
+
+	/** @brief			Write data blocks through the sector cache.
+	 *  @param Buffer	Pointer to data buffer
+	 *  @param Sector	Start sector
+	 *  @param Count	Number of sectors
+	 *  @return			Result code
+	 */
+	static DRESULT MMC_CacheWrite(const BYTE* Buffer, const DWORD Sector, const UINT Count)
+	{
+		// Multiple blocks are written to the SD card directly and replace the cache entries
+		if(Count > 1)
+		{
+			for(uint8_t i = 0x00; i < FATFS_CACHE_SECTORS; i++)
+			{
+				MMC_CacheEntry_t* Entry = &__MMCCache[i];
+
+				if(Entry->Valid && (Entry->Sector >= Sector) && ((Entry->Sector - Sector) < Count))
+				{
+					Entry->Valid = false;
+				}
+			}
+
+			return MMC_Write(Buffer, Sector, Count);
+		}
+
+		// A whole sector is written, so the sector doesn't have to be read from the card
+		uint8_t Index = MMC_CacheFind(Sector);
+		if(Index < FATFS_CACHE_SECTORS)
+		{
+			__MMCCacheStatistics.Hits++;
+		}
+		else
+		{
+			__MMCCacheStatistics.Misses++;
+
+			if(MMC_CacheAllocate(Sector, &Index) != RES_OK)
+			{
+				return RES_ERROR;
+			}
+		}
+
+		memcpy(MMC_CACHE_BUFFER(Index), Buffer, SD_BLOCK_SIZE);
+		__MMCCache[Index].Valid = true;
+		__MMCCache[Index].Dirty = true;
+		__MMCCache[Index].Referenced = true;
+
+		return RES_OK;
+	}
+
+	void FatFs_CachePin(const uint32_t Sector, const uint32_t Count)
+	{
+		__MMCCachePinStart = Sector;
+		__MMCCachePinCount = Count;
+	}
+
+	void FatFs_GetCacheStatistics(FatFs_CacheStatistics_t* Statistics)
+	{
+		*Statistics = __MMCCacheStatistics;
+	}
+
+	void FatFs_ResetCacheStatistics(void)
+	{
+		memset(&__MMCCacheStatistics, 0x00, sizeof(FatFs_CacheStatistics_t));
+	}
+#endif
+
 DRESULT disk_read (
 	BYTE pdrv,		/* Physical drive number to identify the drive */
 	BYTE *buff,		/* Data buffer to store read data */
@@ -111,25 +478,12 @@ DRESULT disk_read (
 			{
 				return RES_NOTRDY;
 			}
-			
-			// Read a single block
-			if(count == 1)
-			{
-				if(SD_ReadDataBlock(sector, buff) == SD_SUCCESSFULL)
-				{
-					return RES_OK;
-				}
-			}
-			// Read multiple blocks
-			else
-			{
-				if(SD_ReadDataBlocks(sector, count, buff) == SD_SUCCESSFULL)
-				{
-					return RES_OK;
-				}
-			}
-			
-			return RES_ERROR;
+
+			#if(defined FATFS_USE_CACHE)
+				return MMC_CacheRead(buff, sector, count);
+			#else
+				return MMC_Read(buff, sector, count);
+			#endif
 		}
 		case DEV_USB:
 		{
@@ -155,25 +509,12 @@ DRESULT disk_write(
 			{
 				return RES_NOTRDY;
 			}
-			
-			// Write a single block
-			if(count == 1)
-			{
-				if(SD_WriteDataBlock(sector, buff) == SD_SUCCESSFULL)
-				{
-					return RES_OK;
-				}
-			}
-			// Write multiple blocks
-			else
-			{
-				if(SD_WriteDataBlocks(sector, count, buff) == SD_SUCCESSFULL)
-				{
-					return RES_OK;
-				}
-			}
-			
-			return RES_ERROR;
+
+			#if(defined FATFS_USE_CACHE)
+				return MMC_CacheWrite(buff, sector, count);
+			#else
+				return MMC_Write(buff, sector, count);
+			#endif
 		}
 		case DEV_USB:
 		{
@@ -226,7 +567,17 @@ DRESULT disk_ioctl (
 				}
 				case CTRL_SYNC:
 				{
-					SD_Sync();
+					#if(defined FATFS_USE_CACHE)
+						if(MMC_CacheFlush() != RES_OK)
+						{
+							return RES_ERROR;
+						}
+					#endif
+
+					if(SD_Sync() != SD_SUCCESSFULL)
+					{
+						return RES_ERROR;
+					}
 
 					return RES_OK;
 				}
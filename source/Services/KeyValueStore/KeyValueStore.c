@@ -0,0 +1,413 @@
+/*
+ * KeyValueStore.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Wear leveled key/value store for the XMega EEPROM.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Services/KeyValueStore/KeyValueStore.c
+ *  @brief Wear leveled key/value store for the XMega EEPROM.
+ *
+ *  This file contains the implementation for the key/value store.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <string.h>
+#include <util/crc16.h>
+
+#include "Services/KeyValueStore/KeyValueStore.h"
+
+/** @brief	Address for a key without a record.
+ */
+#define KVS_NO_ADDRESS							0xFFFF
+
+/** @brief	Key of an erased EEPROM cell.
+ */
+#define KVS_EMPTY								0xFF
+
+/** @brief	Index entry for a key.
+ */
+typedef struct
+{
+	uint16_t Address;											/**< EEPROM address of the newest record */
+	uint16_t Sequence;											/**< Sequence number of the newest record */
+} KeyValueStore_Entry_t;
+
+static KeyValueStore_Entry_t _KVS_Index[KVS_MAX_KEYS];
+static uint8_t _KVS_Head;
+static uint8_t _KVS_Offset;
+static uint16_t _KVS_Sequence;
+static uint8_t _KVS_Record[EEPROM_PAGE_SIZE];
+
+/** @brief			Get the next page of the ring buffer.
+ *  @param Page		Page in the ring buffer
+ *  @return			Next page
+ */
+static uint8_t KeyValueStore_Next(const uint8_t Page)
+{
+	return (Page == (KVS_PAGES - 0x01)) ? 0x00 : (Page + 0x01);
+}
+
+/** @brief			Check if a sequence number is newer than another sequence number.
+ *  @param A		Sequence number
+ *  @param B		Sequence number
+ *  @return			#true when A is newer than B
+ */
+static bool KeyValueStore_IsNewer(const uint16_t A, const uint16_t B)
+{
+	return (int16_t)(A - B) > 0x00;
+}
+
+/** @brief			Check if a page is erased.
+ *  @param Page		Page in the ring buffer
+ *  @param Offset	First byte to check
+ *  @return			#true when erased
+ */
+static bool KeyValueStore_IsErased(const uint8_t Page, const uint8_t Offset)
+{
+	for(uint8_t i = Offset; i < EEPROM_PAGE_SIZE; i++)
+	{
+		if(NVM_EEPROMReadByte(KVS_FIRST_PAGE + Page, i) != 0xFF)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** @brief			Read a record into the record buffer and check it.
+ *  @param Page		Page in the ring buffer
+ *  @param Offset	Page offset
+ *  @return			Size of the record or 0 for an empty or invalid record
+ */
+static uint8_t KeyValueStore_ReadRecord(const uint8_t Page, const uint8_t Offset)
+{
+	uint8_t CRC = 0x00;
+
+	if((Offset + KVS_HEADER_BYTES) >= EEPROM_PAGE_SIZE)
+	{
+		return 0x00;
+	}
+
+	for(uint8_t i = 0x00; i < KVS_HEADER_BYTES; i++)
+	{
+		_KVS_Record[i] = NVM_EEPROMReadByte(KVS_FIRST_PAGE + Page, Offset + i);
+	}
+
+	uint8_t Size = KVS_HEADER_BYTES + _KVS_Record[1] + 0x01;
+
+	if((_KVS_Record[0] >= KVS_MAX_KEYS) || (_KVS_Record[1] > KVS_MAX_LENGTH) || ((Offset + Size) > EEPROM_PAGE_SIZE))
+	{
+		return 0x00;
+	}
+
+	for(uint8_t i = KVS_HEADER_BYTES; i < Size; i++)
+	{
+		_KVS_Record[i] = NVM_EEPROMReadByte(KVS_FIRST_PAGE + Page, Offset + i);
+	}
+
+	for(uint8_t i = 0x00; i < Size; i++)
+	{
+		CRC = _crc8_ccitt_update(CRC, _KVS_Record[i]);
+	}
+
+	// The CRC over the complete record including the CRC is zero for a valid record
+	if(CRC != 0x00)
+	{
+		return 0x00;
+	}
+
+	return Size;
+}
+
+/** @brief			Write a new record into the current page.
+					NOTE: The record must fit into the current page.
+ *  @param Key		Key
+ *  @param Length	Length of the value
+ *  @param Data		Pointer to value
+ */
+static void KeyValueStore_Program(const uint8_t Key, const uint8_t Length, const uint8_t* Data)
+{
+	uint8_t CRC = 0x00;
+	uint8_t Size = KVS_HEADER_BYTES + Length + 0x01;
+
+	// The data can be stored in the record buffer already
+	if((Length > 0x00) && (Data != &_KVS_Record[KVS_HEADER_BYTES]))
+	{
+		memcpy(&_KVS_Record[KVS_HEADER_BYTES], Data, Length);
+	}
+
+	_KVS_Record[0] = Key;
+	_KVS_Record[1] = Length;
+	_KVS_Record[2] = _KVS_Sequence & 0xFF;
+	_KVS_Record[3] = _KVS_Sequence >> 0x08;
+
+	for(uint8_t i = 0x00; i < (Size - 0x01); i++)
+	{
+		CRC = _crc8_ccitt_update(CRC, _KVS_Record[i]);
+	}
+
+	_KVS_Record[Size - 0x01] = CRC;
+
+	// Write the key at last. An interrupted write leaves an erased key and the record is never used
+	NVM_EEPROMWriteBytes(KVS_FIRST_PAGE + _KVS_Head, _KVS_Offset + 0x01, Size - 0x01, &_KVS_Record[1]);
+	NVM_EEPROMWriteBytes(KVS_FIRST_PAGE + _KVS_Head, _KVS_Offset, 0x01, _KVS_Record);
+
+	_KVS_Index[Key].Address = (_KVS_Head * EEPROM_PAGE_SIZE) + _KVS_Offset;
+	_KVS_Index[Key].Sequence = _KVS_Sequence++;
+	_KVS_Offset += Size;
+}
+
+/** @brief			Copy the valid records of a page into the current page and erase the page.
+ *  @param Page		Page in the ring buffer
+ */
+static void KeyValueStore_Collect(const uint8_t Page)
+{
+	uint8_t Offset = 0x00;
+	uint8_t Size;
+
+	while((Size = KeyValueStore_ReadRecord(Page, Offset)) != 0x00)
+	{
+		uint8_t Key = _KVS_Record[0];
+
+		// Only the newest record of a key is copied. A deleted key doesn't need a record anymore
+		if(_KVS_Index[Key].Address == ((Page * EEPROM_PAGE_SIZE) + Offset))
+		{
+			if(_KVS_Record[1] == 0x00)
+			{
+				_KVS_Index[Key].Address = KVS_NO_ADDRESS;
+			}
+			else if((_KVS_Offset + Size) <= EEPROM_PAGE_SIZE)
+			{
+				KeyValueStore_Program(Key, _KVS_Record[1], &_KVS_Record[KVS_HEADER_BYTES]);
+			}
+		}
+
+		Offset += Size;
+	}
+
+	NVM_EEPROMErasePage(KVS_FIRST_PAGE + Page);
+}
+
+/** @brief			Write a new record and move to the next page when the current page is full.
+ *  @param Key		Key
+ *  @param Length	Length of the value
+ *  @param Data		Pointer to value
+ *  @return			Error code
+ */
+static KeyValueStore_Error_t KeyValueStore_Append(const uint8_t Key, const uint8_t Length, const uint8_t* Data)
+{
+	uint8_t Size = KVS_HEADER_BYTES + Length + 0x01;
+
+	for(uint8_t i = 0x00; (_KVS_Offset + Size) > EEPROM_PAGE_SIZE; i++)
+	{
+		// All pages are full with valid records
+		if(i == KVS_PAGES)
+		{
+			return KVS_FULL;
+		}
+
+		// The next page is always erased. Free the page behind the next page for the next move
+		_KVS_Head = KeyValueStore_Next(_KVS_Head);
+		_KVS_Offset = 0x00;
+		KeyValueStore_Collect(KeyValueStore_Next(_KVS_Head));
+	}
+
+	KeyValueStore_Program(Key, Length, Data);
+
+	return KVS_NO_ERROR;
+}
+
+void KeyValueStore_Format(void)
+{
+	for(uint8_t i = 0x00; i < KVS_PAGES; i++)
+	{
+		NVM_EEPROMErasePage(KVS_FIRST_PAGE + i);
+	}
+
+	KeyValueStore_Init();
+}
+
+void KeyValueStore_Init(void)
+{
+	bool Retry;
+
+	do
+	{
+		bool Empty = true;
+		uint8_t Size;
+
+		Retry = false;
+		_KVS_Head = 0x00;
+		_KVS_Sequence = 0x00;
+
+		for(uint8_t i = 0x00; i < KVS_MAX_KEYS; i++)
+		{
+			_KVS_Index[i].Address = KVS_NO_ADDRESS;
+		}
+
+		// Build the index and search the page with the newest record
+		for(uint8_t Page = 0x00; Page < KVS_PAGES; Page++)
+		{
+			uint8_t Offset = 0x00;
+
+			while((Size = KeyValueStore_ReadRecord(Page, Offset)) != 0x00)
+			{
+				uint8_t Key = _KVS_Record[0];
+				uint16_t Sequence = _KVS_Record[2] | (_KVS_Record[3] << 0x08);
+
+				if((_KVS_Index[Key].Address == KVS_NO_ADDRESS) || KeyValueStore_IsNewer(Sequence, _KVS_Index[Key].Sequence))
+				{
+					_KVS_Index[Key].Address = (Page * EEPROM_PAGE_SIZE) + Offset;
+					_KVS_Index[Key].Sequence = Sequence;
+				}
+
+				if(Empty || KeyValueStore_IsNewer(Sequence, _KVS_Sequence))
+				{
+					Empty = false;
+					_KVS_Head = Page;
+					_KVS_Sequence = Sequence;
+				}
+
+				Offset += Size;
+			}
+		}
+
+		if(!Empty)
+		{
+			_KVS_Sequence++;
+		}
+
+		// Get the end of the records in the current page
+		_KVS_Offset = 0x00;
+		while((Size = KeyValueStore_ReadRecord(_KVS_Head, _KVS_Offset)) != 0x00)
+		{
+			_KVS_Offset += Size;
+		}
+
+		// An interrupted write leaves a broken record. The rest of the page can not be used without an erase
+		bool Broken = !KeyValueStore_IsErased(_KVS_Head, _KVS_Offset);
+		if(Broken)
+		{
+			_KVS_Offset = EEPROM_PAGE_SIZE;
+		}
+
+		// The page behind the current page isn't erased when the move to a new page was interrupted
+		uint8_t Next = KeyValueStore_Next(_KVS_Head);
+		if(!KeyValueStore_IsErased(Next, 0x00))
+		{
+			if(Broken && (KeyValueStore_ReadRecord(Next, 0x00) != 0x00))
+			{
+				// The copy of the valid records was interrupted. The old page still contains all records
+				NVM_EEPROMErasePage(KVS_FIRST_PAGE + _KVS_Head);
+				Retry = true;
+			}
+			else
+			{
+				// Finish the copy or remove the broken first record of a new page
+				KeyValueStore_Collect(Next);
+			}
+		}
+	} while(Retry);
+}
+
+KeyValueStore_Error_t KeyValueStore_Write(const uint8_t Key, const uint8_t Length, const void* Data)
+{
+	if((Key >= KVS_MAX_KEYS) || (Length == 0x00) || (Length > KVS_MAX_LENGTH) || (Data == NULL))
+	{
+		return KVS_INVALID_PARAM;
+	}
+
+	// Skip the write when the value doesn't change
+	if(_KVS_Index[Key].Address != KVS_NO_ADDRESS)
+	{
+		uint8_t Page = _KVS_Index[Key].Address / EEPROM_PAGE_SIZE;
+		uint8_t Offset = _KVS_Index[Key].Address % EEPROM_PAGE_SIZE;
+
+		if((NVM_EEPROMReadByte(KVS_FIRST_PAGE + Page, Offset + 0x01) == Length))
+		{
+			uint8_t i = 0x00;
+
+			while((i < Length) && (NVM_EEPROMReadByte(KVS_FIRST_PAGE + Page, Offset + KVS_HEADER_BYTES + i) == ((const uint8_t*)Data)[i]))
+			{
+				i++;
+			}
+
+			if(i == Length)
+			{
+				return KVS_NO_ERROR;
+			}
+		}
+	}
+
+	return KeyValueStore_Append(Key, Length, Data);
+}
+
+KeyValueStore_Error_t KeyValueStore_Read(const uint8_t Key, uint8_t* Length, void* Data)
+{
+	if((Key >= KVS_MAX_KEYS) || (Length == NULL) || (Data == NULL))
+	{
+		return KVS_INVALID_PARAM;
+	}
+
+	if(_KVS_Index[Key].Address == KVS_NO_ADDRESS)
+	{
+		return KVS_NOT_FOUND;
+	}
+
+	uint8_t Page = _KVS_Index[Key].Address / EEPROM_PAGE_SIZE;
+	uint8_t Offset = _KVS_Index[Key].Address % EEPROM_PAGE_SIZE;
+	uint8_t Stored = NVM_EEPROMReadByte(KVS_FIRST_PAGE + Page, Offset + 0x01);
+
+	// A record without data marks a deleted key
+	if(Stored == 0x00)
+	{
+		return KVS_NOT_FOUND;
+	}
+
+	if(Stored < *Length)
+	{
+		*Length = Stored;
+	}
+
+	for(uint8_t i = 0x00; i < *Length; i++)
+	{
+		((uint8_t*)Data)[i] = NVM_EEPROMReadByte(KVS_FIRST_PAGE + Page, Offset + KVS_HEADER_BYTES + i);
+	}
+
+	return KVS_NO_ERROR;
+}
+
+KeyValueStore_Error_t KeyValueStore_Delete(const uint8_t Key)
+{
+	if(Key >= KVS_MAX_KEYS)
+	{
+		return KVS_INVALID_PARAM;
+	}
+
+	if((_KVS_Index[Key].Address == KVS_NO_ADDRESS) || (NVM_EEPROMReadByte(KVS_FIRST_PAGE + (_KVS_Index[Key].Address / EEPROM_PAGE_SIZE), (_KVS_Index[Key].Address % EEPROM_PAGE_SIZE) + 0x01) == 0x00))
+	{
+		return KVS_NOT_FOUND;
+	}
+
+	return KeyValueStore_Append(Key, 0x00, NULL);
+}
\ No newline at end of file
@@ -0,0 +1,478 @@
+/*
+ * BinaryTest.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host test for the binary format of the AVR bootloader.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file BinaryTest.c
+ *  @brief Host test for the binary format of the AVR bootloader.
+ *
+ *  The test transmits an image with a windowed sender to the bootloader and compares the flash memory of the model with
+ *  the image. The sender repeats the packets after a repeat request or a timeout like the host software. Usage:
+ *
+ *		BinaryTest <Image.hex>
+ *		BinaryTest <Image.hex> <Image.lz>								(BOOTLOADER_USE_COMPRESSION)
+ *		BinaryTest <Update.hex> <Update.patch> <Application.hex>		(BOOTLOADER_USE_DELTA)
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <util/crc16.h>
+
+#include "Bootloader/Bootloader.h"
+
+#include "BootloaderModel.h"
+
+/** @brief	Maximum number of packets for one image.
+ */
+#define TEST_MAX_PACKETS				0x800
+
+/** @brief	Sender timeout in nanoseconds.
+ */
+#define TEST_SENDER_TIMEOUT				2000000000ULL
+
+/** @brief Packet with the bytes on the line.
+ */
+typedef struct
+{
+	uint8_t* Data;
+	uint16_t Length;
+} Test_Packet_t;
+
+/** @brief Error injection for a test case.
+ */
+typedef struct
+{
+	const char* Name;										/**< Name of the test case */
+	uint32_t PageTime;										/**< Page erase and write time in nanoseconds */
+	uint16_t CorruptEvery;									/**< Corrupt every n-th transmitted packet */
+	uint16_t DropEvery;										/**< Drop one byte of every n-th transmitted packet */
+	uint16_t LoseEvery;										/**< Lose every n-th response */
+	bool BadBase;											/**< Send the base packet with a wrong CRC */
+	bool BadImage;											/**< Send the end packet with a wrong CRC */
+} Test_Case_t;
+
+static Test_Packet_t _Packets[TEST_MAX_PACKETS];
+static uint16_t _PacketCount;
+
+static uint8_t _Image[APP_SECTION_SIZE];
+static uint32_t _ImageLength;
+
+#if(defined BOOTLOADER_USE_DELTA)
+	static uint8_t _Application[APP_SECTION_SIZE];
+	static uint32_t _ApplicationLength;
+#endif
+
+/** @brief	State of the sender.
+ */
+static const Test_Case_t* _Case;
+static uint16_t _Base;
+static uint16_t _Next;
+static uint16_t _Sent;
+static uint16_t _Position;
+static uint16_t _Rewind;
+static bool _RewindPending;
+static bool _Started;
+static bool _Error;
+static uint8_t _Response[2];
+static uint8_t _ResponseBytes;
+static uint64_t _LastResponse;
+static uint32_t _Repeated;
+static uint32_t _Responses;
+static uint32_t _Requests;
+static uint32_t _Timeouts;
+static uint8_t _Current[PARSER_MAX_DATA_BYTES + 8];
+static uint16_t _CurrentLength;
+
+/** @brief			Create a packet with the bytes on the line.
+ *  @param Type		Start byte
+ *  @param Page		Page address
+ *  @param Data		Pointer to data bytes
+ *  @param Length	Data byte count
+ */
+static void Test_AddPacket(const uint8_t Type, const uint16_t Page, const uint8_t* Data, const uint16_t Length)
+{
+	uint8_t* Packet = malloc(Length + 8);
+	uint16_t CRC = 0x00;
+
+	Packet[0] = Type;
+	Packet[1] = _PacketCount & 0xFF;
+	Packet[2] = Page & 0xFF;
+	Packet[3] = Page >> 0x08;
+	Packet[4] = Length & 0xFF;
+	Packet[5] = Length >> 0x08;
+	memcpy(&Packet[6], Data, Length);
+
+	for(uint16_t i = 0x01; i < (Length + 6); i++)
+	{
+		CRC = _crc_xmodem_update(CRC, Packet[i]);
+	}
+
+	Packet[Length + 6] = CRC & 0xFF;
+	Packet[Length + 7] = CRC >> 0x08;
+
+	_Packets[_PacketCount].Data = Packet;
+	_Packets[_PacketCount++].Length = Length + 8;
+}
+
+/** @brief			Create the end or the base packet with the length and the CRC-32 of an image.
+ *  @param Type		Start byte
+ *  @param Image	Pointer to image
+ *  @param Length	Image length
+ *  @param Invalid	#true to send a wrong CRC
+ */
+static void Test_AddCheck(const uint8_t Type, const uint8_t* Image, const uint32_t Length, const bool Invalid)
+{
+	uint8_t Data[PARSER_END_DATA_BYTES];
+	uint32_t CRC = Model_CRC32(Image, Length) ^ (Invalid ? 0x01 : 0x00);
+
+	memcpy(&Data[0], &Length, sizeof(Length));
+	memcpy(&Data[4], &CRC, sizeof(CRC));
+	Test_AddPacket(Type, 0x00, Data, sizeof(Data));
+}
+
+/** @brief			Create the packets for a test case.
+ *  @param Data		Pointer to compressed image or patch file
+ *  @param Length	Length of the file
+ *  @param Case		Pointer to test case
+ */
+static void Test_CreatePackets(const uint8_t* Data, const uint32_t Length, const Test_Case_t* Case)
+{
+	while(_PacketCount)
+	{
+		free(_Packets[--_PacketCount].Data);
+	}
+
+	#if(defined BOOTLOADER_USE_COMPRESSION)
+		// The compressed image is split into packets of any size
+		for(uint32_t i = 0x00; i < Length; i += PARSER_MAX_DATA_BYTES)
+		{
+			Test_AddPacket(PARSER_PACKET_DATA, 0x00, &Data[i], ((Length - i) < PARSER_MAX_DATA_BYTES) ? (Length - i) : PARSER_MAX_DATA_BYTES);
+		}
+	#elif(defined BOOTLOADER_USE_DELTA)
+		Test_AddCheck(PARSER_PACKET_BASE, _Application, _ApplicationLength, Case->BadBase);
+
+		// Each record of the patch file contains the patch for one page
+		for(uint32_t i = 0x00; (i + 4) <= Length; )
+		{
+			uint16_t Page = Data[i] | (Data[i + 1] << 0x08);
+			uint16_t Size = Data[i + 2] | (Data[i + 3] << 0x08);
+
+			Test_AddPacket(PARSER_PACKET_DATA, Page, &Data[i + 4], Size);
+			i += Size + 4;
+		}
+	#else
+		for(uint32_t i = 0x00; i < _ImageLength; i += APP_SECTION_PAGE_SIZE)
+		{
+			Test_AddPacket(PARSER_PACKET_DATA, i / APP_SECTION_PAGE_SIZE, &_Image[i], ((_ImageLength - i) < APP_SECTION_PAGE_SIZE) ? (_ImageLength - i) : APP_SECTION_PAGE_SIZE);
+		}
+	#endif
+
+	Test_AddCheck(PARSER_PACKET_END, _Image, _ImageLength, Case->BadImage);
+}
+
+/** @brief			Get the packet index for a sequence number.
+ *  @param Sequence	Sequence number
+ *  @return			Packet index next to the oldest unacknowledged packet
+ */
+static uint16_t Test_GetIndex(const uint8_t Sequence)
+{
+	int32_t Index = (_Base & ~0xFF) | Sequence;
+
+	if(Index > (_Base + 0x80))
+	{
+		Index -= 0x100;
+	}
+	else if(Index < (_Base - 0x80))
+	{
+		Index += 0x100;
+	}
+
+	return (Index < 0x00) ? 0x00 : Index;
+}
+
+static bool Test_Transmit(uint8_t* Data)
+{
+	if(!_Started || _Error)
+	{
+		return false;
+	}
+
+	if(_Position == _CurrentLength)
+	{
+		_Position = 0x00;
+		_CurrentLength = 0x00;
+
+		// Repeat the packets after a repeat request or when the bootloader doesn't respond
+		if(_RewindPending)
+		{
+			_Next = _Rewind;
+			_RewindPending = false;
+		}
+		else if((_Next > _Base) && ((Model_GetTime() - _LastResponse) > TEST_SENDER_TIMEOUT))
+		{
+			_Next = _Base;
+			_LastResponse = Model_GetTime();
+			_Timeouts++;
+		}
+
+		if((_Next >= _PacketCount) || (_Next >= (_Base + BOOTLOADER_WINDOW)))
+		{
+			return false;
+		}
+
+		#if(defined BOOTLOADER_USE_DELTA)
+			// Wait for the check of the installed application
+			if((_Next > 0x00) && (_Base == 0x00))
+			{
+				return false;
+			}
+		#endif
+
+		memcpy(_Current, _Packets[_Next].Data, _Packets[_Next].Length);
+		_CurrentLength = _Packets[_Next].Length;
+
+		if(_Next < _Sent)
+		{
+			_Repeated++;
+		}
+		else
+		{
+			_Sent = _Next + 1;
+		}
+
+		if(_Case->CorruptEvery && (((_Sent + _Repeated) % _Case->CorruptEvery) == 0x00))
+		{
+			_Current[_CurrentLength / 2] ^= 0x5A;
+		}
+		else if(_Case->DropEvery && (((_Sent + _Repeated) % _Case->DropEvery) == 0x00))
+		{
+			memmove(&_Current[_CurrentLength / 2], &_Current[(_CurrentLength / 2) + 1], _CurrentLength - (_CurrentLength / 2) - 1);
+			_CurrentLength--;
+		}
+
+		_Next++;
+	}
+
+	*Data = _Current[_Position++];
+
+	return true;
+}
+
+static void Test_Receive(const uint8_t Data)
+{
+	// Wait for the end of the message from the bootloader
+	if(!_Started)
+	{
+		_Started = (Data == '\r');
+		_LastResponse = Model_GetTime();
+
+		return;
+	}
+
+	_Response[_ResponseBytes++] = Data;
+	if(_ResponseBytes < 2)
+	{
+		return;
+	}
+
+	// The bootloader doesn't repeat the response to the end packet
+	_ResponseBytes = 0x00;
+	if(_Case->LoseEvery && ((_Base + 1) < _PacketCount) && ((++_Responses % _Case->LoseEvery) == 0x00))
+	{
+		return;
+	}
+
+	_LastResponse = Model_GetTime();
+
+	if(_Response[0] == PARSER_ACK)
+	{
+		uint16_t Index = Test_GetIndex(_Response[1]);
+
+		if(Index >= _Base)
+		{
+			_Base = Index + 1;
+		}
+
+		if(_Next < _Base)
+		{
+			_Next = _Base;
+		}
+	}
+	else if(_Response[0] == PARSER_NAK)
+	{
+		// Finish the current packet and repeat the requested packet
+		_Rewind = Test_GetIndex(_Response[1]);
+		_RewindPending = true;
+		_Requests++;
+	}
+	else if(_Response[0] == PARSER_ERROR)
+	{
+		_Error = true;
+	}
+}
+
+/** @brief			Run a test case and compare the flash memory with the image.
+ *  @param Case		Pointer to test case
+ *  @param Data		Pointer to compressed image or patch file
+ *  @param Length	Length of the file
+ *  @return			#true when the test is passed
+ */
+static bool Test_Run(const Test_Case_t* Case, const uint8_t* Data, const uint32_t Length)
+{
+	Model_Config_t Config = {
+		.ByteTime = 1000000000ULL * 10 / BOOTLOADER_BAUD,
+		.AccessTime = 5000,
+		.PageTime = Case->PageTime,
+		.TimeLimit = 600000000000ULL,
+	};
+	Model_Sender_t Sender = {
+		.Transmit = Test_Transmit,
+		.Receive = Test_Receive,
+	};
+	bool Result = false;
+	bool Passed;
+
+	Test_CreatePackets(Data, Length, Case);
+
+	_Case = Case;
+	_Base = 0x00;
+	_Next = 0x00;
+	_Sent = 0x00;
+	_Position = 0x00;
+	_CurrentLength = 0x00;
+	_RewindPending = false;
+	_Started = false;
+	_Error = false;
+	_ResponseBytes = 0x00;
+	_Repeated = 0x00;
+	_Responses = 0x00;
+	_Requests = 0x00;
+	_Timeouts = 0x00;
+
+	Model_Init(&Config, &Sender);
+
+	#if(defined BOOTLOADER_USE_DELTA)
+		memcpy(Model_GetFlash(), _Application, _ApplicationLength);
+	#endif
+
+	Bootloader_Init();
+
+	if(!Model_Run(Bootloader_Enter, &Result))
+	{
+		printf("    Time limit reached\n");
+	}
+
+	const Model_Statistics_t* Statistics = Model_GetStatistics();
+	bool Equal = !memcmp(Model_GetFlash(), _Image, _ImageLength);
+	uint32_t Pages = (_ImageLength + APP_SECTION_PAGE_SIZE - 1) / APP_SECTION_PAGE_SIZE;
+
+	// The rest of the last page must contain the erased value
+	for(uint32_t i = _ImageLength; i < (Pages * APP_SECTION_PAGE_SIZE); i++)
+	{
+		Equal &= (Model_GetFlash()[i] == 0xFF);
+	}
+
+	if(Case->BadBase || Case->BadImage)
+	{
+		Passed = !Result && _Error;
+	}
+	else
+	{
+		Passed = Result && Equal && (_Base == _PacketCount) && !Statistics->Overruns && !Statistics->Violations;
+
+		#if(defined BOOTLOADER_USE_DELTA)
+			// Unchanged pages must not be written
+			Passed &= (Statistics->PageWrites <= (_PacketCount - 2));
+		#endif
+
+		// Without transmission errors each packet must be transmitted only once
+		if(!Case->CorruptEvery && !Case->DropEvery && !Case->LoseEvery)
+		{
+			Passed &= (_Repeated == 0x00);
+		}
+	}
+
+	printf("%-26s %s  %7.1f ms  %6.1f kB/s  %3u pages  %4u packets  %3u repeated  %3u requests  %u timeouts\n", Case->Name,
+		   Passed ? "OK  " : "FAIL", Model_GetTime() / 1e6, _ImageLength / (Model_GetTime() / 1e9) / 1000.0,
+		   Statistics->PageWrites, _PacketCount, _Repeated, _Requests, _Timeouts);
+
+	return Passed;
+}
+
+int main(int argc, char** argv)
+{
+	uint8_t* Data = NULL;
+	uint32_t Length = 0x00;
+	uint32_t PacketTime = 1000000000ULL * 10 * (APP_SECTION_PAGE_SIZE + 8) / BOOTLOADER_BAUD;
+	bool Passed = true;
+
+	const Test_Case_t Cases[] = {
+		{ .Name = "Transfer", .PageTime = 8000000 },
+		{ .Name = "Slow flash", .PageTime = 3 * PacketTime },
+		{ .Name = "Corrupted packets", .PageTime = 8000000, .CorruptEvery = 7 },
+		{ .Name = "Incomplete packets", .PageTime = 8000000, .DropEvery = 9 },
+		{ .Name = "Lost responses", .PageTime = 8000000, .LoseEvery = 5 },
+		{ .Name = "Wrong image CRC", .PageTime = 8000000, .BadImage = true },
+		#if(defined BOOTLOADER_USE_DELTA)
+			{ .Name = "Wrong base application", .PageTime = 8000000, .BadBase = true },
+		#endif
+	};
+
+	_ImageLength = (argc > 1) ? Model_ReadHex(argv[1], _Image) : 0x00;
+
+	#if((defined BOOTLOADER_USE_COMPRESSION) || (defined BOOTLOADER_USE_DELTA))
+		Data = (argc > 2) ? Model_ReadFile(argv[2], &Length) : NULL;
+		if(Data == NULL)
+		{
+			_ImageLength = 0x00;
+		}
+	#endif
+
+	#if(defined BOOTLOADER_USE_DELTA)
+		_ApplicationLength = (argc > 3) ? Model_ReadHex(argv[3], _Application) : 0x00;
+		if(_ApplicationLength == 0x00)
+		{
+			_ImageLength = 0x00;
+		}
+	#endif
+
+	if(_ImageLength == 0x00)
+	{
+		printf("Can not read the input files!\n");
+
+		return -1;
+	}
+
+	printf("Image: %u bytes, %u bytes transmitted\n", _ImageLength, Data ? Length : _ImageLength);
+
+	for(uint8_t i = 0x00; i < (sizeof(Cases) / sizeof(Cases[0])); i++)
+	{
+		Passed &= Test_Run(&Cases[i], Data, Length);
+	}
+
+	free(Data);
+
+	return Passed ? 0 : -1;
+}
\ No newline at end of file
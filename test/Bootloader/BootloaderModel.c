@@ -0,0 +1,521 @@
+/*
+ * BootloaderModel.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: USART and flash model for the host tests of the AVR bootloader.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file BootloaderModel.c
+ *  @brief USART and flash model for the host tests of the AVR bootloader.
+ *
+ *  This file contains the implementation of the USART and flash model for the host tests of the AVR bootloader.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "BootloaderModel.h"
+
+/** @brief	Marker for an unchanged data register.
+ */
+#define MODEL_DATA_EMPTY				0x8000
+
+/** @brief States for the detection of a data register read.
+ */
+typedef enum
+{
+	MODEL_IDLE = 0x00,										/**< The receive flag wasn't shown */
+	MODEL_FLAG = 0x01,										/**< The receive flag was shown with the last access */
+	MODEL_READ = 0x02,										/**< The last access can be a read of the data register */
+} Model_State_t;
+
+static Model_Config_t _Config;
+static Model_Sender_t _Sender;
+static Model_Statistics_t _Statistics;
+static Model_State_t _State;
+
+static USART_t _USART;
+static NVM_t _NVM;
+static jmp_buf _Abort;
+
+/** @brief	Simulated time in nanoseconds.
+ */
+static uint64_t _Time;
+
+/** @brief	Receive buffer and the byte in the receive shift register.
+ */
+static uint8_t _RxFifo[MODEL_RX_FIFO_SIZE];
+static uint8_t _RxCount;
+static uint8_t _RxData;
+static uint64_t _RxEnd;
+
+/** @brief	Transmit data register and the byte in the transmit shift register.
+ */
+static uint8_t _TxBuffer;
+static bool _TxBufferFull;
+static uint8_t _TxData;
+static uint64_t _TxEnd;
+
+/** @brief	Application section, NVM page buffer and end of the running page write.
+ */
+static uint8_t _Flash[APP_SECTION_SIZE];
+static uint8_t _PageBuffer[APP_SECTION_PAGE_SIZE];
+static bool _WordLoaded[APP_SECTION_PAGE_SIZE / 2];
+static uint64_t _FlashBusy;
+
+/** @brief			Report a wrong usage of the NVM controller.
+ *  @param Message	Error message
+ */
+static void Model_Violation(const char* Message)
+{
+	if(_Statistics.Violations++ < 10)
+	{
+		printf("    Model: %s at %.3f ms\n", Message, _Time / 1e6);
+	}
+}
+
+/** @brief	Request the next byte from the sender when the line is idle.
+ *  @param Start	Start time of the transmission
+ */
+static void Model_StartReceive(const uint64_t Start)
+{
+	if((_RxEnd == 0x00) && _Sender.Transmit(&_RxData))
+	{
+		_RxEnd = Start + _Config.ByteTime;
+	}
+}
+
+/** @brief			Advance the simulated time and process the events of the USART line.
+ *  @param Time		Time in nanoseconds
+ */
+static void Model_Advance(const uint64_t Time)
+{
+	while(true)
+	{
+		// Process the next event in the order of the time
+		if(_RxEnd && (_RxEnd <= Time) && (!_TxEnd || (_RxEnd <= _TxEnd)))
+		{
+			uint64_t End = _RxEnd;
+
+			if(_RxCount < MODEL_RX_FIFO_SIZE)
+			{
+				_RxFifo[_RxCount++] = _RxData;
+			}
+			else
+			{
+				_Statistics.Overruns++;
+			}
+
+			_Statistics.Received++;
+			_RxEnd = 0x00;
+			_Time = End;
+			Model_StartReceive(End);
+		}
+		else if(_TxEnd && (_TxEnd <= Time))
+		{
+			uint64_t End = _TxEnd;
+
+			_TxEnd = 0x00;
+			_Time = End;
+			_Sender.Receive(_TxData);
+
+			if(_TxBufferFull)
+			{
+				_TxData = _TxBuffer;
+				_TxBufferFull = false;
+				_TxEnd = End + _Config.ByteTime;
+			}
+
+			// The sender can continue after a response
+			Model_StartReceive(End);
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	_Time = Time;
+	Model_StartReceive(Time);
+
+	if(_Time > _Config.TimeLimit)
+	{
+		longjmp(_Abort, 0x01);
+	}
+}
+
+/** @brief		Transmit a byte to the sender.
+ *  @param Data	Data byte
+ */
+static void Model_Write(const uint8_t Data)
+{
+	_Statistics.Transmitted++;
+
+	if(!_TxEnd)
+	{
+		_TxData = Data;
+		_TxEnd = _Time + _Config.ByteTime;
+	}
+	else if(!_TxBufferFull)
+	{
+		_TxBuffer = Data;
+		_TxBufferFull = true;
+	}
+	else
+	{
+		Model_Violation("Write into the full transmit buffer");
+	}
+}
+
+/** @brief			Process the register accesses since the last call.
+ *  @param Register	#true for a USART register access
+ */
+static void Model_Update(const bool Register)
+{
+	bool Written = !(_USART.DATA & MODEL_DATA_EMPTY);
+
+	if(Written)
+	{
+		Model_Write(_USART.DATA);
+		_USART.DATA = MODEL_DATA_EMPTY | _RxFifo[0];
+	}
+	else if(_State == MODEL_READ)
+	{
+		// The data register was read after the receive flag was shown
+		memmove(&_RxFifo[0], &_RxFifo[1], --_RxCount);
+		_State = MODEL_IDLE;
+	}
+
+	if(Register)
+	{
+		_State = ((_State == MODEL_FLAG) && !Written) ? MODEL_READ : MODEL_IDLE;
+	}
+	else if(Written)
+	{
+		_State = MODEL_IDLE;
+	}
+}
+
+USART_t* Host_USART(const uint8_t Index)
+{
+	Model_Update(true);
+	Model_Advance(_Time + _Config.AccessTime);
+
+	// Don't change the registers between the status read and the data read
+	if(_State != MODEL_READ)
+	{
+		_USART.STATUS = _TxBufferFull ? 0x00 : USART_DREIF_bm;
+		_USART.DATA = MODEL_DATA_EMPTY | _RxFifo[0];
+
+		if(_RxCount && !_TxBufferFull)
+		{
+			_USART.STATUS |= USART_RXCIF_bm;
+			_State = MODEL_FLAG;
+		}
+	}
+
+	return &_USART;
+}
+
+NVM_t* Host_NVM(void)
+{
+	Model_Update(false);
+	Model_Advance(_Time + _Config.AccessTime);
+	_NVM.STATUS = (_Time < _FlashBusy) ? NVM_NVMBUSY_bm : 0x00;
+
+	return &_NVM;
+}
+
+uint16_t Host_ReadFlashWord(const uint32_t Address)
+{
+	Model_Update(false);
+	Model_Advance(_Time + _Config.AccessTime);
+
+	if(_Time < _FlashBusy)
+	{
+		Model_Violation("Flash read during a page write");
+	}
+
+	return (_Flash[Address + 1] << 0x08) | _Flash[Address];
+}
+
+void NVM_LockSPM(void)
+{
+}
+
+void NVM_EraseApplication(void)
+{
+	memset(_Flash, 0xFF, sizeof(_Flash));
+	_Statistics.PageWrites = 0x00;
+}
+
+void NVM_ClearFlashBuffer(void)
+{
+	memset(_PageBuffer, 0xFF, sizeof(_PageBuffer));
+	memset(_WordLoaded, 0x00, sizeof(_WordLoaded));
+}
+
+void NVM_LoadFlashBuffer(const uint16_t Offset, const uint16_t Data)
+{
+	Model_Update(false);
+	Model_Advance(_Time + _Config.AccessTime);
+
+	if(_Time < _FlashBusy)
+	{
+		Model_Violation("Page buffer load during a page write");
+	}
+	else if(Offset >= (APP_SECTION_PAGE_SIZE / 2))
+	{
+		Model_Violation("Page buffer load outside of the page");
+
+		return;
+	}
+	else if(_WordLoaded[Offset])
+	{
+		Model_Violation("Second load of a page buffer word");
+	}
+
+	_PageBuffer[Offset << 0x01] = Data & 0xFF;
+	_PageBuffer[(Offset << 0x01) + 1] = Data >> 0x08;
+	_WordLoaded[Offset] = true;
+}
+
+void NVM_StartFlushFlash(const uint16_t Page)
+{
+	Model_Update(false);
+	Model_Advance(_Time + _Config.AccessTime);
+
+	if(_Time < _FlashBusy)
+	{
+		Model_Violation("Page write during a page write");
+	}
+
+	if(((uint32_t)Page * APP_SECTION_PAGE_SIZE) < APP_SECTION_SIZE)
+	{
+		memcpy(&_Flash[(uint32_t)Page * APP_SECTION_PAGE_SIZE], _PageBuffer, APP_SECTION_PAGE_SIZE);
+	}
+	else
+	{
+		Model_Violation("Page write outside of the application section");
+	}
+
+	NVM_ClearFlashBuffer();
+	_FlashBusy = _Time + _Config.PageTime;
+	_Statistics.PageWrites++;
+}
+
+void NVM_FlushFlash(const uint16_t Page)
+{
+	NVM_StartFlushFlash(Page);
+	Model_Advance(_FlashBusy);
+}
+
+uint32_t NVM_ApplicationCRC(const uint32_t Length)
+{
+	Model_Update(false);
+
+	if(_Time < _FlashBusy)
+	{
+		Model_Violation("CRC calculation during a page write");
+	}
+
+	// The CRC module needs one clock cycle for each byte
+	Model_Advance(_Time + (Length * 500ULL));
+
+	return Model_CRC32(_Flash, Length);
+}
+
+void Model_Init(const Model_Config_t* Config, const Model_Sender_t* Sender)
+{
+	_Config = *Config;
+	_Sender = *Sender;
+	memset(&_Statistics, 0x00, sizeof(_Statistics));
+	_State = MODEL_IDLE;
+	_Time = 0x00;
+	_RxCount = 0x00;
+	_RxEnd = 0x00;
+	_TxBufferFull = false;
+	_TxEnd = 0x00;
+	_FlashBusy = 0x00;
+	_USART.DATA = MODEL_DATA_EMPTY;
+	_USART.STATUS = USART_DREIF_bm;
+	_NVM.STATUS = 0x00;
+
+	memset(_Flash, 0xFF, sizeof(_Flash));
+	NVM_ClearFlashBuffer();
+}
+
+bool Model_Run(bool (*Function)(void), bool* Result)
+{
+	if(setjmp(_Abort))
+	{
+		return false;
+	}
+
+	*Result = Function();
+
+	// Process the last write into the data register and deliver the last responses to the sender
+	Model_Update(false);
+
+	Model_Advance(_Time + (3 * _Config.ByteTime));
+
+	return true;
+}
+
+uint64_t Model_GetTime(void)
+{
+	return _Time;
+}
+
+uint8_t* Model_GetFlash(void)
+{
+	return _Flash;
+}
+
+const Model_Statistics_t* Model_GetStatistics(void)
+{
+	return &_Statistics;
+}
+
+uint32_t Model_CRC32(const uint8_t* Data, const uint32_t Length)
+{
+	uint32_t CRC = 0xFFFFFFFF;
+
+	for(uint32_t i = 0x00; i < Length; i++)
+	{
+		CRC ^= Data[i];
+
+		for(uint8_t j = 0x00; j < 0x08; j++)
+		{
+			CRC = (CRC >> 0x01) ^ (0xEDB88320 & (-(CRC & 0x01)));
+		}
+	}
+
+	return ~CRC;
+}
+
+uint32_t Model_ReadHex(const char* File, uint8_t* Image)
+{
+	char Line[600];
+	uint32_t Offset = 0x00;
+	uint32_t Length = 0x00;
+	FILE* Hex = fopen(File, "r");
+
+	if(Hex == NULL)
+	{
+		return 0x00;
+	}
+
+	memset(Image, 0xFF, APP_SECTION_SIZE);
+
+	while(fgets(Line, sizeof(Line), Hex) != NULL)
+	{
+		uint8_t Record[256 + 5];
+		uint8_t Sum = 0x00;
+		size_t Count = (strcspn(Line, "\r\n") - 1) / 2;
+
+		if((Line[0] != ':') || (Count < 5))
+		{
+			continue;
+		}
+
+		for(size_t i = 0x00; i < Count; i++)
+		{
+			unsigned int Value;
+
+			sscanf(&Line[1 + (i << 0x01)], "%2x", &Value);
+			Record[i] = Value;
+			Sum += Value;
+		}
+
+		if(Sum || (Count != (Record[0] + 5U)))
+		{
+			fclose(Hex);
+
+			return 0x00;
+		}
+
+		uint32_t Address = Offset + ((Record[1] << 0x08) | Record[2]);
+
+		if(Record[3] == 0x00)
+		{
+			if((Address + Record[0]) > APP_SECTION_SIZE)
+			{
+				fclose(Hex);
+
+				return 0x00;
+			}
+
+			memcpy(&Image[Address], &Record[4], Record[0]);
+
+			if((Address + Record[0]) > Length)
+			{
+				Length = Address + Record[0];
+			}
+		}
+		else if(Record[3] == 0x01)
+		{
+			break;
+		}
+		else if(Record[3] == 0x02)
+		{
+			Offset = ((Record[4] << 0x08) | Record[5]) << 0x04;
+		}
+		else if(Record[3] == 0x04)
+		{
+			Offset = (uint32_t)((Record[4] << 0x08) | Record[5]) << 0x10;
+		}
+	}
+
+	fclose(Hex);
+
+	// The flash is programmed with words
+	return (Length + 0x01) & ~0x01UL;
+}
+
+uint8_t* Model_ReadFile(const char* File, uint32_t* Length)
+{
+	FILE* Input = fopen(File, "rb");
+	uint8_t* Data;
+
+	if(Input == NULL)
+	{
+		return NULL;
+	}
+
+	fseek(Input, 0x00, SEEK_END);
+	*Length = ftell(Input);
+	fseek(Input, 0x00, SEEK_SET);
+
+	Data = malloc(*Length + 0x01);
+	if((Data == NULL) || (fread(Data, 0x01, *Length, Input) != *Length))
+	{
+		free(Data);
+		Data = NULL;
+	}
+
+	fclose(Input);
+
+	return Data;
+}
\ No newline at end of file
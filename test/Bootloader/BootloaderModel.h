@@ -0,0 +1,127 @@
+/*
+ * BootloaderModel.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: USART and flash model for the host tests of the AVR bootloader.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file BootloaderModel.h
+ *  @brief USART and flash model for the host tests of the AVR bootloader.
+ *
+ *  The model replaces the USART registers, the NVM controller and the NVM functions of the bootloader. Each register
+ *  access advances the simulated time. A sender object on the other side of the USART line transmits the image and
+ *  receives the responses of the bootloader.
+ *
+ *  The model detects a read of the data register with the order of the register accesses. A received byte is
+ *  removed from the receive buffer when the access after a status read with a set RXCIF flag doesn't write the
+ *  data register. So the receive flag is only shown when the data register is empty.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef BOOTLOADERMODEL_H_
+#define BOOTLOADERMODEL_H_
+
+ #include <stdint.h>
+ #include <stdbool.h>
+
+ #include <avr/io.h>
+
+ #define MODEL_RX_FIFO_SIZE						2						/**< Size of the USART receive buffer */
+
+ /** @brief Sender object on the other side of the USART line.
+  */
+ typedef struct
+ {
+	 bool (*Transmit)(uint8_t* Data);							/**< Get the next byte for the bootloader. Return #false when the sender is idle */
+	 void (*Receive)(const uint8_t Data);						/**< Receive a byte from the bootloader */
+ } Model_Sender_t;
+
+ /** @brief Timing of the model in nanoseconds.
+  */
+ typedef struct
+ {
+	 uint32_t ByteTime;											/**< Transmission time for one byte with start and stop bit */
+	 uint32_t AccessTime;										/**< Time between two register accesses */
+	 uint32_t PageTime;											/**< Page erase and write time */
+	 uint64_t TimeLimit;										/**< Abort the test after this time */
+ } Model_Config_t;
+
+ /** @brief Statistics of the model.
+  */
+ typedef struct
+ {
+	 uint32_t Received;											/**< Bytes received by the bootloader */
+	 uint32_t Transmitted;										/**< Bytes transmitted by the bootloader */
+	 uint32_t Overruns;											/**< Bytes lost because the receive buffer was full */
+	 uint32_t PageWrites;										/**< Page erase and write operations */
+	 uint32_t Violations;										/**< Wrong usage of the NVM controller */
+ } Model_Statistics_t;
+
+ /** @brief			Initialize the model and erase the flash memory.
+  *  @param Config	Pointer to model configuration
+  *  @param Sender	Pointer to sender object
+  */
+ void Model_Init(const Model_Config_t* Config, const Model_Sender_t* Sender);
+
+ /** @brief			Call a function of the bootloader until it returns or the time limit is reached.
+  *  @param Function	Pointer to function
+  *  @param Result	Pointer to return value of the function
+  *  @return		#false when the time limit was reached
+  */
+ bool Model_Run(bool (*Function)(void), bool* Result);
+
+ /** @brief		Get the simulated time.
+  *  @return	Time in nanoseconds
+  */
+ uint64_t Model_GetTime(void);
+
+ /** @brief		Get the flash memory of the model.
+  *  @return	Pointer to the application section
+  */
+ uint8_t* Model_GetFlash(void);
+
+ /** @brief		Get the statistics of the model.
+  *  @return	Pointer to statistics
+  */
+ const Model_Statistics_t* Model_GetStatistics(void);
+
+ /** @brief			Calculate the CRC-32 (IEEE 802.3) of a memory block.
+  *  @param Data	Pointer to data
+  *  @param Length	Length in bytes
+  *  @return		CRC-32
+  */
+ uint32_t Model_CRC32(const uint8_t* Data, const uint32_t Length);
+
+ /** @brief			Read an Intel HEX file.
+  *  @param File	File name
+  *  @param Image	Pointer to image buffer with #APP_SECTION_SIZE bytes
+  *  @return		Image length in bytes or 0 when the file is invalid
+  */
+ uint32_t Model_ReadHex(const char* File, uint8_t* Image);
+
+ /** @brief			Read a binary file.
+  *  @param File	File name
+  *  @param Length	Pointer to file length
+  *  @return		Pointer to file content. Must be released with free
+  */
+ uint8_t* Model_ReadFile(const char* File, uint32_t* Length);
+
+#endif /* BOOTLOADERMODEL_H_ */
\ No newline at end of file
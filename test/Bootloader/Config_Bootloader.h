@@ -0,0 +1,66 @@
+/*
+ * Config_Bootloader.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Configuration file for the host tests of the AVR bootloader.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Config_Bootloader.h
+ *  @brief Configuration file for the host tests of the AVR bootloader.
+ *
+ *  The file format and the options are set by the makefile of the host tests.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef CONFIG_BOOTLOADER_H_
+#define CONFIG_BOOTLOADER_H_
+ 
+ #include "Common/Common.h"
+ 
+ #define BOOTLOADER_INTERFACE_TYPE				INTERFACE_USART
+ #define BOOTLOADER_INTERFACE					C, 0					/**< USART interface used by the bootloader. */
+
+ #ifndef BOOTLOADER_BAUD
+	 #define BOOTLOADER_BAUD					19200					/**< USART baud rate used by the bootloader. */
+ #endif
+
+ #ifndef BOOTLOADER_FILE_FORMAT
+	 #define BOOTLOADER_FILE_FORMAT				HEX_FORMAT_BINARY		/**< Use the binary format as input file. */
+ #endif
+
+ #define BOOTLOADER_WINDOW						2						/**< Number of page buffers and unacknowledged packets for the binary format. */
+ #define BOOTLOADER_TIMEOUT						50000					/**< Receive timeout in polling loops for the binary format. */
+
+ #ifndef BOOTLOADER_LZSS_WINDOW_BITS
+	 #define BOOTLOADER_LZSS_WINDOW_BITS		8						/**< Size of the LZSS history window in bits. Must match the packer. */
+ #endif
+
+ #ifndef BOOTLOADER_LZSS_LENGTH_BITS
+	 #define BOOTLOADER_LZSS_LENGTH_BITS		4						/**< Size of the LZSS length field in bits. Must match the packer. */
+ #endif
+
+ /*
+	The host can't execute the AVR assembler instructions of the bootloader
+ */
+ #define asm
+ #define volatile(...)
+
+#endif /* CONFIG_BOOTLOADER_H_ */
\ No newline at end of file
@@ -0,0 +1,63 @@
+import random
+import argparse
+
+# Write an image as Intel HEX file with 16 data bytes per record. Addresses above 64 kB use extended linear or extended segment address records
+def WriteHex(File, Sections):
+	with open(File, "w") as Hex:
+		Base = 0
+		for (Address, Data, Segment) in Sections:
+			for Position in range(0, len(Data), 16):
+				Record = Data[Position:Position + 16]
+				Current = Address + Position
+
+				if(((Position == 0) and Segment) or ((Current >> 16) != (Base >> 16))):
+					if(Segment):
+						Base = Current & ~0x0F
+						Extended = bytes([0x02, 0x00, 0x00, 0x02, (Base >> 12) & 0xFF, (Base >> 4) & 0xFF])
+					else:
+						Base = Current & ~0xFFFF
+						Extended = bytes([0x02, 0x00, 0x00, 0x04, (Base >> 24) & 0xFF, (Base >> 16) & 0xFF])
+					Hex.write(":{}{:02X}\n".format(Extended.hex().upper(), (-sum(Extended)) & 0xFF))
+
+				Line = bytes([len(Record), ((Current - Base) >> 8) & 0xFF, (Current - Base) & 0xFF, 0x00]) + bytes(Record)
+				Hex.write(":{}{:02X}\n".format(Line.hex().upper(), (-sum(Line)) & 0xFF))
+
+		Hex.write(":00000001FF\n")
+
+# Create program code with repeated instruction sequences like a compiler output
+def CreateCode(Random, Length):
+	Code = bytearray()
+
+	while(len(Code) < Length):
+		if((len(Code) > 64) and (Random.random() < 0.6)):
+			Distance = min(len(Code), Random.choice([16, 64, 256, 1024, 4096]))
+			Start = len(Code) - Random.randint(1, Distance)
+			Code.extend(Code[Start:Start + Random.randint(2, 40)])
+		else:
+			for i in range(Random.randint(1, 6)):
+				Code.extend(Random.choice([bytes([Random.randint(0, 255), Random.randint(0, 255)]), b"\x0F\x92", b"\x08\x95", b"\x0E\x94"]))
+
+	return Code[:Length]
+
+if(__name__ == "__main__"):
+	Parser = argparse.ArgumentParser(description = "Create the test images for the host tests of the bootloader.")
+	Parser.add_argument("Application", help = "Intel HEX file of the installed application")
+	Parser.add_argument("Update", help = "Intel HEX file of the new application")
+	Args = Parser.parse_args()
+
+	Random = random.Random(2020)
+
+	# The data section starts behind the code without alignment, so records cross page boundaries
+	Code = CreateCode(Random, 40000)
+	Data = bytearray(Random.randint(0, 255) for i in range(3001))
+	Far = CreateCode(Random, 6000)
+	Table = bytearray(Random.randint(0, 255) for i in range(777))
+	WriteHex(Args.Application, [(0x0000, Code, False), (0x9C43, Data, False), (0x10103, Far, False), (0x12345, Table, True)])
+
+	# The update changes single bytes, inserts code and extends the image
+	Code[0x0600:0x0800] = bytes((Value ^ 0x01) if((i % 4) == 0) else Value for (i, Value) in enumerate(Code[0x0600:0x0800]))
+	Code[0x3000:0x3000] = CreateCode(Random, 100)
+	Code = Code[:40000]
+	Data[100:110] = bytes(10)
+	Far.extend(CreateCode(Random, 1500))
+	WriteHex(Args.Update, [(0x0000, Code, False), (0x9C43, Data, False), (0x10103, Far, False), (0x12345, Table, True)])
@@ -0,0 +1,234 @@
+/*
+ * IntelHexTest.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host test and benchmark for the Intel HEX format of the AVR bootloader.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file IntelHexTest.c
+ *  @brief Host test and benchmark for the Intel HEX format of the AVR bootloader.
+ *
+ *  The test transmits an Intel HEX file with XON/XOFF flow control to the bootloader and compares the flash memory of the
+ *  model with the image. The benchmark measures the throughput of the parser on the host. Usage:
+ *
+ *		IntelHexTest <Image.hex>
+ *		IntelHexTest -b <Image.hex>
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "Bootloader/Bootloader.h"
+
+#include "BootloaderModel.h"
+
+/** @brief	Size of the parsed data for the benchmark in bytes.
+ */
+#define TEST_BENCHMARK_SIZE				(64UL << 20)
+
+/** @brief Test case.
+ */
+typedef struct
+{
+	const char* Name;										/**< Name of the test case */
+	uint32_t PageTime;										/**< Page erase and write time in nanoseconds */
+} Test_Case_t;
+
+static uint8_t _Image[APP_SECTION_SIZE];
+static uint32_t _ImageLength;
+
+/** @brief	HEX file and state of the sender.
+ */
+static uint8_t* _Hex;
+static uint32_t _HexLength;
+static uint32_t _Position;
+static bool _Greeting;
+static bool _Enabled;
+static uint32_t _Stops;
+
+static bool Test_Transmit(uint8_t* Data)
+{
+	if(!_Greeting || !_Enabled || (_Position == _HexLength))
+	{
+		return false;
+	}
+
+	*Data = _Hex[_Position++];
+
+	return true;
+}
+
+static void Test_Receive(const uint8_t Data)
+{
+	// Start the transmission after the message from the bootloader. The byte on the line is always completed
+	if(Data == XON)
+	{
+		_Enabled = true;
+	}
+	else if(Data == XOFF)
+	{
+		_Enabled = false;
+		_Stops++;
+	}
+	else if(Data == '\r')
+	{
+		_Greeting = true;
+	}
+}
+
+/** @brief			Run a test case and compare the flash memory with the image.
+ *  @param Case		Pointer to test case
+ *  @return			#true when the test is passed
+ */
+static bool Test_Run(const Test_Case_t* Case)
+{
+	Model_Config_t Config = {
+		.ByteTime = 1000000000ULL * 10 / BOOTLOADER_BAUD,
+		.AccessTime = 5000,
+		.PageTime = Case->PageTime,
+		.TimeLimit = 600000000000ULL,
+	};
+	Model_Sender_t Sender = {
+		.Transmit = Test_Transmit,
+		.Receive = Test_Receive,
+	};
+	bool Result = false;
+
+	_Position = 0x00;
+	_Greeting = false;
+	_Enabled = false;
+	_Stops = 0x00;
+
+	Model_Init(&Config, &Sender);
+	Bootloader_Init();
+
+	if(!Model_Run(Bootloader_Enter, &Result))
+	{
+		printf("    Time limit reached\n");
+	}
+
+	const Model_Statistics_t* Statistics = Model_GetStatistics();
+	bool Equal = !memcmp(Model_GetFlash(), _Image, APP_SECTION_SIZE);
+	bool Passed = Result && Equal && !Statistics->Overruns && !Statistics->Violations;
+
+	printf("%-26s %s  %7.1f ms  %6.1f kB/s  %3u pages  %5u stops  %u overruns\n", Case->Name, Passed ? "OK  " : "FAIL",
+		   Model_GetTime() / 1e6, _ImageLength / (Model_GetTime() / 1e9) / 1000.0, Statistics->PageWrites, _Stops,
+		   Statistics->Overruns);
+
+	return Passed;
+}
+
+/** @brief	Measure the throughput of the parser.
+ */
+static void Test_Benchmark(void)
+{
+	Parser_Block_t Line;
+	struct timespec Start;
+	struct timespec End;
+	uint32_t Records = 0x00;
+	uint32_t Passes = (TEST_BENCHMARK_SIZE / _HexLength) + 1;
+	uint32_t Checksum = 0x00;
+
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+
+	for(uint32_t i = 0x00; i < Passes; i++)
+	{
+		Parser_Init();
+
+		for(uint32_t j = 0x00; j < _HexLength; j++)
+		{
+			Parser_State_t State = Parser_GetByte(&Line, _Hex[j]);
+
+			if(State == PARSER_STATE_DATA)
+			{
+				Checksum += Line.Data;
+			}
+			else if(State == PARSER_STATE_SUCCESSFUL)
+			{
+				Records++;
+			}
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &End);
+
+	double Time = (End.tv_sec - Start.tv_sec) + ((End.tv_nsec - Start.tv_nsec) / 1e9);
+
+	printf("Parser_GetByte: %.1f MB in %.3f s, %.1f MB/s, %.1f ns per character (%u records, checksum 0x%08X)\n",
+		   ((double)Passes * _HexLength) / 1e6, Time, ((double)Passes * _HexLength) / Time / 1e6,
+		   (Time * 1e9) / ((double)Passes * _HexLength), Records, Checksum);
+}
+
+int main(int argc, char** argv)
+{
+	bool Benchmark = (argc > 2) && !strcmp(argv[1], "-b");
+	const char* File = (argc > 1) ? argv[argc - 1] : "";
+	bool Passed = true;
+
+	const Test_Case_t Cases[] = {
+		{ .Name = "Transfer", .PageTime = 8000000 },
+		{ .Name = "Slow flash", .PageTime = 40000000 },
+	};
+
+	_ImageLength = Model_ReadHex(File, _Image);
+	_Hex = Model_ReadFile(File, &_HexLength);
+
+	if((_ImageLength == 0x00) || (_Hex == NULL))
+	{
+		printf("Can not read the input files!\n");
+
+		return -1;
+	}
+
+	printf("Image: %u bytes, %u characters transmitted\n", _ImageLength, _HexLength);
+
+	if(Benchmark)
+	{
+		Test_Benchmark();
+	}
+	else
+	{
+		for(uint8_t i = 0x00; i < (sizeof(Cases) / sizeof(Cases[0])); i++)
+		{
+			int Status;
+
+			// Run each test case in a new process, because the bootloader expects the RAM content after a reset
+			fflush(stdout);
+			pid_t Process = fork();
+			if(Process == 0)
+			{
+				exit(Test_Run(&Cases[i]) ? 0 : 1);
+			}
+
+			waitpid(Process, &Status, 0);
+			Passed &= WIFEXITED(Status) && (WEXITSTATUS(Status) == 0);
+		}
+	}
+
+	free(_Hex);
+
+	return Passed ? 0 : -1;
+}
\ No newline at end of file
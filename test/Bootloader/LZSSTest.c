@@ -0,0 +1,111 @@
+/*
+ * LZSSTest.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host test for the LZSS decoder of the AVR bootloader.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file LZSSTest.c
+ *  @brief Host test for the LZSS decoder of the AVR bootloader.
+ *
+ *  The test decodes an image from the packer with different input block sizes and compares the output with the image.
+ *  Usage:
+ *
+ *		LZSSTest <Image.hex> <Image.lz>
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Bootloader/Bootloader.h"
+
+#include "BootloaderModel.h"
+
+static uint8_t _Image[APP_SECTION_SIZE];
+static uint8_t _Output[APP_SECTION_SIZE];
+
+/** @brief				Decode the compressed image.
+ *  @param Data			Pointer to compressed image
+ *  @param Length		Length of the compressed image
+ *  @param BlockSize	Input bytes for each call of the decoder
+ *  @return				Length of the decoded image
+ */
+static uint32_t Test_Decode(const uint8_t* Data, const uint32_t Length, const uint16_t BlockSize)
+{
+	uint32_t Decoded = 0x00;
+
+	LZSS_Init();
+
+	for(uint32_t i = 0x00; i < Length; i += BlockSize)
+	{
+		const uint8_t* Input = &Data[i];
+		uint16_t Remaining = ((Length - i) < BlockSize) ? (Length - i) : BlockSize;
+		uint8_t Byte;
+
+		while(LZSS_Decode(&Input, &Remaining, &Byte) == LZSS_STATE_OUTPUT)
+		{
+			if(Decoded == sizeof(_Output))
+			{
+				return 0x00;
+			}
+
+			_Output[Decoded++] = Byte;
+		}
+	}
+
+	return Decoded;
+}
+
+int main(int argc, char** argv)
+{
+	const uint16_t BlockSizes[] = {1, 7, PARSER_MAX_DATA_BYTES};
+	uint32_t ImageLength = (argc > 1) ? Model_ReadHex(argv[1], _Image) : 0x00;
+	uint32_t Length = 0x00;
+	uint8_t* Data = (argc > 2) ? Model_ReadFile(argv[2], &Length) : NULL;
+	bool Passed = true;
+
+	if((ImageLength == 0x00) || (Data == NULL))
+	{
+		printf("Can not read the input files!\n");
+
+		return -1;
+	}
+
+	printf("LZSS %u/%u: %u bytes, %u bytes compressed (%.1f %%)\n", BOOTLOADER_LZSS_WINDOW_BITS, BOOTLOADER_LZSS_LENGTH_BITS,
+		   ImageLength, Length, 100.0 * Length / ImageLength);
+
+	for(uint8_t i = 0x00; i < (sizeof(BlockSizes) / sizeof(BlockSizes[0])); i++)
+	{
+		uint32_t Decoded = Test_Decode(Data, Length, BlockSizes[i]);
+		bool Equal = (Decoded == ImageLength) && !memcmp(_Output, _Image, ImageLength);
+
+		printf("%-26s %s  %u bytes decoded\n", (BlockSizes[i] == 1) ? "Blocks of 1 byte" : (BlockSizes[i] == 7) ? "Blocks of 7 bytes" : "Blocks of one packet",
+			   Equal ? "OK  " : "FAIL", Decoded);
+
+		Passed &= Equal;
+	}
+
+	free(Data);
+
+	return Passed ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+/*
+ * Config_DisplayManager.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Configuration file for the host tests of the display manager.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Config_DisplayManager.h
+ *  @brief Configuration file for the host tests of the display manager.
+ *
+ *  The frame buffer options are set by the makefile of the host tests.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef CONFIG_DISPLAYMANAGER_H_
+#define CONFIG_DISPLAYMANAGER_H_
+ 
+ #include "Common/Common.h"
+ 
+ #define USE_SSD1306															/**< Use the SSD1306 display with the display manager. */
+ 
+ // OLED interface definitions
+ #define SSD1306_INTERFACE_TYPE						INTERFACE_USART_SPI			/**< Interface type used by the display. */
+ #define SSD1306_INTERFACE							USARTD, 0					/**< USART interface used by display. */
+ #define SSD1306_CLOCK								1000000UL					/**< Display interface speed. */
+
+ // Display definitions
+ #define DISPLAY_WIDTH								128							/**< Width of the display in pixel. */
+ #define DISPLAY_HEIGHT								32							/**< Height of the display in pixel. */
+ #define DISPLAY_PIXEL_PER_BYTE						8							/**< Number of pixel which can fit into one byte. */
+
+ // Display manager definitions
+ #define DISPLAYMANAGER_GLYPH_CACHE_SIZE			8							/**< Number of characters in the glyph cache. */
+ #define DISPLAYMANAGER_USE_STATISTICS											/**< Count the bytes and commands sent to the display. */
+
+#endif /* CONFIG_DISPLAYMANAGER_H_ */
\ No newline at end of file
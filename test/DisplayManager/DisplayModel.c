@@ -0,0 +1,236 @@
+/*
+ * DisplayModel.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: SSD1306 model for the host tests of the display manager.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file DisplayModel.c
+ *  @brief SSD1306 model for the host tests of the display manager.
+ *
+ *  This file contains the implementation of the display model.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Services/DisplayManager/DisplayManager.h"
+
+#include "DisplayModel.h"
+
+/** @brief	Configuration object of the display manager. Replaces the hardware configuration of the library.
+ */
+SPIM_Config_t _DisplayManagerConfig = {
+	.SPIClock = SSD1306_CLOCK,
+};
+
+/** @brief	Display RAM, address pointer and SPI clock of the display.
+ */
+static uint8_t _RAM[MODEL_PAGES][MODEL_COLUMNS];
+static uint8_t _Page;
+static uint8_t _Column;
+static uint32_t _Clock;
+
+static Model_Statistics_t _Statistics;
+
+/** @brief			Store a data byte in the display RAM. The column address wraps around in the page addressing mode.
+ *  @param Data		Data byte
+ */
+static void Model_Store(const uint8_t Data)
+{
+	_RAM[_Page][_Column] = Data;
+	_Column = (_Column + 0x01) % MODEL_COLUMNS;
+	_Statistics.DataBytes++;
+}
+
+void Display_Init(SPIM_Config_t* Config)
+{
+	if(Config != NULL)
+	{
+		_Clock = Config->SPIClock;
+	}
+}
+
+void Display_Reset(void)
+{
+}
+
+void Display_SwitchBacklight(const bool Enable)
+{
+}
+
+void Display_WriteData(const uint8_t Data)
+{
+	_Statistics.Transfers++;
+	Model_Store(Data);
+}
+
+void Display_WriteDataBytes(const uint8_t* Data, const uint8_t Length)
+{
+	_Statistics.Transfers++;
+
+	for(uint8_t i = 0x00; i < Length; i++)
+	{
+		Model_Store(*Data++);
+	}
+}
+
+void Display_BeginData(void)
+{
+	_Statistics.Transfers++;
+}
+
+void Display_EndData(void)
+{
+}
+
+void Display_SetPage(const uint8_t Page)
+{
+	_Page = Page & (MODEL_PAGES - 0x01);
+	_Statistics.Commands++;
+	_Statistics.Transfers++;
+}
+
+void Display_SetColumn(const uint8_t Column)
+{
+	// The driver sends the high and the low nibble with two commands
+	_Column = Column & (MODEL_COLUMNS - 0x01);
+	_Statistics.Commands += 0x02;
+	_Statistics.Transfers += 0x02;
+}
+
+void Display_SetStartLine(const uint8_t Line)
+{
+	_Statistics.Commands++;
+	_Statistics.Transfers++;
+}
+
+void Model_Init(void)
+{
+	// The content of the display RAM is random after a reset
+	for(uint8_t Page = 0x00; Page < MODEL_PAGES; Page++)
+	{
+		memset(_RAM[Page], (Page & 0x01) ? 0x55 : 0xAA, MODEL_COLUMNS);
+	}
+
+	_Page = 0x00;
+	_Column = 0x00;
+	_Clock = 0x00;
+
+	Model_ResetStatistics();
+}
+
+const uint8_t* Model_GetRAM(void)
+{
+	return &_RAM[0][0];
+}
+
+const Model_Statistics_t* Model_GetStatistics(void)
+{
+	return &_Statistics;
+}
+
+void Model_ResetStatistics(void)
+{
+	memset(&_Statistics, 0x00, sizeof(Model_Statistics_t));
+}
+
+double Model_GetBusTime(void)
+{
+	if(_Clock == 0x00)
+	{
+		return 0.0;
+	}
+
+	return (_Statistics.Commands + _Statistics.DataBytes) * 8.0 * 1e6 / _Clock;
+}
+
+bool Model_WritePBM(const char* File, const uint8_t* Data, const uint8_t Width, const uint8_t Height)
+{
+	FILE* Output = fopen(File, "w");
+
+	if(Output == NULL)
+	{
+		return false;
+	}
+
+	// One line of the file for each line of the display
+	fprintf(Output, "P1\n%u %u\n", Width, Height);
+	for(uint8_t y = 0x00; y < Height; y++)
+	{
+		for(uint8_t x = 0x00; x < Width; x++)
+		{
+			fputc((Data[((y / 8) * Width) + x] & (0x01 << (y % 8))) ? '1' : '0', Output);
+		}
+
+		fputc('\n', Output);
+	}
+
+	fclose(Output);
+
+	return true;
+}
+
+bool Model_ReadPBM(const char* File, uint8_t* Data, const uint8_t Width, const uint8_t Height)
+{
+	unsigned int File_Width;
+	unsigned int File_Height;
+	FILE* Input = fopen(File, "r");
+
+	if(Input == NULL)
+	{
+		return false;
+	}
+
+	if((fscanf(Input, "P1 %u %u", &File_Width, &File_Height) != 2) || (File_Width != Width) || (File_Height != Height))
+	{
+		fclose(Input);
+
+		return false;
+	}
+
+	memset(Data, 0x00, (Height / 8) * Width);
+
+	for(uint16_t i = 0x00; i < (Width * Height); )
+	{
+		int Pixel = fgetc(Input);
+
+		if(Pixel == EOF)
+		{
+			fclose(Input);
+
+			return false;
+		}
+		else if((Pixel == '0') || (Pixel == '1'))
+		{
+			uint8_t x = i % Width;
+			uint8_t y = i / Width;
+
+			Data[((y / 8) * Width) + x] |= (Pixel == '1') << (y % 8);
+			i++;
+		}
+	}
+
+	fclose(Input);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+ * DisplayModel.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: SSD1306 model for the host tests of the display manager.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file DisplayModel.h
+ *  @brief SSD1306 model for the host tests of the display manager.
+ *
+ *  The model implements the display functions of the display manager. It stores the data bytes in a copy of the display
+ *  RAM and counts the command bytes, the data bytes and the chip select cycles on the SPI interface. The page and
+ *  column commands use the byte count of the SSD1306 driver.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef DISPLAYMODEL_H_
+#define DISPLAYMODEL_H_
+
+ #include <stdint.h>
+ #include <stdbool.h>
+
+ #define MODEL_PAGES							8						/**< Pages of the display RAM */
+ #define MODEL_COLUMNS							128						/**< Columns of the display RAM */
+
+ /** @brief Statistics of the model.
+  */
+ typedef struct
+ {
+	 uint32_t Commands;											/**< Command bytes sent to the display */
+	 uint32_t DataBytes;										/**< Data bytes sent to the display */
+	 uint32_t Transfers;										/**< Chip select cycles */
+ } Model_Statistics_t;
+
+ /** @brief	Initialize the model and fill the display RAM with a pattern.
+  */
+ void Model_Init(void);
+
+ /** @brief		Get the display RAM of the model.
+  *  @return	Pointer to display RAM with #MODEL_COLUMNS bytes per page
+  */
+ const uint8_t* Model_GetRAM(void);
+
+ /** @brief		Get the statistics of the model.
+  *  @return	Pointer to statistics
+  */
+ const Model_Statistics_t* Model_GetStatistics(void);
+
+ /** @brief	Reset the statistics of the model.
+  */
+ void Model_ResetStatistics(void);
+
+ /** @brief			Get the transmission time of the SPI bytes since the last reset of the statistics.
+  *  @return		Time in microseconds
+  */
+ double Model_GetBusTime(void);
+
+ /** @brief			Write an image with display pages as plain PBM file.
+  *  @param File	File name
+  *  @param Data	Pointer to image data with Width bytes per page
+  *  @param Width	Width of the image in pixel
+  *  @param Height	Height of the image in pixel
+  *  @return		#false when the file can not be written
+  */
+ bool Model_WritePBM(const char* File, const uint8_t* Data, const uint8_t Width, const uint8_t Height);
+
+ /** @brief			Read a plain PBM file into an image with display pages.
+  *  @param File	File name
+  *  @param Data	Pointer to image data with Width bytes per page
+  *  @param Width	Width of the image in pixel
+  *  @param Height	Height of the image in pixel
+  *  @return		#false when the file is invalid or the size doesn't match
+  */
+ bool Model_ReadPBM(const char* File, uint8_t* Data, const uint8_t Width, const uint8_t Height);
+
+#endif /* DISPLAYMODEL_H_ */
\ No newline at end of file
@@ -0,0 +1,482 @@
+/*
+ * DisplayTest.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host test and benchmark for the display manager.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file DisplayTest.c
+ *  @brief Host test and benchmark for the display manager.
+ *
+ *  The test draws scenes with lines, rectangles, circles, text, bitmaps and graphs. After each scene it compares the
+ *  display RAM of the model with the frame buffer and the frame buffer with a golden image. Each frame buffer is stored
+ *  as PBM file with the output prefix. The benchmark measures the drawing speed on the host and the SPI bytes of each
+ *  drawing primitive. Usage:
+ *
+ *		DisplayTest <Golden directory> <Output prefix>
+ *		DisplayTest -u <Golden directory> <Output prefix>	Write new golden images
+ *		DisplayTest -b										Run the benchmark
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Services/DisplayManager/DisplayManager.h"
+
+#include "DisplayModel.h"
+
+/** @brief	Measurement time for each drawing primitive of the benchmark in seconds.
+ */
+#define TEST_BENCHMARK_TIME				0.2
+
+#if(defined DISPLAYMANAGER_USE_GLYPH_CACHE)
+	#define TEST_MODE					"deferred mode with glyph cache"
+#elif(defined DISPLAYMANAGER_USE_DEFERRED)
+	#define TEST_MODE					"deferred mode"
+#else
+	#define TEST_MODE					"immediate mode"
+#endif
+
+/** @brief Test scene or drawing primitive.
+ */
+typedef struct
+{
+	const char* Name;										/**< Name of the scene */
+	void (*Draw)(void);										/**< Drawing function */
+} Test_Scene_t;
+
+extern const uint8_t PictureUSB[];
+extern const uint8_t PictureAtmel[];
+
+/** @brief	Ring with a transparency mask in RAM.
+ */
+static uint8_t _RingData[32];
+static uint8_t _RingMask[32];
+
+static const Bitmap_t _USB = {
+	.Width = 24,
+	.Height = 16,
+	.Type = MEMORY_PROGMEM,
+	.Data.Flash = PictureUSB,
+	.Mask = NULL,
+};
+
+static const Bitmap_t _Atmel = {
+	.Width = 100,
+	.Height = 25,
+	.Type = MEMORY_PROGMEM,
+	.Data.Flash = PictureAtmel,
+	.Mask = NULL,
+};
+
+static const Bitmap_t _Ring = {
+	.Width = 16,
+	.Height = 16,
+	.Type = MEMORY_RAM,
+	.Data.RAM = _RingData,
+	.Mask = _RingMask,
+};
+
+static void Test_DrawLines(void)
+{
+	for(uint8_t x = 0x00; x < DISPLAYMANAGER_LCD_WIDTH; x += 16)
+	{
+		DisplayManager_DrawLine(0, 31, x, 0, PIXELMASK_SET);
+	}
+
+	DisplayManager_DrawLine(127, 0, 64, 31, PIXELMASK_SET);
+	DisplayManager_DrawLine(100, 31, 127, 5, PIXELMASK_SET);
+	DisplayManager_DrawHorizontalLine(70, 3, 50, 2, PIXELMASK_SET);
+	DisplayManager_DrawVerticalLine(122, 0, 30, 3, PIXELMASK_SET);
+	DisplayManager_DrawLine(0, 31, 127, 0, PIXELMASK_CLEAR);
+}
+
+static void Test_DrawRectangles(void)
+{
+	DisplayManager_DrawRect(2, 2, 30, 20, FILL_NO, 1, PIXELMASK_SET);
+	DisplayManager_DrawRect(36, 4, 28, 24, FILL_NO, 3, PIXELMASK_SET);
+	DisplayManager_DrawRect(70, 1, 24, 30, FILL_SOLID, 1, PIXELMASK_SET);
+	DisplayManager_DrawRect(74, 5, 16, 22, FILL_SOLID, 1, PIXELMASK_CLEAR);
+	DisplayManager_FillArea(100, 10, 40, 40, PIXELMASK_SET);
+	DisplayManager_FillArea(104, 13, 8, 3, PIXELMASK_CLEAR);
+}
+
+static void Test_DrawCircles(void)
+{
+	DisplayManager_DrawCircle(15, 15, 14, FILL_NO, PIXELMASK_SET);
+	DisplayManager_DrawCircle(15, 15, 6, FILL_SOLID, PIXELMASK_SET);
+	DisplayManager_DrawCircle(48, 16, 10, FILL_SOLID, PIXELMASK_SET);
+	DisplayManager_DrawCircle(48, 16, 4, FILL_SOLID, PIXELMASK_CLEAR);
+	DisplayManager_DrawCircleSegment(80, 16, 12, CIRCLE_SEGMENT_QUADRANT1 | CIRCLE_SEGMENT_QUADRANT3, FILL_SOLID, PIXELMASK_SET);
+	DisplayManager_DrawCircleSegment(80, 16, 12, CIRCLE_SEGMENT_QUADRANT2 | CIRCLE_SEGMENT_QUADRANT4, FILL_NO, PIXELMASK_SET);
+	DisplayManager_DrawCircle(112, 20, 10, FILL_NO, PIXELMASK_SET);
+}
+
+static void Test_DrawText(void)
+{
+	DisplayManager_DrawString(0, 0, "Hello, World!");
+	DisplayManager_DrawString(80, 3, "y = 3");
+	DisplayManager_DrawString(0, 11, "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~");
+}
+
+static void Test_DrawBitmaps(void)
+{
+	DisplayManager_DrawBitmap(0, 0, &_USB);
+	DisplayManager_DrawBitmap(26, 5, &_USB);
+	DisplayManager_BlitBitmap(-40, 10, &_Atmel, RASTEROP_SET);
+	DisplayManager_BlitBitmap(112, -6, &_USB, RASTEROP_SET);
+	DisplayManager_BlitBitmap(112, 21, &_USB, RASTEROP_SET);
+	DisplayManager_FillArea(56, 0, 48, 32, PIXELMASK_SET);
+	DisplayManager_BlitBitmap(58, 3, &_USB, RASTEROP_XOR);
+	DisplayManager_BlitBitmap(84, 13, &_Ring, RASTEROP_COPY);
+	DisplayManager_BlitBitmap(64, 20, &_Ring, RASTEROP_CLEAR);
+}
+
+static void Test_DrawGraphs(void)
+{
+	Graph_t Load = { 0 };
+	Graph_t Temperature = { 0 };
+
+	DisplayManager_InitGraph(0, 0, "Load", 1000, &Load);
+	DisplayManager_UpdateGraph(&Load, 800);
+	DisplayManager_UpdateGraph(&Load, 300);
+	DisplayManager_InitGraph(0, 16, "Temp", 100, &Temperature);
+	DisplayManager_UpdateGraph(&Temperature, 50);
+	DisplayManager_UpdateGraph(&Temperature, 90);
+}
+
+static void Test_Pixel(void)
+{
+	DisplayManager_DrawPixel(64, 16, PIXELMASK_SET);
+}
+
+static void Test_DiagonalLine(void)
+{
+	DisplayManager_DrawLine(0, 0, 31, 31, PIXELMASK_SET);
+}
+
+static void Test_FlatLine(void)
+{
+	DisplayManager_DrawLine(0, 5, 127, 20, PIXELMASK_SET);
+}
+
+static void Test_HorizontalLine(void)
+{
+	DisplayManager_DrawHorizontalLine(0, 12, 127, 1, PIXELMASK_SET);
+}
+
+static void Test_VerticalLine(void)
+{
+	DisplayManager_DrawVerticalLine(64, 0, 31, 1, PIXELMASK_SET);
+}
+
+static void Test_Rectangle(void)
+{
+	DisplayManager_DrawRect(10, 4, 100, 24, FILL_NO, 1, PIXELMASK_SET);
+}
+
+static void Test_FilledRectangle(void)
+{
+	DisplayManager_DrawRect(10, 4, 100, 24, FILL_SOLID, 1, PIXELMASK_SET);
+}
+
+static void Test_Circle(void)
+{
+	DisplayManager_DrawCircle(64, 16, 15, FILL_NO, PIXELMASK_SET);
+}
+
+static void Test_FilledCircle(void)
+{
+	DisplayManager_DrawCircle(64, 16, 15, FILL_SOLID, PIXELMASK_SET);
+}
+
+static void Test_AlignedText(void)
+{
+	DisplayManager_DrawString(0, 8, "Hello, World!");
+}
+
+static void Test_UnalignedText(void)
+{
+	DisplayManager_DrawString(0, 11, "Hello, World!");
+}
+
+static void Test_AlignedBitmap(void)
+{
+	DisplayManager_DrawBitmap(32, 8, &_USB);
+}
+
+static void Test_UnalignedBitmap(void)
+{
+	DisplayManager_DrawBitmap(32, 5, &_USB);
+}
+
+static void Test_XORBitmap(void)
+{
+	DisplayManager_BlitBitmap(14, 3, &_Atmel, RASTEROP_XOR);
+}
+
+/** @brief	Create the ring bitmap and the transparency mask.
+ */
+static void Test_CreateRing(void)
+{
+	for(int8_t y = 0x00; y < 16; y++)
+	{
+		for(int8_t x = 0x00; x < 16; x++)
+		{
+			int16_t Distance = ((x - 8) * (x - 8)) + ((y - 8) * (y - 8));
+			uint8_t Bit = 0x01 << (y % 8);
+
+			if(Distance < 64)
+			{
+				_RingMask[((y / 8) * 16) + x] |= Bit;
+			}
+
+			if((Distance >= 25) && (Distance < 64))
+			{
+				_RingData[((y / 8) * 16) + x] |= Bit;
+			}
+		}
+	}
+}
+
+/** @brief			Copy the frame buffer.
+ *  @param Frame	Pointer to image data with #DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE bytes
+ */
+static void Test_GetFrame(uint8_t* Frame)
+{
+	for(uint8_t Page = 0x00; Page < DISPLAYMANAGER_LCD_PAGES; Page++)
+	{
+		memcpy(&Frame[Page * DISPLAYMANAGER_LCD_WIDTH], FrameBuffer_GetPointer(Page, 0x00), DISPLAYMANAGER_LCD_WIDTH);
+	}
+}
+
+/** @brief			Compare the visible display RAM of the model with an image.
+ *  @param Frame	Pointer to image data
+ *  @return			#true when the display shows the image
+ */
+static bool Test_CompareDisplay(const uint8_t* Frame)
+{
+	for(uint8_t Page = 0x00; Page < DISPLAYMANAGER_LCD_PAGES; Page++)
+	{
+		if(memcmp(&Model_GetRAM()[Page * MODEL_COLUMNS], &Frame[Page * DISPLAYMANAGER_LCD_WIDTH], DISPLAYMANAGER_LCD_WIDTH))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** @brief			Count the set pixels of an image.
+ *  @param Frame	Pointer to image data
+ *  @return			Number of set pixels
+ */
+static uint16_t Test_CountPixels(const uint8_t* Frame)
+{
+	uint16_t Pixels = 0x00;
+
+	for(uint16_t i = 0x00; i < DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE; i++)
+	{
+		Pixels += __builtin_popcount(Frame[i]);
+	}
+
+	return Pixels;
+}
+
+/** @brief	Clear the display and reset the statistics.
+ */
+static void Test_Clear(void)
+{
+	DisplayManager_Clear();
+	DisplayManager_Flush();
+	DisplayManager_ResetStatistics();
+	Model_ResetStatistics();
+}
+
+/** @brief			Draw a scene and compare the result with the golden image.
+ *  @param Scene	Pointer to scene
+ *  @param Golden	Directory of the golden images
+ *  @param Output	Prefix for the output images
+ *  @param Update	#true to write a new golden image
+ *  @return			#true when the test is passed
+ */
+static bool Test_Run(const Test_Scene_t* Scene, const char* Golden, const char* Output, const bool Update)
+{
+	uint8_t Frame[DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE];
+	uint8_t Expected[DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE];
+	char File[256];
+	DisplayManager_Statistics_t Statistics;
+	uint16_t Wrong = 0x00;
+
+	Test_Clear();
+	Scene->Draw();
+	DisplayManager_Flush();
+	DisplayManager_GetStatistics(&Statistics);
+	Test_GetFrame(Frame);
+
+	bool Shown = Test_CompareDisplay(Frame);
+	bool Counted = Statistics.DataBytes == Model_GetStatistics()->DataBytes;
+
+	snprintf(File, sizeof(File), "%s%s.pbm", Output, Scene->Name);
+	Model_WritePBM(File, Frame, DISPLAYMANAGER_LCD_WIDTH, DISPLAYMANAGER_LCD_HEIGHT);
+
+	snprintf(File, sizeof(File), "%s/%s.pbm", Golden, Scene->Name);
+	if(Update)
+	{
+		Model_WritePBM(File, Frame, DISPLAYMANAGER_LCD_WIDTH, DISPLAYMANAGER_LCD_HEIGHT);
+	}
+	else if(Model_ReadPBM(File, Expected, DISPLAYMANAGER_LCD_WIDTH, DISPLAYMANAGER_LCD_HEIGHT))
+	{
+		for(uint16_t i = 0x00; i < DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE; i++)
+		{
+			Wrong += __builtin_popcount(Frame[i] ^ Expected[i]);
+		}
+	}
+	else
+	{
+		printf("    Can not read %s!\n", File);
+		Wrong = DISPLAYMANAGER_LCD_WIDTH * DISPLAYMANAGER_LCD_HEIGHT;
+	}
+
+	bool Passed = Shown && Counted && !Wrong;
+
+	printf("%-26s %s  %5u data bytes  %4u command bytes  %4u transfers  %8.1f us  %u wrong pixels%s\n", Scene->Name,
+		   Passed ? "OK  " : "FAIL", Model_GetStatistics()->DataBytes, Model_GetStatistics()->Commands,
+		   Model_GetStatistics()->Transfers, Model_GetBusTime(), Wrong, Shown ? "" : "  display differs");
+
+	return Passed;
+}
+
+/** @brief				Measure a drawing primitive.
+ *  @param Primitive	Pointer to drawing primitive
+ */
+static void Test_Measure(const Test_Scene_t* Primitive)
+{
+	uint8_t Frame[DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE];
+	struct timespec Start;
+	struct timespec End;
+	uint32_t Calls = 0x00;
+	double Time;
+
+	// Get the pixels and the SPI bytes of a single call
+	Test_Clear();
+	Primitive->Draw();
+	DisplayManager_Flush();
+	Test_GetFrame(Frame);
+
+	uint16_t Pixels = Test_CountPixels(Frame);
+	Model_Statistics_t Statistics = *Model_GetStatistics();
+	double BusTime = Model_GetBusTime();
+
+	// Each call updates the display
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	do
+	{
+		for(uint16_t i = 0x00; i < 256; i++)
+		{
+			Primitive->Draw();
+			DisplayManager_Flush();
+		}
+
+		Calls += 256;
+		clock_gettime(CLOCK_MONOTONIC, &End);
+		Time = (End.tv_sec - Start.tv_sec) + ((End.tv_nsec - Start.tv_nsec) / 1e9);
+	} while(Time < TEST_BENCHMARK_TIME);
+
+	printf("%-20s %5u pixels  %8.1f ns  %8.1f Mpixel/s  %5u SPI bytes (%4u data, %3u command)  %8.1f us bus time\n",
+		   Primitive->Name, Pixels, Time * 1e9 / Calls, Pixels * (double)Calls / Time / 1e6,
+		   Statistics.DataBytes + Statistics.Commands, Statistics.DataBytes, Statistics.Commands, BusTime);
+}
+
+int main(int argc, char** argv)
+{
+	bool Benchmark = (argc > 1) && !strcmp(argv[1], "-b");
+	bool Update = (argc > 3) && !strcmp(argv[1], "-u");
+	uint8_t Frame[DISPLAYMANAGER_LCD_FRAMEBUFFER_SIZE];
+	bool Passed = true;
+
+	const Test_Scene_t Scenes[] = {
+		{ .Name = "Lines", .Draw = Test_DrawLines },
+		{ .Name = "Rectangles", .Draw = Test_DrawRectangles },
+		{ .Name = "Circles", .Draw = Test_DrawCircles },
+		{ .Name = "Text", .Draw = Test_DrawText },
+		{ .Name = "Bitmaps", .Draw = Test_DrawBitmaps },
+		{ .Name = "Graphs", .Draw = Test_DrawGraphs },
+	};
+
+	const Test_Scene_t Primitives[] = {
+		{ .Name = "Pixel", .Draw = Test_Pixel },
+		{ .Name = "Diagonal line", .Draw = Test_DiagonalLine },
+		{ .Name = "Flat line", .Draw = Test_FlatLine },
+		{ .Name = "Horizontal line", .Draw = Test_HorizontalLine },
+		{ .Name = "Vertical line", .Draw = Test_VerticalLine },
+		{ .Name = "Rectangle", .Draw = Test_Rectangle },
+		{ .Name = "Filled rectangle", .Draw = Test_FilledRectangle },
+		{ .Name = "Circle", .Draw = Test_Circle },
+		{ .Name = "Filled circle", .Draw = Test_FilledCircle },
+		{ .Name = "Aligned text", .Draw = Test_AlignedText },
+		{ .Name = "Unaligned text", .Draw = Test_UnalignedText },
+		{ .Name = "Aligned bitmap", .Draw = Test_AlignedBitmap },
+		{ .Name = "Unaligned bitmap", .Draw = Test_UnalignedBitmap },
+		{ .Name = "XOR bitmap", .Draw = Test_XORBitmap },
+	};
+
+	if(!Benchmark && (argc != (Update ? 4 : 3)))
+	{
+		printf("Usage: DisplayTest [-u] <Golden directory> <Output prefix>\n       DisplayTest -b\n");
+
+		return -1;
+	}
+
+	Test_CreateRing();
+	Model_Init();
+	DisplayManager_Init();
+
+	printf("Display manager: %u x %u pixel, %s\n", DISPLAYMANAGER_LCD_WIDTH, DISPLAYMANAGER_LCD_HEIGHT, TEST_MODE);
+
+	if(Benchmark)
+	{
+		for(uint8_t i = 0x00; i < (sizeof(Primitives) / sizeof(Primitives[0])); i++)
+		{
+			Test_Measure(&Primitives[i]);
+		}
+
+		return 0;
+	}
+
+	// The initialization has to clear the complete display
+	memset(Frame, 0x00, sizeof(Frame));
+	if(!Test_CompareDisplay(Frame))
+	{
+		printf("%-26s FAIL\n", "Initialization");
+		Passed = false;
+	}
+
+	for(uint8_t i = 0x00; i < (sizeof(Scenes) / sizeof(Scenes[0])); i++)
+	{
+		Passed &= Test_Run(&Scenes[i], argv[argc - 2], argv[argc - 1], Update);
+	}
+
+	return Passed ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*
+ * SSD1306.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the SSD1306 display controller driver.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Peripheral/SSD1306/SSD1306.h
+ *  @brief Host replacement for the SSD1306 display controller driver.
+ *
+ *  This file replaces the driver header of the library, so the display manager uses the display model of the host tests
+ *  instead of the SPI interface.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef SSD1306_H_
+#define SSD1306_H_
+
+ #include "Common/Common.h"
+
+ #if(!defined SSD1306_INTERFACE)
+	 #error "Invalid interface for the SSD1306!"
+ #endif
+
+ /** @brief SPI master configuration object.
+  */
+ typedef struct
+ {
+	 uint32_t SPIClock;											/**< SPI clock frequency */
+ } SPIM_Config_t;
+
+ void Display_Init(SPIM_Config_t* Config);
+ void Display_Reset(void);
+ void Display_WriteData(const uint8_t Data);
+ void Display_WriteDataBytes(const uint8_t* Data, const uint8_t Length);
+ void Display_BeginData(void);
+ void Display_EndData(void);
+ void Display_SetPage(const uint8_t Page);
+ void Display_SetColumn(const uint8_t Column);
+ void Display_SetStartLine(const uint8_t Line);
+ void Display_SwitchBacklight(const bool Enable);
+
+#endif /* SSD1306_H_ */
\ No newline at end of file
@@ -0,0 +1,70 @@
+/*
+ * Host.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Register objects for the host tests.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Host.c
+ *  @brief Register objects for the host tests.
+ *
+ *  This file contains the register objects of the host replacement for the XMega register definitions. The access
+ *  functions are weak, so a test can replace them with a model of the peripheral.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+PORT_t PORTA;
+PORT_t PORTB;
+PORT_t PORTC;
+PORT_t PORTD;
+PORT_t PORTE;
+PORT_t PORTF;
+PORT_t PORTR;
+SPI_t SPIC;
+SPI_t SPID;
+CLK_t CLK;
+MCU_t MCU;
+volatile uint8_t SREG;
+volatile uint8_t CCP;
+volatile uint8_t EIND;
+
+/** @brief	Register objects for the default access functions.
+ */
+static USART_t _USART[6];
+static NVM_t _NVM;
+
+__attribute__((weak)) USART_t* Host_USART(const uint8_t Index)
+{
+	return &_USART[Index];
+}
+
+__attribute__((weak)) NVM_t* Host_NVM(void)
+{
+	return &_NVM;
+}
+
+__attribute__((weak)) uint16_t Host_ReadFlashWord(const uint32_t Address)
+{
+	return 0xFFFF;
+}
\ No newline at end of file
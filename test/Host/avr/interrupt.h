@@ -0,0 +1,44 @@
+/*
+ * interrupt.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the interrupt functions.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file avr/interrupt.h
+ *  @brief Host replacement for the interrupt functions.
+ *
+ *  Interrupt handlers are normal functions on the host and a test calls them to simulate an interrupt. The global
+ *  interrupt flag is stored in the status register, so a model can check it before it calls an interrupt handler.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+ #include <avr/io.h>
+
+ #define ISR(Vector, ...)						void Vector(void); void Vector(void)
+
+ #define sei()									(SREG |= CPU_I_bm)
+ #define cli()									(SREG &= ~CPU_I_bm)
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
\ No newline at end of file
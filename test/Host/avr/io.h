@@ -0,0 +1,188 @@
+/*
+ * io.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the XMega register definitions.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file avr/io.h
+ *  @brief Host replacement for the XMega register definitions.
+ *
+ *  This file contains the registers of the XMega peripherals which are used by the host tests. The USART and the NVM
+ *  registers are returned by #Host_USART and #Host_NVM, so a test can model the peripheral behind each register access.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+ #include <stdint.h>
+
+ /*
+	Memory sizes of the XMega384C3
+ */
+ #define APP_SECTION_SIZE						0x60000
+ #define APP_SECTION_PAGE_SIZE					512
+ #define EEPROM_SIZE							4096
+ #define EEPROM_PAGE_SIZE						32
+
+ /** @brief USART registers.
+  *			NOTE: The data register is a 16 bit register, so the model can detect a write into the register.
+  */
+ typedef struct
+ {
+	 volatile uint16_t DATA;									/**< Data register */
+	 volatile uint8_t STATUS;									/**< Status register */
+	 volatile uint8_t CTRLA;									/**< Control register A */
+	 volatile uint8_t CTRLB;									/**< Control register B */
+	 volatile uint8_t CTRLC;									/**< Control register C */
+	 volatile uint8_t BAUDCTRLA;								/**< Baud rate control register A */
+	 volatile uint8_t BAUDCTRLB;								/**< Baud rate control register B */
+ } USART_t;
+
+ #define USART_RXCIF_bm							0x80
+ #define USART_TXCIF_bm							0x40
+ #define USART_DREIF_bm							0x20
+ #define USART_FERR_bm							0x10
+ #define USART_BUFOVF_bm						0x08
+ #define USART_RXEN_bm							0x10
+ #define USART_TXEN_bm							0x08
+ #define USART_BSEL_gp							0
+ #define USART_BSCALE_gp						4
+ #define USART_BSCALE_gm						0xF0
+
+ /** @brief I/O port registers.
+  */
+ typedef struct
+ {
+	 volatile uint8_t DIR;										/**< Data direction */
+	 volatile uint8_t DIRSET;									/**< Data direction set */
+	 volatile uint8_t DIRCLR;									/**< Data direction clear */
+	 volatile uint8_t DIRTGL;									/**< Data direction toggle */
+	 volatile uint8_t OUT;										/**< Output value */
+	 volatile uint8_t OUTSET;									/**< Output value set */
+	 volatile uint8_t OUTCLR;									/**< Output value clear */
+	 volatile uint8_t OUTTGL;									/**< Output value toggle */
+	 volatile uint8_t IN;										/**< Input value */
+	 volatile uint8_t INTCTRL;									/**< Interrupt control */
+	 volatile uint8_t INT0MASK;									/**< Interrupt 0 mask */
+	 volatile uint8_t INT1MASK;									/**< Interrupt 1 mask */
+	 volatile uint8_t INTFLAGS;									/**< Interrupt flags */
+ } PORT_t;
+
+ /** @brief Non-volatile memory controller registers.
+  */
+ typedef struct
+ {
+	 volatile uint8_t ADDR0;									/**< Address register 0 */
+	 volatile uint8_t ADDR1;									/**< Address register 1 */
+	 volatile uint8_t ADDR2;									/**< Address register 2 */
+	 volatile uint8_t DATA0;									/**< Data register 0 */
+	 volatile uint8_t DATA1;									/**< Data register 1 */
+	 volatile uint8_t DATA2;									/**< Data register 2 */
+	 volatile uint8_t CMD;										/**< Command */
+	 volatile uint8_t CTRLA;									/**< Control register A */
+	 volatile uint8_t CTRLB;									/**< Control register B */
+	 volatile uint8_t INTCTRL;									/**< Interrupt control */
+	 volatile uint8_t STATUS;									/**< Status */
+	 volatile uint8_t LOCK_BITS;								/**< Lock bits */
+ } NVM_t;
+
+ #define NVM_NVMBUSY_bm							0x80
+ #define NVM_FBUSY_bm							0x40
+ #define NVM_EEMAPEN_bm							0x08
+ #define NVM_FPRM_bm							0x04
+ #define NVM_EPRM_bm							0x02
+ #define NVM_SPMLOCK_bm							0x01
+
+ /** @brief MCU control registers.
+  */
+ typedef struct
+ {
+	 volatile uint8_t DEVID0;									/**< Device ID byte 0 */
+	 volatile uint8_t DEVID1;									/**< Device ID byte 1 */
+	 volatile uint8_t DEVID2;									/**< Device ID byte 2 */
+	 volatile uint8_t REVID;									/**< Revision ID */
+	 volatile uint8_t JTAGUID;									/**< JTAG user ID */
+	 volatile uint8_t MCUCR;									/**< MCU control */
+	 volatile uint8_t ANAINIT;									/**< Analog startup delay */
+	 volatile uint8_t EVSYSLOCK;								/**< Event system lock */
+	 volatile uint8_t AWEXLOCK;									/**< AWEX lock */
+ } MCU_t;
+
+ /** @brief SPI registers.
+  */
+ typedef struct
+ {
+	 volatile uint8_t CTRL;										/**< Control register */
+	 volatile uint8_t INTCTRL;									/**< Interrupt control register */
+	 volatile uint8_t STATUS;									/**< Status register */
+	 volatile uint8_t DATA;										/**< Data register */
+ } SPI_t;
+
+ /** @brief Clock system registers.
+  */
+ typedef struct
+ {
+	 volatile uint8_t CTRL;										/**< Control register */
+	 volatile uint8_t PSCTRL;									/**< Prescaler control */
+	 volatile uint8_t LOCK;										/**< Lock register */
+	 volatile uint8_t RTCCTRL;									/**< RTC control */
+ } CLK_t;
+
+ #define CCP_IOREG_gc							0xD8
+ #define CPU_I_bm								0x80
+
+ /** @brief			Get the registers of a USART.
+  *  @param Index	USART index (C0, C1, D0, D1, E0, F0)
+  *  @return		Pointer to USART registers
+  */
+ USART_t* Host_USART(const uint8_t Index);
+
+ /** @brief		Get the registers of the NVM controller.
+  *  @return	Pointer to NVM registers
+  */
+ NVM_t* Host_NVM(void);
+
+ #define USARTC0								(*Host_USART(0))
+ #define USARTC1								(*Host_USART(1))
+ #define USARTD0								(*Host_USART(2))
+ #define USARTD1								(*Host_USART(3))
+ #define USARTE0								(*Host_USART(4))
+ #define USARTF0								(*Host_USART(5))
+ #define NVM									(*Host_NVM())
+
+ extern PORT_t PORTA;
+ extern PORT_t PORTB;
+ extern PORT_t PORTC;
+ extern PORT_t PORTD;
+ extern PORT_t PORTE;
+ extern PORT_t PORTF;
+ extern PORT_t PORTR;
+ extern SPI_t SPIC;
+ extern SPI_t SPID;
+ extern CLK_t CLK;
+ extern MCU_t MCU;
+ extern volatile uint8_t SREG;
+ extern volatile uint8_t CCP;
+ extern volatile uint8_t EIND;
+
+#endif /* HOST_AVR_IO_H_ */
\ No newline at end of file
@@ -0,0 +1,58 @@
+/*
+ * pgmspace.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the program memory functions.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file avr/pgmspace.h
+ *  @brief Host replacement for the program memory functions.
+ *
+ *  The program memory is a normal memory on the host. Far addresses point into the flash model of a test. The progmem
+ *  attribute is removed, because the host compiler doesn't know it.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+ #include <stdint.h>
+ #include <string.h>
+
+ #define PROGMEM
+ #define __progmem__
+ #define PSTR(String)							(String)
+
+ #define pgm_read_byte(Address)					(*(const uint8_t*)(Address))
+ #define pgm_read_word(Address)					(*(Address))
+ #define pgm_read_dword(Address)				(*(Address))
+ #define memcpy_P								memcpy
+ #define strlen_P								strlen
+
+ /** @brief			Read a word from the flash model of a test.
+  *  @param Address	Byte address
+  *  @return		Data word
+  */
+ uint16_t Host_ReadFlashWord(const uint32_t Address);
+
+ #define pgm_read_word_far(Address)				Host_ReadFlashWord(Address)
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
\ No newline at end of file
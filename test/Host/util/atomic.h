@@ -0,0 +1,56 @@
+/*
+ * atomic.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the atomic blocks.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file util/atomic.h
+ *  @brief Host replacement for the atomic blocks.
+ *
+ *  The host tests run in a single thread and simulate interrupts between two function calls. An atomic block clears the
+ *  global interrupt flag and restores the status register when the block is left, so a model doesn't call an interrupt
+ *  handler inside of the block.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef HOST_UTIL_ATOMIC_H_
+#define HOST_UTIL_ATOMIC_H_
+
+ #include <avr/io.h>
+
+ #define ATOMIC_RESTORESTATE					0
+ #define ATOMIC_FORCEON							0
+ #define NONATOMIC_RESTORESTATE					0
+ #define NONATOMIC_FORCEOFF						0
+
+ /** @brief			Restore the status register at the end of an atomic block.
+  *  @param State	Pointer to saved status register
+  */
+ static inline void __Host_RestoreState(const uint8_t* State)
+ {
+	 SREG = *State;
+ }
+
+ #define ATOMIC_BLOCK(Type)						for(uint8_t __State __attribute__((__cleanup__(__Host_RestoreState))) = SREG, __Once = (SREG &= ~CPU_I_bm, 0x01); __Once; __Once = 0x00)
+ #define NONATOMIC_BLOCK(Type)					for(uint8_t __State __attribute__((__cleanup__(__Host_RestoreState))) = SREG, __Once = (SREG |= CPU_I_bm, 0x01); __Once; __Once = 0x00)
+
+#endif /* HOST_UTIL_ATOMIC_H_ */
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+ * crc16.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the CRC functions of the AVR C library.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file util/crc16.h
+ *  @brief Host replacement for the CRC functions of the AVR C library.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef HOST_UTIL_CRC16_H_
+#define HOST_UTIL_CRC16_H_
+
+ #include <stdint.h>
+
+ static inline uint16_t _crc16_update(uint16_t CRC, const uint8_t Data)
+ {
+	 CRC ^= Data;
+
+	 for(uint8_t i = 0x00; i < 0x08; i++)
+	 {
+		 CRC = (CRC & 0x01) ? ((CRC >> 0x01) ^ 0xA001) : (CRC >> 0x01);
+	 }
+
+	 return CRC;
+ }
+
+ static inline uint16_t _crc_xmodem_update(uint16_t CRC, const uint8_t Data)
+ {
+	 CRC ^= ((uint16_t)Data) << 0x08;
+
+	 for(uint8_t i = 0x00; i < 0x08; i++)
+	 {
+		 CRC = (CRC & 0x8000) ? ((CRC << 0x01) ^ 0x1021) : (CRC << 0x01);
+	 }
+
+	 return CRC;
+ }
+
+ static inline uint16_t _crc_ccitt_update(uint16_t CRC, uint8_t Data)
+ {
+	 Data ^= CRC & 0xFF;
+	 Data ^= Data << 0x04;
+
+	 return ((((uint16_t)Data << 0x08) | (CRC >> 0x08)) ^ (uint8_t)(Data >> 0x04) ^ ((uint16_t)Data << 0x03));
+ }
+
+ static inline uint8_t _crc8_ccitt_update(uint8_t CRC, const uint8_t Data)
+ {
+	 CRC ^= Data;
+
+	 for(uint8_t i = 0x00; i < 0x08; i++)
+	 {
+		 CRC = (CRC & 0x80) ? ((CRC << 0x01) ^ 0x07) : (CRC << 0x01);
+	 }
+
+	 return CRC;
+ }
+
+#endif /* HOST_UTIL_CRC16_H_ */
\ No newline at end of file
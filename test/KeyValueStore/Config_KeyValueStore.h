@@ -0,0 +1,44 @@
+/*
+ * Config_KeyValueStore.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Configuration file for the host tests of the key/value store.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Config_KeyValueStore.h
+ *  @brief Configuration file for the host tests of the key/value store.
+ *
+ *  The key/value store uses the default configuration from the header.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef CONFIG_KEYVALUESTORE_H_
+#define CONFIG_KEYVALUESTORE_H_
+ 
+ #include "Common/Common.h"
+
+ /*
+	The host can't execute the AVR assembler instructions of the NVM driver
+ */
+ #define asm
+ #define volatile(...)
+
+#endif /* CONFIG_KEYVALUESTORE_H_ */
\ No newline at end of file
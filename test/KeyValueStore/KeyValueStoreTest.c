@@ -0,0 +1,347 @@
+/*
+ * KeyValueStoreTest.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host test for the key/value store.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file KeyValueStoreTest.c
+ *  @brief Host test for the key/value store.
+ *
+ *  The test replaces the EEPROM functions of the NVM driver with a model of the EEPROM. The model counts the erase cycles
+ *  of each page and can interrupt the store after a number of programmed or erased bytes to simulate a power fail. The
+ *  content of the store is compared with a copy of all values after each remount and after each power fail. Usage:
+ *
+ *		KeyValueStoreTest
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <stdio.h>
+#include <setjmp.h>
+#include <string.h>
+
+#include "Services/KeyValueStore/KeyValueStore.h"
+
+/** @brief	Number of updates for the wear leveling test.
+ */
+#define TEST_UPDATES					100000UL
+
+/** @brief	Number of updates between two remounts of the store.
+ */
+#define TEST_REMOUNT					9973
+
+/** @brief	Number of power fails for each power fail test.
+ */
+#define TEST_POWER_FAILS				20000
+
+/** @brief	Number of used keys.
+ */
+#define TEST_KEYS						6
+
+/** @brief	Max. number of programmed or erased bytes before a power fail.
+ */
+#define TEST_MAX_CYCLES					96
+
+/** @brief	EEPROM content, erase cycles of each page, number of partial page writes and remaining byte cycles until the next
+ *			power fail (0 for no power fail).
+ */
+static uint8_t _EEPROM[EEPROM_SIZE];
+static uint32_t _Erases[EEPROM_SIZE / EEPROM_PAGE_SIZE];
+static uint32_t _Writes;
+static uint32_t _Cycles;
+static jmp_buf _PowerFail;
+
+/** @brief	Copy of the stored values. A length of 0 marks a key without a value.
+ */
+static uint8_t _Value[TEST_KEYS][KVS_MAX_LENGTH];
+static uint8_t _Length[TEST_KEYS];
+
+/** @brief	Count a programmed or erased byte and interrupt the store when the power fails.
+ */
+static void Test_Cycle(void)
+{
+	if(_Cycles && !--_Cycles)
+	{
+		longjmp(_PowerFail, 0x01);
+	}
+}
+
+void NVM_EEPROMWriteBytes(const uint8_t Page, const uint8_t Offset, const uint8_t Length, const uint8_t* Data)
+{
+	if((Offset + Length) > EEPROM_PAGE_SIZE)
+	{
+		printf("    Write across the end of page %u!\n", Page);
+		exit(-1);
+	}
+
+	_Writes++;
+
+	// A partial page write can only change a bit from 1 to 0
+	for(uint8_t i = 0x00; i < Length; i++)
+	{
+		Test_Cycle();
+		_EEPROM[(Page * EEPROM_PAGE_SIZE) + Offset + i] &= Data[i];
+	}
+}
+
+uint8_t NVM_EEPROMReadByte(const uint8_t Page, const uint8_t Offset)
+{
+	return _EEPROM[(Page * EEPROM_PAGE_SIZE) + Offset];
+}
+
+void NVM_EEPROMErasePage(const uint8_t Page)
+{
+	_Erases[Page]++;
+
+	for(uint8_t i = 0x00; i < EEPROM_PAGE_SIZE; i++)
+	{
+		Test_Cycle();
+		_EEPROM[(Page * EEPROM_PAGE_SIZE) + i] = 0xFF;
+	}
+}
+
+/** @brief			Compare a value in the store with a value.
+ *  @param Key		Key
+ *  @param Length	Length of the value or 0 for a key without a value
+ *  @param Data		Pointer to value
+ *  @return			#true when the store contains the value
+ */
+static bool Test_Compare(const uint8_t Key, const uint8_t Length, const uint8_t* Data)
+{
+	uint8_t Buffer[KVS_MAX_LENGTH];
+	uint8_t Stored = sizeof(Buffer);
+	KeyValueStore_Error_t Error = KeyValueStore_Read(Key, &Stored, Buffer);
+
+	if(Length == 0x00)
+	{
+		return Error == KVS_NOT_FOUND;
+	}
+
+	return (Error == KVS_NO_ERROR) && (Stored == Length) && !memcmp(Buffer, Data, Length);
+}
+
+/** @brief			Compare all values in the store with the copy.
+ *  @param Skip		Key which isn't compared
+ *  @return			#true when the store contains all values
+ */
+static bool Test_Check(const uint8_t Skip)
+{
+	for(uint8_t i = 0x00; i < TEST_KEYS; i++)
+	{
+		if((i != Skip) && !Test_Compare(i, _Length[i], _Value[i]))
+		{
+			printf("    Wrong value for key %u!\n", i);
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** @brief			Create a random update for a key. Small keys are used for counters with small values.
+ *  @param Key		Pointer to key
+ *  @param Data		Pointer to value
+ *  @return			Length of the value or 0 to delete the key
+ */
+static uint8_t Test_Random(uint8_t* Key, uint8_t* Data)
+{
+	uint8_t Length;
+
+	*Key = rand() % TEST_KEYS;
+	Length = 0x01 + (rand() % ((*Key < (TEST_KEYS / 2)) ? 4 : 12));
+
+	for(uint8_t i = 0x00; i < Length; i++)
+	{
+		Data[i] = rand();
+	}
+
+	return (rand() % 50) ? Length : 0x00;
+}
+
+/** @brief			Write or delete a value.
+ *  @param Key		Key
+ *  @param Length	Length of the value or 0 to delete the key
+ *  @param Data		Pointer to value
+ *  @return			#true when successful
+ */
+static bool Test_Update(const uint8_t Key, const uint8_t Length, const uint8_t* Data)
+{
+	if(Length == 0x00)
+	{
+		return KeyValueStore_Delete(Key) != KVS_INVALID_PARAM;
+	}
+
+	return KeyValueStore_Write(Key, Length, Data) == KVS_NO_ERROR;
+}
+
+/** @brief	Write counters and small values and check the wear leveling.
+ *  @return	#true when the test is passed
+ */
+static bool Test_WearLeveling(void)
+{
+	uint8_t Data[KVS_MAX_LENGTH];
+	uint8_t Key;
+	uint32_t Max = 0x00;
+	uint32_t Min = UINT32_MAX;
+	uint32_t Sum = 0x00;
+	bool Passed = true;
+
+	for(uint32_t i = 0x00; (i < TEST_UPDATES) && Passed; i++)
+	{
+		uint8_t Length = Test_Random(&Key, Data);
+
+		if(!Test_Update(Key, Length, Data))
+		{
+			printf("    Update %u failed!\n", i);
+			Passed = false;
+		}
+
+		_Length[Key] = Length;
+		memcpy(_Value[Key], Data, Length);
+
+		if((i % TEST_REMOUNT) == 0x00)
+		{
+			KeyValueStore_Init();
+			Passed &= Test_Check(TEST_KEYS);
+		}
+	}
+
+	Passed &= Test_Check(TEST_KEYS);
+
+	for(uint8_t i = 0x00; i < KVS_PAGES; i++)
+	{
+		Sum += _Erases[KVS_FIRST_PAGE + i];
+		Max = (_Erases[KVS_FIRST_PAGE + i] > Max) ? _Erases[KVS_FIRST_PAGE + i] : Max;
+		Min = (_Erases[KVS_FIRST_PAGE + i] < Min) ? _Erases[KVS_FIRST_PAGE + i] : Min;
+	}
+
+	// Each page is erased once per pass through the ring
+	Passed &= (Max - Min) <= 0x01;
+
+	printf("%-26s %s  %lu updates  %u partial writes  erases per page: max %u  min %u  avg %.1f\n", "Wear leveling",
+		   Passed ? "OK  " : "FAIL", TEST_UPDATES, _Writes, Max, Min, (double)Sum / KVS_PAGES);
+
+	return Passed;
+}
+
+/** @brief	Get the number of erased pages and partial page writes.
+ *  @return	Number of EEPROM operations
+ */
+static uint32_t Test_Operations(void)
+{
+	uint32_t Operations = _Writes;
+
+	for(uint8_t i = 0x00; i < (EEPROM_SIZE / EEPROM_PAGE_SIZE); i++)
+	{
+		Operations += _Erases[i];
+	}
+
+	return Operations;
+}
+
+/** @brief					Interrupt updates with a power fail and check the store after a remount.
+ *  @param Name				Name of the test case
+ *  @param DuringRecovery	#true to interrupt the recovery in #KeyValueStore_Init, too
+ *  @return					#true when the test is passed
+ */
+static bool Test_PowerFail(const char* Name, const bool DuringRecovery)
+{
+	uint8_t Data[KVS_MAX_LENGTH];
+	uint8_t Key;
+	uint32_t PowerFails = 0x00;
+	volatile uint32_t Recoveries = 0x00;
+	volatile uint32_t Interrupted = 0x00;
+	bool Passed = true;
+
+	while((PowerFails < TEST_POWER_FAILS) && Passed)
+	{
+		uint8_t Length = Test_Random(&Key, Data);
+
+		_Cycles = 0x01 + (rand() % TEST_MAX_CYCLES);
+		if(!setjmp(_PowerFail))
+		{
+			Test_Update(Key, Length, Data);
+			_Cycles = 0x00;
+
+			_Length[Key] = Length;
+			memcpy(_Value[Key], Data, Length);
+
+			continue;
+		}
+
+		PowerFails++;
+
+		// Remount the store. The recovery can be interrupted by another power fail
+		_Cycles = DuringRecovery ? (0x01 + (rand() % TEST_MAX_CYCLES)) : 0x00;
+		if(setjmp(_PowerFail))
+		{
+			_Cycles = (rand() % 2) ? (0x01 + (rand() % TEST_MAX_CYCLES)) : 0x00;
+			Interrupted++;
+		}
+
+		uint32_t Operations = Test_Operations();
+		KeyValueStore_Init();
+		_Cycles = 0x00;
+
+		if(Test_Operations() != Operations)
+		{
+			Recoveries++;
+		}
+
+		// The interrupted update can be finished or lost, but the old value must be valid when it is lost
+		if(Test_Compare(Key, Length, Data))
+		{
+			_Length[Key] = Length;
+			memcpy(_Value[Key], Data, Length);
+		}
+		else if(!Test_Compare(Key, _Length[Key], _Value[Key]))
+		{
+			printf("    Lost key %u after power fail %u!\n", Key, PowerFails);
+			Passed = false;
+		}
+
+		Passed &= Test_Check(Key);
+	}
+
+	printf("%-26s %s  %u power fails  %u recoveries  %u interrupted recoveries\n", Name, Passed ? "OK  " : "FAIL",
+		   PowerFails, Recoveries, Interrupted);
+
+	return Passed;
+}
+
+int main(void)
+{
+	bool Passed = true;
+
+	srand(0x01);
+	memset(_EEPROM, 0x5A, sizeof(_EEPROM));
+	KeyValueStore_Format();
+	memset(_Erases, 0x00, sizeof(_Erases));
+
+	printf("Key/value store: %u pages with %u bytes\n", KVS_PAGES, EEPROM_PAGE_SIZE);
+
+	Passed &= Test_WearLeveling();
+	Passed &= Test_PowerFail("Power fail", false);
+	Passed &= Test_PowerFail("Power fail in recovery", true);
+
+	return Passed ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+ * GPIO.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the XMega GPIO driver.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Arch/XMega/GPIO/GPIO.h
+ *  @brief Host replacement for the XMega GPIO driver.
+ *
+ *  This file replaces the GPIO driver header of the library, so the register model of the host tests can call the
+ *  interrupt handler of the MCP2515 driver.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef GPIO_H_
+#define GPIO_H_
+
+ #include "Common/Common.h"
+
+ /** @brief	GPIO callback definition.
+ */
+ typedef void (*GPIO_Callback_t)(void);
+
+ /** @brief Interrupt levels for peripheral modules.
+  */
+ typedef enum
+ {
+	 INT_LVL_LO = 0x01,									/**< Priority low */ 
+	 INT_LVL_MED = 0x02,								/**< Priority medium */ 
+	 INT_LVL_HI = 0x03,									/**< Priority high */ 
+ } Interrupt_Level_t;
+
+ /** @brief GPIO output directions.
+  */
+ typedef enum
+ {
+	 GPIO_DIRECTION_IN = 0x00,							/**< Direction input */ 
+	 GPIO_DIRECTION_OUT = 0x01,							/**< Direction output */ 
+ } GPIO_Direction_t;
+
+ /** @brief GPIO interrupt channels
+  */
+ typedef enum
+ {
+	 GPIO_INTERRUPT_0 = 0x01,							/**< GPIO interrupt channel 0 */ 
+	 GPIO_INTERRUPT_1 = 0x02,							/**< GPIO interrupt channel 1 */ 
+ } GPIO_InterruptChannel_t;
+
+ /** @brief GPIO input sense configurations.
+  */
+ typedef enum 
+ {
+	GPIO_SENSE_BOTH = 0x00,								/**< Sense rising and falling edge */ 
+	GPIO_SENSE_RISING = 0x01,							/**< Sense rising edge only */ 
+	GPIO_SENSE_FALLING = 0x02,							/**< Sense falling edge only */ 
+	GPIO_SENSE_LOWLEVEL = 0x03,							/**< Sense low level */
+ } GPIO_InputSense_t;
+
+ /** @brief GPIO interrupt configuration object.
+  */
+ typedef struct
+ {
+	 PORT_t* Port;										/**< Pointer to port object */
+	 uint8_t Pin;										/**< Pin number */
+	 GPIO_InterruptChannel_t Channel;					/**< Interrupt channel */
+	 GPIO_InputSense_t Sense;							/**< GPIO interrupt type */
+	 Interrupt_Level_t InterruptLevel;					/**< Interrupt level */
+	 GPIO_Callback_t Callback;							/**< Function pointer to GPIO callback */
+ } GPIO_InterruptConfig_t;
+
+ void GPIO_SetDirection(PORT_t* Port, const uint8_t Pin, const GPIO_Direction_t Direction);
+ void GPIO_Set(PORT_t* Port, const uint8_t Pin);
+ void GPIO_Clear(PORT_t* Port, const uint8_t Pin);
+ void GPIO_InstallCallback(GPIO_InterruptConfig_t* Config);
+ void GPIO_ChangeInterruptLevel(PORT_t* Port, const uint8_t Pin, const GPIO_InterruptChannel_t Channel, const Interrupt_Level_t InterruptLevel);
+
+#endif /* GPIO_H_ */
\ No newline at end of file
@@ -0,0 +1,54 @@
+/*
+ * SPI.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host replacement for the XMega SPI driver.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Arch/XMega/SPI/SPI.h
+ *  @brief Host replacement for the XMega SPI driver.
+ *
+ *  This file replaces the SPI driver header of the library, so the MCP2515 driver sends the SPI bytes to the register
+ *  model of the host tests.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef SPI_H_
+#define SPI_H_
+
+ #include "Common/Common.h"
+
+ #include "Arch/XMega/GPIO/GPIO.h"
+
+ /** @brief SPI master configuration object.
+  */
+ typedef struct
+ {
+	 void* Device;												/**< Pointer to SPI device object */
+	 uint32_t SPIClock;											/**< SPI clock frequency */
+ } SPIM_Config_t;
+
+ void SPIM_Init(SPIM_Config_t* Config);
+ void SPIM_SelectDevice(PORT_t* Port, const uint8_t Pin);
+ void SPIM_DeselectDevice(PORT_t* Port, const uint8_t Pin);
+ const uint8_t SPIM_SendData(SPI_t* Device, const uint8_t Data);
+
+#endif /* SPI_H_ */
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * Config_MCP2515.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Configuration file for the host tests of the MCP2515 driver.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file Config_MCP2515.h
+ *  @brief Configuration file for the host tests of the MCP2515 driver.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef CONFIG_MCP2515_H_
+#define CONFIG_MCP2515_H_
+
+ #include "Common/Common.h"
+
+ /*
+	 SPI configuration
+ */
+ #define MCP2515_INTERFACE_TYPE					INTERFACE_SPI				/**< Interface type for the MCP2515. */
+ #define MCP2515_INTERFACE						SPIC						/**< SPI interface used by the MCP2515. */
+ #define MCP2515_CLOCK							10000000UL					/**< SPI clock of the MCP2515. */
+ #define MCP2515_SS								PORTC, 4					/**< MCP2515 SS pin. */
+ #define MCP2515_INT							PORTD, 3					/**< MCP2515 interrupt pin. */
+ #define MCP2515_INT_CHANNEL					GPIO_INTERRUPT_1			/**< Interrupt channel used for the MCP2515. */
+ #define MCP2515_INT_LEVEL						INT_LVL_LO					/**< Interrupt priority. */
+ #undef MCP2515_USE_EXT_RESET												/**< Set to use an GPIO instead of the SPI as reset for the MCP2515. */
+ #undef MCP2515_USE_EXT_TX													/**< Set to use GPIO instead of the SPI to request a transmission. */
+
+ #define MCP2515_USE_RX_FIFO												/**< Set to copy all received messages into a FIFO in the interrupt handler. */
+ #define MCP2515_RX_FIFO_SIZE					16							/**< Number of messages in the receive FIFO. */
+ #define MCP2515_USE_TX_QUEUE												/**< Set to use a transmit queue which is refilled by the transmit interrupt. */
+ #define MCP2515_TX_QUEUE_SIZE					16							/**< Number of messages in the transmit queue. */
+ #define MCP2515_USE_STATISTICS												/**< Set to count the SPI traffic and the transmitted and received frames. */
+
+#endif /* CONFIG_MCP2515_H_ */
\ No newline at end of file
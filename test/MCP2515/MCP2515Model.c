@@ -0,0 +1,878 @@
+/*
+ * MCP2515Model.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: MCP2515 model for the host tests of the CAN driver.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file MCP2515Model.c
+ *  @brief MCP2515 model for the host tests of the CAN driver.
+ *
+ *  This file contains the implementation of the MCP2515 model. The simulated time only contains the SPI transfers and
+ *  the idle time of the test. The processing time of the driver isn't counted.
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <string.h>
+
+#include "MCP2515Model.h"
+
+/*
+ *	SPI instructions
+*/
+#define MODEL_CMD_WRITE							0x02
+#define MODEL_CMD_READ							0x03
+#define MODEL_CMD_BITMODIFY						0x05
+#define MODEL_CMD_READ_STATUS					0xA0
+#define MODEL_CMD_READ_RX_STATUS				0xB0
+#define MODEL_CMD_RESET							0xC0
+
+/*
+ *	Registers
+*/
+#define MODEL_CANSTAT							0x0E
+#define MODEL_CANCTRL							0x0F
+#define MODEL_TEC								0x1C
+#define MODEL_REC								0x1D
+#define MODEL_RXM0SIDH							0x20
+#define MODEL_RXM1SIDH							0x24
+#define MODEL_CNF1								0x2A
+#define MODEL_CANINTE							0x2B
+#define MODEL_CANINTF							0x2C
+#define MODEL_EFLG								0x2D
+#define MODEL_TXB0CTRL							0x30
+#define MODEL_RXB0CTRL							0x60
+#define MODEL_RXB1CTRL							0x70
+
+/*
+ *	Register bits
+*/
+#define MODEL_ABAT								(0x01 << 0x04)
+#define MODEL_ABTF								(0x01 << 0x06)
+#define MODEL_TXREQ								(0x01 << 0x03)
+#define MODEL_BUKT								(0x01 << 0x02)
+#define MODEL_EXIDE								(0x01 << 0x03)
+#define MODEL_SRR								(0x01 << 0x04)
+#define MODEL_RTR								(0x01 << 0x06)
+#define MODEL_RX0IF								(0x01 << 0x00)
+#define MODEL_RX1IF								(0x01 << 0x01)
+#define MODEL_TX0IF								(0x01 << 0x02)
+#define MODEL_ERRIF								(0x01 << 0x05)
+#define MODEL_RX0OVR							(0x01 << 0x06)
+#define MODEL_RX1OVR							(0x01 << 0x07)
+
+/** @brief	Register file, simulated time in nanoseconds and the time for one SPI byte and one CAN bit.
+ */
+static uint8_t _Registers[0x80];
+static uint64_t _Time;
+static uint32_t _ByteTime;
+static uint32_t _BitTime;
+
+/** @brief	State of the running SPI instruction.
+ */
+static bool _Selected;
+static uint8_t _Command;
+static uint8_t _Index;
+static uint8_t _Address;
+static uint8_t _Mask;
+static uint8_t _Release;
+
+/** @brief	Time of the transmission request for each transmit buffer.
+ */
+static uint64_t _Request[0x03];
+
+/** @brief	Frame on the bus. A negative source is a frame of another node.
+ */
+static bool _BusBusy;
+static uint64_t _BusFree;
+static int8_t _BusSource;
+static MCP2515_Frame_t _BusFrame;
+
+/** @brief	Frames of other nodes.
+ */
+static struct
+{
+	MCP2515_Frame_t Frame;
+	uint64_t Time;
+} _Remote[MODEL_REMOTE_FRAMES];
+static uint16_t _RemoteHead;
+static uint16_t _RemoteCount;
+
+static GPIO_Callback_t _Handler;
+static bool _InHandler;
+static Model_Callback_t _Callback;
+static Model_Statistics_t _Statistics;
+
+/** @brief	Reset the registers. A running frame of the MCP2515 is aborted.
+ */
+static void Model_Reset(void)
+{
+	memset(_Registers, 0x00, sizeof(_Registers));
+
+	// The MCP2515 starts in configuration mode with the clock output enabled
+	_Registers[MODEL_CANCTRL] = 0x87;
+	_Registers[MODEL_CANSTAT] = 0x80;
+
+	if(_BusBusy && (_BusSource >= 0x00))
+	{
+		_BusBusy = false;
+	}
+}
+
+/** @brief		Get the operation mode.
+ *  @return		Operation mode
+ */
+static MCP2515_DeviceMode_t Model_GetMode(void)
+{
+	return _Registers[MODEL_CANSTAT] >> 0x05;
+}
+
+/** @brief			Get an identifier from the register layout (SIDH, SIDL, EID8, EID0).
+ *  @param Data		Pointer to register data
+ *  @param Extended	#true for an extended identifier
+ *  @return			Identifier
+ */
+static uint32_t Model_GetIdentifier(const uint8_t* Data, const bool Extended)
+{
+	uint32_t ID = ((uint16_t)Data[0] << 0x03) | (Data[1] >> 0x05);
+
+	if(Extended)
+	{
+		ID = (ID << 0x12) | ((uint32_t)(Data[1] & 0x03) << 0x10) | ((uint16_t)Data[2] << 0x08) | Data[3];
+	}
+
+	return ID;
+}
+
+/** @brief			Check if a frame is an extended frame.
+ *  @param Frame	Pointer to frame
+ *  @return			#true for an extended frame
+ */
+static bool Model_IsExtended(const MCP2515_Frame_t* Frame)
+{
+	return (Frame->Type == MCP2515_EXTENDED_DATA) || (Frame->Type == MCP2515_EXTENDED_REMOTE);
+}
+
+/** @brief			Check if a frame is a remote frame.
+ *  @param Frame	Pointer to frame
+ *  @return			#true for a remote frame
+ */
+static bool Model_IsRemote(const MCP2515_Frame_t* Frame)
+{
+	return (Frame->Type == MCP2515_STANDARD_REMOTE) || (Frame->Type == MCP2515_EXTENDED_REMOTE);
+}
+
+/** @brief			Get the number of bits of a frame without stuff bits and with the interframe space.
+ *  @param Frame	Pointer to frame
+ *  @return			Number of bits
+ */
+static uint32_t Model_GetBits(const MCP2515_Frame_t* Frame)
+{
+	uint32_t Bits = Model_IsExtended(Frame) ? 67 : 47;
+
+	if(!Model_IsRemote(Frame))
+	{
+		Bits += Frame->Length << 0x03;
+	}
+
+	return Bits;
+}
+
+/** @brief			Get the arbitration priority of a frame. A lower value wins the arbitration.
+ *  @param Frame	Pointer to frame
+ *  @return			Priority
+ */
+static uint32_t Model_GetArbitration(const MCP2515_Frame_t* Frame)
+{
+	// A standard frame wins against an extended frame with the same base identifier
+	if(Model_IsExtended(Frame))
+	{
+		return (Frame->ID << 0x01) | 0x01;
+	}
+
+	return Frame->ID << 0x13;
+}
+
+/** @brief			Read a register.
+ *  @param Address	Register address
+ *  @return			Register value
+ */
+static uint8_t Model_Read(uint8_t Address)
+{
+	Address &= 0x7F;
+
+	// CANSTAT and CANCTRL are mapped into every register block
+	if((Address & 0x0F) == 0x0E)
+	{
+		return _Registers[MODEL_CANSTAT];
+	}
+	else if((Address & 0x0F) == 0x0F)
+	{
+		return _Registers[MODEL_CANCTRL];
+	}
+
+	return _Registers[Address];
+}
+
+/** @brief			Write a register.
+ *  @param Address	Register address
+ *  @param Value	Register value
+ */
+static void Model_Write(uint8_t Address, const uint8_t Value)
+{
+	Address &= 0x7F;
+
+	if((Address & 0x0F) == 0x0E)
+	{
+		return;
+	}
+	else if((Address & 0x0F) == 0x0F)
+	{
+		_Registers[MODEL_CANCTRL] = Value & ~MODEL_ABAT;
+
+		// Abort all pending transmissions
+		if(Value & MODEL_ABAT)
+		{
+			for(uint8_t i = 0x00; i < 0x03; i++)
+			{
+				uint8_t* Control = &_Registers[MODEL_TXB0CTRL + (i << 0x04)];
+				if(*Control & MODEL_TXREQ)
+				{
+					*Control = (*Control & ~MODEL_TXREQ) | MODEL_ABTF;
+				}
+			}
+		}
+
+		// The model changes the mode immediately
+		if((Value >> 0x05) <= MCP2515_CONFIG_MODE)
+		{
+			_Registers[MODEL_CANSTAT] = (_Registers[MODEL_CANSTAT] & 0x1F) | (Value & 0xE0);
+		}
+
+		return;
+	}
+
+	// Filters, masks and bit timing can only be changed in configuration mode
+	if((Address <= MODEL_CNF1) && ((Address >= MODEL_RXM0SIDH) || ((Address & 0x0F) < 0x0C)))
+	{
+		if(Model_GetMode() != MCP2515_CONFIG_MODE)
+		{
+			return;
+		}
+	}
+	else if((Address == MODEL_TEC) || (Address == MODEL_REC))
+	{
+		return;
+	}
+	else if((Address == MODEL_TXB0CTRL) || (Address == (MODEL_TXB0CTRL + 0x10)) || (Address == (MODEL_TXB0CTRL + 0x20)))
+	{
+		uint8_t Index = (Address - MODEL_TXB0CTRL) >> 0x04;
+
+		if((Value & MODEL_TXREQ) && !(_Registers[Address] & MODEL_TXREQ))
+		{
+			_Request[Index] = _Time;
+		}
+
+		_Registers[Address] = (_Registers[Address] & ~0x0B) | (Value & 0x0B);
+
+		return;
+	}
+
+	_Registers[Address] = Value;
+}
+
+/** @brief			Get a frame from a transmit buffer.
+ *  @param Index	Transmit buffer index
+ *  @param Frame	Pointer to frame
+ */
+static void Model_GetTxFrame(const uint8_t Index, MCP2515_Frame_t* Frame)
+{
+	const uint8_t* Buffer = &_Registers[MODEL_TXB0CTRL + (Index << 0x04) + 0x01];
+	bool Extended = Buffer[1] & MODEL_EXIDE;
+	bool Remote = Buffer[4] & MODEL_RTR;
+
+	Frame->ID = Model_GetIdentifier(Buffer, Extended);
+	Frame->Type = Extended ? (Remote ? MCP2515_EXTENDED_REMOTE : MCP2515_EXTENDED_DATA) : (Remote ? MCP2515_STANDARD_REMOTE : MCP2515_STANDARD_DATA);
+	Frame->Length = Buffer[4] & 0x0F;
+
+	if(Frame->Length > MCP2515_MAX_DATABYTES)
+	{
+		Frame->Length = MCP2515_MAX_DATABYTES;
+	}
+
+	memset(Frame->Data, 0x00, MCP2515_MAX_DATABYTES);
+	if(!Remote)
+	{
+		memcpy(Frame->Data, &Buffer[5], Frame->Length);
+	}
+}
+
+/** @brief			Check the acceptance filters of a receive buffer.
+ *  @param Buffer	Receive buffer
+ *  @param Frame	Pointer to frame
+ *  @return			#true if the frame is accepted
+ */
+static bool Model_Accept(const uint8_t Buffer, const MCP2515_Frame_t* Frame)
+{
+	const uint8_t Filters[2][4] = {{0x00, 0x04, 0x00, 0x04}, {0x08, 0x10, 0x14, 0x18}};
+	bool Extended = Model_IsExtended(Frame);
+	uint8_t Rule = (_Registers[Buffer ? MODEL_RXB1CTRL : MODEL_RXB0CTRL] >> 0x05) & 0x03;
+
+	if(Rule == MCP2515_FILTER_OFF)
+	{
+		return true;
+	}
+	else if(((Rule == MCP2515_FILTER_RECEIVE_STD) && Extended) || ((Rule == MCP2515_FILTER_RECEIVE_EXT) && !Extended))
+	{
+		return false;
+	}
+
+	uint32_t Mask = Model_GetIdentifier(&_Registers[Buffer ? MODEL_RXM1SIDH : MODEL_RXM0SIDH], Extended);
+
+	for(uint8_t i = 0x00; i < 0x04; i++)
+	{
+		const uint8_t* Filter = &_Registers[Filters[Buffer][i]];
+
+		// A filter only checks the frames with the same identifier type
+		if(((Filter[1] & MODEL_EXIDE) != 0x00) != Extended)
+		{
+			continue;
+		}
+
+		if(((Frame->ID ^ Model_GetIdentifier(Filter, Extended)) & Mask) == 0x00)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** @brief			Store a frame in a receive buffer.
+ *  @param Buffer	Receive buffer
+ *  @param Frame	Pointer to frame
+ */
+static void Model_Store(const uint8_t Buffer, const MCP2515_Frame_t* Frame)
+{
+	uint8_t* Data = &_Registers[(Buffer ? MODEL_RXB1CTRL : MODEL_RXB0CTRL) + 0x01];
+	bool Remote = Model_IsRemote(Frame);
+
+	memset(Data, 0x00, 0x0D);
+
+	if(Model_IsExtended(Frame))
+	{
+		Data[0] = Frame->ID >> 0x15;
+		Data[1] = ((Frame->ID >> 0x0D) & 0xE0) | MODEL_EXIDE | ((Frame->ID >> 0x10) & 0x03);
+		Data[2] = Frame->ID >> 0x08;
+		Data[3] = Frame->ID;
+		Data[4] = Remote ? MODEL_RTR : 0x00;
+	}
+	else
+	{
+		Data[0] = Frame->ID >> 0x03;
+		Data[1] = ((Frame->ID & 0x07) << 0x05) | (Remote ? MODEL_SRR : 0x00);
+	}
+
+	Data[4] |= Frame->Length;
+	if(!Remote)
+	{
+		memcpy(&Data[5], Frame->Data, Frame->Length);
+	}
+
+	_Registers[MODEL_CANINTF] |= Buffer ? MODEL_RX1IF : MODEL_RX0IF;
+	_Statistics.RxFrames++;
+}
+
+/** @brief			Receive a frame from the bus.
+ *  @param Frame	Pointer to frame
+ */
+static void Model_Receive(const MCP2515_Frame_t* Frame)
+{
+	uint8_t Overflow = 0x00;
+
+	if(Model_Accept(0x00, Frame))
+	{
+		if(!(_Registers[MODEL_CANINTF] & MODEL_RX0IF))
+		{
+			Model_Store(0x00, Frame);
+		}
+		else if((_Registers[MODEL_RXB0CTRL] & MODEL_BUKT) && !(_Registers[MODEL_CANINTF] & MODEL_RX1IF))
+		{
+			Model_Store(0x01, Frame);
+		}
+		else
+		{
+			Overflow = MODEL_RX0OVR;
+		}
+	}
+	else if(Model_Accept(0x01, Frame))
+	{
+		if(!(_Registers[MODEL_CANINTF] & MODEL_RX1IF))
+		{
+			Model_Store(0x01, Frame);
+		}
+		else
+		{
+			Overflow = MODEL_RX1OVR;
+		}
+	}
+	else
+	{
+		_Statistics.Rejected++;
+	}
+
+	if(Overflow)
+	{
+		_Registers[MODEL_EFLG] |= Overflow;
+		_Registers[MODEL_CANINTF] |= MODEL_ERRIF;
+		_Statistics.Overflows++;
+	}
+}
+
+/** @brief	Finish the frame on the bus.
+ */
+static void Model_Complete(void)
+{
+	MCP2515_DeviceMode_t Mode = Model_GetMode();
+
+	if(_BusSource >= 0x00)
+	{
+		uint8_t* Control = &_Registers[MODEL_TXB0CTRL + (_BusSource << 0x04)];
+
+		*Control &= ~MODEL_TXREQ;
+		_Registers[MODEL_CANINTF] |= MODEL_TX0IF << _BusSource;
+		_Statistics.TxFrames++;
+
+		if(_Callback != NULL)
+		{
+			_Callback(&_BusFrame);
+		}
+
+		if(Mode == MCP2515_LOOPBACK_MODE)
+		{
+			Model_Receive(&_BusFrame);
+		}
+	}
+	else
+	{
+		_Statistics.BusFrames++;
+
+		if((Mode == MCP2515_NORMAL_MODE) || (Mode == MCP2515_LISTEN_ONLY_MODE))
+		{
+			Model_Receive(&_BusFrame);
+		}
+	}
+}
+
+/** @brief	Transmit the frames on the bus until the simulated time is reached.
+ */
+static void Model_Bus(void)
+{
+	while(1)
+	{
+		if(_BusBusy)
+		{
+			if(_Time < _BusFree)
+			{
+				return;
+			}
+
+			_BusBusy = false;
+			Model_Complete();
+		}
+
+		// Get the pending transmit buffer with the highest priority. The buffer with the higher index wins when two
+		// buffers have the same priority.
+		MCP2515_DeviceMode_t Mode = Model_GetMode();
+		int8_t Local = -1;
+		uint64_t LocalStart = 0x00;
+		if((Mode == MCP2515_NORMAL_MODE) || (Mode == MCP2515_LOOPBACK_MODE))
+		{
+			for(int8_t i = 0x02; i >= 0x00; i--)
+			{
+				uint8_t Control = _Registers[MODEL_TXB0CTRL + (i << 0x04)];
+
+				if((Control & MODEL_TXREQ) && ((Local < 0x00) || ((Control & 0x03) > (_Registers[MODEL_TXB0CTRL + (Local << 0x04)] & 0x03))))
+				{
+					Local = i;
+				}
+			}
+
+			if(Local >= 0x00)
+			{
+				LocalStart = (_Request[Local] > _BusFree) ? _Request[Local] : _BusFree;
+			}
+		}
+
+		// Get the next frame of another node
+		bool Remote = (_RemoteCount > 0x00) && (_Remote[_RemoteHead].Time <= _Time);
+		uint64_t RemoteStart = 0x00;
+		if(Remote)
+		{
+			RemoteStart = (_Remote[_RemoteHead].Time > _BusFree) ? _Remote[_RemoteHead].Time : _BusFree;
+		}
+
+		if((Local < 0x00) && !Remote)
+		{
+			return;
+		}
+
+		// The frame which starts first gets the bus. The identifier decides when both frames start at the same time.
+		MCP2515_Frame_t Frame;
+		if(Local >= 0x00)
+		{
+			Model_GetTxFrame(Local, &Frame);
+		}
+
+		if(Remote && ((Local < 0x00) || (RemoteStart < LocalStart) || ((RemoteStart == LocalStart) &&
+		   (Model_GetArbitration(&_Remote[_RemoteHead].Frame) < Model_GetArbitration(&Frame)))))
+		{
+			_BusFrame = _Remote[_RemoteHead].Frame;
+			_BusSource = -1;
+			_BusFree = RemoteStart + Model_GetBits(&_BusFrame) * _BitTime;
+			_RemoteHead = (_RemoteHead + 0x01) % MODEL_REMOTE_FRAMES;
+			_RemoteCount--;
+		}
+		else
+		{
+			_BusFrame = Frame;
+			_BusSource = Local;
+			_BusFree = LocalStart + Model_GetBits(&_BusFrame) * _BitTime;
+		}
+
+		_BusBusy = true;
+	}
+}
+
+/** @brief			Let the simulated time pass.
+ *  @param Time		Time in nanoseconds
+ */
+static void Model_Advance(const uint32_t Time)
+{
+	_Time += Time;
+	Model_Bus();
+}
+
+/** @brief	Call the interrupt handler of the driver while the interrupt pin is active.
+ */
+static void Model_Interrupt(void)
+{
+	while((_Handler != NULL) && !_InHandler && !_Selected && (SREG & CPU_I_bm) && (_Registers[MODEL_CANINTF] & _Registers[MODEL_CANINTE]))
+	{
+		_InHandler = true;
+		SREG &= ~CPU_I_bm;
+		_Statistics.Interrupts++;
+
+		_Handler();
+
+		SREG |= CPU_I_bm;
+		_InHandler = false;
+	}
+}
+
+/** @brief		Get the response of the READ STATUS instruction.
+ *  @return		Status
+ */
+static uint8_t Model_GetStatus(void)
+{
+	uint8_t Flags = _Registers[MODEL_CANINTF];
+	uint8_t Status = Flags & (MODEL_RX1IF | MODEL_RX0IF);
+
+	for(uint8_t i = 0x00; i < 0x03; i++)
+	{
+		if(_Registers[MODEL_TXB0CTRL + (i << 0x04)] & MODEL_TXREQ)
+		{
+			Status |= 0x04 << (i << 0x01);
+		}
+
+		if(Flags & (MODEL_TX0IF << i))
+		{
+			Status |= 0x08 << (i << 0x01);
+		}
+	}
+
+	return Status;
+}
+
+/** @brief		Get the response of the RX STATUS instruction.
+ *  @return		Status
+ */
+static uint8_t Model_GetRxStatus(void)
+{
+	uint8_t Flags = _Registers[MODEL_CANINTF] & (MODEL_RX1IF | MODEL_RX0IF);
+	uint8_t Status = Flags << 0x06;
+
+	if(Flags)
+	{
+		const uint8_t* Buffer = &_Registers[((Flags & MODEL_RX0IF) ? MODEL_RXB0CTRL : MODEL_RXB1CTRL) + 0x01];
+
+		if(Buffer[1] & MODEL_EXIDE)
+		{
+			Status |= 0x10 | ((Buffer[4] & MODEL_RTR) ? 0x08 : 0x00);
+		}
+		else if(Buffer[1] & MODEL_SRR)
+		{
+			Status |= 0x08;
+		}
+	}
+
+	return Status;
+}
+
+void Model_Init(const uint32_t Bitrate)
+{
+	memset(_Request, 0x00, sizeof(_Request));
+	memset(&_Statistics, 0x00, sizeof(Model_Statistics_t));
+
+	_Time = 0x00;
+	_ByteTime = 800;
+	_BitTime = 1000000000UL / Bitrate;
+	_Selected = false;
+	_BusBusy = false;
+	_BusFree = 0x00;
+	_RemoteHead = 0x00;
+	_RemoteCount = 0x00;
+	_Handler = NULL;
+	_InHandler = false;
+	_Callback = NULL;
+
+	Model_Reset();
+}
+
+void Model_InstallCallback(const Model_Callback_t Callback)
+{
+	_Callback = Callback;
+}
+
+bool Model_Inject(const MCP2515_Frame_t* Frame, const uint64_t Time)
+{
+	if(_RemoteCount == MODEL_REMOTE_FRAMES)
+	{
+		return false;
+	}
+
+	uint16_t Index = (_RemoteHead + _RemoteCount) % MODEL_REMOTE_FRAMES;
+	_Remote[Index].Frame = *Frame;
+	_Remote[Index].Time = Time;
+	_RemoteCount++;
+
+	return true;
+}
+
+uint16_t Model_GetPending(void)
+{
+	return _RemoteCount;
+}
+
+void Model_Idle(const uint32_t Time)
+{
+	Model_Advance(Time);
+	Model_Interrupt();
+}
+
+uint64_t Model_GetTime(void)
+{
+	return _Time;
+}
+
+uint8_t Model_ReadRegister(const uint8_t Address)
+{
+	return Model_Read(Address);
+}
+
+const Model_Statistics_t* Model_GetStatistics(void)
+{
+	return &_Statistics;
+}
+
+void Model_ResetStatistics(void)
+{
+	memset(&_Statistics, 0x00, sizeof(Model_Statistics_t));
+}
+
+void SPIM_Init(SPIM_Config_t* Config)
+{
+	_ByteTime = 8000000000ULL / Config->SPIClock;
+}
+
+void SPIM_SelectDevice(PORT_t* Port, const uint8_t Pin)
+{
+	_Selected = true;
+	_Index = 0x00;
+	_Release = 0x00;
+	_Statistics.Transactions++;
+}
+
+void SPIM_DeselectDevice(PORT_t* Port, const uint8_t Pin)
+{
+	// The READ RX BUFFER instruction clears the receive flag at the end of the instruction
+	_Registers[MODEL_CANINTF] &= ~_Release;
+	_Selected = false;
+
+	Model_Interrupt();
+}
+
+const uint8_t SPIM_SendData(SPI_t* Device, const uint8_t Data)
+{
+	uint8_t Response = 0xFF;
+
+	_Statistics.SPIBytes++;
+	Model_Advance(_ByteTime);
+
+	if(!_Selected)
+	{
+		return Response;
+	}
+
+	if(_Index == 0x00)
+	{
+		_Command = Data;
+
+		if(Data == MODEL_CMD_RESET)
+		{
+			Model_Reset();
+		}
+		else if((Data & 0xF8) == 0x80)
+		{
+			// REQUEST TO SEND
+			for(uint8_t i = 0x00; i < 0x03; i++)
+			{
+				if(Data & (0x01 << i))
+				{
+					Model_Write(MODEL_TXB0CTRL + (i << 0x04), _Registers[MODEL_TXB0CTRL + (i << 0x04)] | MODEL_TXREQ);
+				}
+			}
+		}
+		else if((Data & 0xF9) == 0x90)
+		{
+			// READ RX BUFFER
+			_Address = ((Data & 0x04) ? MODEL_RXB1CTRL : MODEL_RXB0CTRL) + ((Data & 0x02) ? 0x06 : 0x01);
+			_Release = (Data & 0x04) ? MODEL_RX1IF : MODEL_RX0IF;
+		}
+		else if(((Data & 0xF8) == 0x40) && ((Data & 0x07) < 0x06))
+		{
+			// LOAD TX BUFFER
+			_Address = MODEL_TXB0CTRL + ((Data & 0x06) << 0x03) + ((Data & 0x01) ? 0x06 : 0x01);
+		}
+	}
+	else
+	{
+		switch(_Command)
+		{
+			case MODEL_CMD_READ:
+			{
+				if(_Index == 0x01)
+				{
+					_Address = Data;
+				}
+				else
+				{
+					Response = Model_Read(_Address++);
+				}
+
+				break;
+			}
+			case MODEL_CMD_WRITE:
+			{
+				if(_Index == 0x01)
+				{
+					_Address = Data;
+				}
+				else
+				{
+					Model_Write(_Address++, Data);
+				}
+
+				break;
+			}
+			case MODEL_CMD_BITMODIFY:
+			{
+				if(_Index == 0x01)
+				{
+					_Address = Data;
+				}
+				else if(_Index == 0x02)
+				{
+					_Mask = Data;
+				}
+				else if(_Index == 0x03)
+				{
+					Model_Write(_Address, (Model_Read(_Address) & ~_Mask) | (Data & _Mask));
+				}
+
+				break;
+			}
+			case MODEL_CMD_READ_STATUS:
+			{
+				Response = Model_GetStatus();
+
+				break;
+			}
+			case MODEL_CMD_READ_RX_STATUS:
+			{
+				Response = Model_GetRxStatus();
+
+				break;
+			}
+			default:
+			{
+				if((_Command & 0xF9) == 0x90)
+				{
+					Response = _Registers[_Address++ & 0x7F];
+				}
+				else if(((_Command & 0xF8) == 0x40) && ((_Command & 0x07) < 0x06))
+				{
+					Model_Write(_Address++, Data);
+				}
+
+				break;
+			}
+		}
+	}
+
+	if(_Index < 0xFF)
+	{
+		_Index++;
+	}
+
+	return Response;
+}
+
+void GPIO_SetDirection(PORT_t* Port, const uint8_t Pin, const GPIO_Direction_t Direction)
+{
+}
+
+void GPIO_Set(PORT_t* Port, const uint8_t Pin)
+{
+}
+
+void GPIO_Clear(PORT_t* Port, const uint8_t Pin)
+{
+}
+
+void GPIO_InstallCallback(GPIO_InterruptConfig_t* Config)
+{
+	_Handler = Config->Callback;
+}
+
+void GPIO_ChangeInterruptLevel(PORT_t* Port, const uint8_t Pin, const GPIO_InterruptChannel_t Channel, const Interrupt_Level_t InterruptLevel)
+{
+}
\ No newline at end of file
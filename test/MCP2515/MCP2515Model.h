@@ -0,0 +1,110 @@
+/*
+ * MCP2515Model.h
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: MCP2515 model for the host tests of the CAN driver.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file MCP2515Model.h
+ *  @brief MCP2515 model for the host tests of the CAN driver.
+ *
+ *  The model implements the SPI instructions, the register file, the transmit and receive buffers, the acceptance filters
+ *  and the interrupt flags of the MCP2515. A simulated clock advances with every SPI byte and the model transmits the
+ *  frames on a CAN bus with the configured bit rate. The model calls the interrupt handler of the driver when the
+ *  interrupt pin is active, the global interrupt flag is set and no SPI transfer is running.
+ *  Frames of other nodes are injected with #Model_Inject. The loop back mode receives the own frames only.
+ *
+ *  @author Daniel Kampert
+ */
+
+#ifndef MCP2515MODEL_H_
+#define MCP2515MODEL_H_
+
+ #include "Peripheral/MCP2515/MCP2515.h"
+
+ #define MODEL_REMOTE_FRAMES					256						/**< Number of injected frames waiting for the bus */
+
+ /** @brief Statistics of the model.
+  */
+ typedef struct
+ {
+	 uint32_t SPIBytes;											/**< Bytes sent over the SPI */
+	 uint32_t Transactions;										/**< Chip select cycles */
+	 uint32_t TxFrames;											/**< Frames transmitted by the MCP2515 */
+	 uint32_t BusFrames;										/**< Frames transmitted by other nodes */
+	 uint32_t RxFrames;											/**< Frames stored in a receive buffer */
+	 uint32_t Rejected;											/**< Frames rejected by the acceptance filters */
+	 uint32_t Overflows;										/**< Frames lost because the receive buffer was full */
+	 uint32_t Interrupts;										/**< Calls of the interrupt handler */
+ } Model_Statistics_t;
+
+ /** @brief			Callback for a transmitted frame.
+  *  @param Frame	Pointer to frame
+  */
+ typedef void (*Model_Callback_t)(const MCP2515_Frame_t* Frame);
+
+ /** @brief			Initialize the model. The registers get the reset values.
+  *  @param Bitrate	Bit rate of the CAN bus
+  */
+ void Model_Init(const uint32_t Bitrate);
+
+ /** @brief			Install a callback for the frames transmitted by the MCP2515.
+  *  @param Callback	Function pointer to callback
+  */
+ void Model_InstallCallback(const Model_Callback_t Callback);
+
+ /** @brief			Add a frame of another node to the bus.
+  *  @param Frame	Pointer to frame
+  *  @param Time	Time in nanoseconds when the frame is ready for the bus
+  *  @return		#false when the model can not store more frames
+  */
+ bool Model_Inject(const MCP2515_Frame_t* Frame, const uint64_t Time);
+
+ /** @brief		Get the number of injected frames which are waiting for the bus.
+  *  @return	Number of frames
+  */
+ uint16_t Model_GetPending(void);
+
+ /** @brief			Let the simulated time pass without a SPI transfer. The model calls the interrupt handler if needed.
+  *  @param Time	Time in nanoseconds
+  */
+ void Model_Idle(const uint32_t Time);
+
+ /** @brief		Get the simulated time.
+  *  @return	Time in nanoseconds
+  */
+ uint64_t Model_GetTime(void);
+
+ /** @brief			Read a register of the model without a SPI transfer.
+  *  @param Address	Register address
+  *  @return		Register value
+  */
+ uint8_t Model_ReadRegister(const uint8_t Address);
+
+ /** @brief		Get the statistics of the model.
+  *  @return	Pointer to statistics
+  */
+ const Model_Statistics_t* Model_GetStatistics(void);
+
+ /** @brief	Reset the statistics of the model.
+  */
+ void Model_ResetStatistics(void);
+
+#endif /* MCP2515MODEL_H_ */
\ No newline at end of file
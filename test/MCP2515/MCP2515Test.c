@@ -0,0 +1,762 @@
+/*
+ * MCP2515Test.c
+ *
+ *  Copyright (C) Daniel Kampert, 2020
+ *	Website: www.kampis-elektroecke.de
+ *  File info: Host test and benchmark for the MCP2515 driver.
+
+  GNU GENERAL PUBLIC LICENSE:
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+  Errors and commissions should be reported to DanielKampert@kampis-elektroecke.de
+ */
+
+/** @file MCP2515Test.c
+ *  @brief Host test and benchmark for the MCP2515 driver.
+ *
+ *  The test runs the driver against a register model of the MCP2515. It checks the transmit queue, the receive FIFO, the
+ *  callbacks and the filter planner with frames in loop back mode and with frames of other nodes. The benchmark measures
+ *  the frames per second, the SPI bytes per frame and the lost frames for a loop back transfer and for the reception
+ *  under a synthetic bus load. All times are simulated times. Usage:
+ *
+ *		MCP2515Test				Run the tests
+ *		MCP2515Test -b			Run the benchmark
+ *
+ *  @author Daniel Kampert
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "Peripheral/MCP2515/MCP2515.h"
+
+#include "MCP2515Model.h"
+
+/** @brief	Bit rate of the CAN bus for the tests.
+ */
+#define TEST_BITRATE					500000UL
+
+/** @brief	Number of frames for the loop back test.
+ */
+#define TEST_FRAMES						2000
+
+/** @brief	Number of frames for each benchmark.
+ */
+#define TEST_BENCHMARK_FRAMES			20000
+
+/** @brief	Idle time of the application when it has nothing to do in nanoseconds.
+ */
+#define TEST_IDLE						1000
+
+/** @brief	Max. simulated time of a test in nanoseconds.
+ */
+#define TEST_TIMEOUT					60000000000ULL
+
+/** @brief Test case.
+ */
+typedef struct
+{
+	const char* Name;										/**< Name of the test case */
+	bool (*Run)(const char* Name);							/**< Test function */
+} Test_Case_t;
+
+/** @brief Benchmark with a loop back transfer or with the frames of other nodes.
+ */
+typedef struct
+{
+	const char* Name;										/**< Name of the benchmark */
+	bool LoopBack;											/**< #true for a loop back transfer */
+	uint32_t Bitrate;										/**< Bit rate of the CAN bus */
+	uint32_t SPIClock;										/**< Clock of the SPI */
+	MCP2515_MessageType_t Type;								/**< Message type */
+	uint8_t Length;											/**< Message length */
+	uint8_t Load;											/**< Bus load of the other nodes in percent */
+} Test_Benchmark_t;
+
+/** @brief	Number of callback calls.
+ */
+static uint32_t _TxCallbacks;
+static uint32_t _RxCallbacks;
+
+static void Test_TxCallback(void)
+{
+	_TxCallbacks++;
+}
+
+static void Test_RxCallback(void)
+{
+	_RxCallbacks++;
+}
+
+/** @brief				Initialize the model and the driver.
+ *  @param LoopBack		#true for the loop back mode
+ *  @param Rollover		#true to enable the rollover mode of receive buffer 0
+ *  @param Bitrate		Bit rate of the CAN bus
+ *  @param SPIClock		Clock of the SPI
+ */
+static void Test_Init(const bool LoopBack, const bool Rollover, const uint32_t Bitrate, const uint32_t SPIClock)
+{
+	SPIM_Config_t SPIConfig = {
+		.Device = &MCP2515_INTERFACE,
+		.SPIClock = SPIClock,
+	};
+
+	MCP2515_Config_t Config = {
+		.Port = GET_PERIPHERAL(MCP2515_INT),
+		.Pin = GET_INDEX(MCP2515_INT),
+		.Channel = MCP2515_INT_CHANNEL,
+		.Source = MCP2515_RX_INTERRUPT | MCP2515_TX_INTERRUPT | MCP2515_ERROR_INTERRUPT,
+		.InterruptLevel = MCP2515_INT_LEVEL,
+		.EnableLoopBack = LoopBack,
+		.EnableRollover = Rollover,
+	};
+
+	Model_Init(Bitrate);
+	MCP2515_Init(&SPIConfig, &Config);
+	sei();
+}
+
+/** @brief			Create a test frame. The type, the identifier, the length and the data depend on the index.
+ *  @param Index	Frame index
+ *  @param Frame	Pointer to frame
+ */
+static void Test_GetFrame(const uint32_t Index, MCP2515_Frame_t* Frame)
+{
+	Frame->Type = Index & 0x03;
+	Frame->Length = Index % (MCP2515_MAX_DATABYTES + 0x01);
+
+	if((Frame->Type == MCP2515_EXTENDED_DATA) || (Frame->Type == MCP2515_EXTENDED_REMOTE))
+	{
+		Frame->ID = (Index * 0x9E3779B1UL) & 0x1FFFFFFF;
+	}
+	else
+	{
+		Frame->ID = (Index * 37) & 0x7FF;
+	}
+
+	for(uint8_t i = 0x00; i < MCP2515_MAX_DATABYTES; i++)
+	{
+		Frame->Data[i] = Index + (i * 13);
+	}
+}
+
+/** @brief				Compare two frames. The data of remote frames isn't compared.
+ *  @param Frame		Pointer to received frame
+ *  @param Expected		Pointer to expected frame
+ *  @return				#true if the frames are equal
+ */
+static bool Test_Compare(const MCP2515_Frame_t* Frame, const MCP2515_Frame_t* Expected)
+{
+	if((Frame->Type != Expected->Type) || (Frame->ID != Expected->ID) || (Frame->Length != Expected->Length))
+	{
+		return false;
+	}
+
+	if((Frame->Type == MCP2515_STANDARD_REMOTE) || (Frame->Type == MCP2515_EXTENDED_REMOTE))
+	{
+		return true;
+	}
+
+	return !memcmp(Frame->Data, Expected->Data, Frame->Length);
+}
+
+/** @brief			Let the application idle until the simulated time has passed.
+ *  @param Time		Time in nanoseconds
+ */
+static void Test_Wait(const uint64_t Time)
+{
+	uint64_t End = Model_GetTime() + Time;
+
+	while(Model_GetTime() < End)
+	{
+		Model_Idle(TEST_IDLE);
+	}
+}
+
+/** @brief		Send frames with the transmit queue in loop back mode and compare the received frames.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_Loopback(const char* Name)
+{
+	MCP2515_Frame_t Frame;
+	MCP2515_Frame_t Expected;
+	MCP2515_Statistics_t Statistics;
+	MCP2515_RxStatistics_t RxStatistics;
+	uint32_t Sent = 0x00;
+	uint32_t Received = 0x00;
+	uint32_t Wrong = 0x00;
+
+	Test_Init(true, false, TEST_BITRATE, MCP2515_CLOCK);
+
+	while((Received < TEST_FRAMES) && (Model_GetTime() < TEST_TIMEOUT))
+	{
+		Test_GetFrame(Sent, &Frame);
+		if((Sent < TEST_FRAMES) && (MCP2515_Enqueue(&Frame, MCP2515_PRIO_LOW) == MCP2515_NO_ERROR))
+		{
+			Sent++;
+		}
+		else if(MCP2515_Dequeue(&Frame))
+		{
+			Test_GetFrame(Received++, &Expected);
+			Wrong += !Test_Compare(&Frame, &Expected);
+		}
+		else
+		{
+			Model_Idle(TEST_IDLE);
+		}
+	}
+
+	MCP2515_GetStatistics(&Statistics);
+	MCP2515_GetRxStatistics(&RxStatistics);
+
+	const Model_Statistics_t* Model = Model_GetStatistics();
+	uint32_t Lost = RxStatistics.SoftwareOverflows + Model->Overflows;
+	bool Passed = (Received == TEST_FRAMES) && !Wrong && !Lost && (Statistics.SPIBytes == Model->SPIBytes) &&
+				  (Statistics.TxFrames == TEST_FRAMES) && (Statistics.RxFrames == TEST_FRAMES);
+
+	printf("%-26s %s  %5u frames  %5.1f SPI bytes per frame  %u lost  %u wrong\n", Name, Passed ? "OK  " : "FAIL",
+		   Received, (double)Model->SPIBytes / TEST_FRAMES, Lost, Wrong);
+
+	return Passed;
+}
+
+/** @brief		Queue frames with all priorities while the transmit buffers are full. The frames with the same priority
+ *				have to keep the order and the frames with a high priority have to be sent before the frames with a low
+ *				priority. The order of two neighboring priorities can change, because the CAN controller starts the next
+ *				frame before the interrupt refills the transmit buffer.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_Priorities(const char* Name)
+{
+	const MCP2515_MessagePriority_t Priority[] = {
+		MCP2515_PRIO_LOWEST, MCP2515_PRIO_LOWEST, MCP2515_PRIO_LOWEST, MCP2515_PRIO_LOW, MCP2515_PRIO_HIGHEST,
+		MCP2515_PRIO_LOW, MCP2515_PRIO_HIGH, MCP2515_PRIO_HIGHEST, MCP2515_PRIO_LOWEST, MCP2515_PRIO_HIGH,
+		MCP2515_PRIO_HIGHEST, MCP2515_PRIO_LOW,
+	};
+	const uint8_t Count = sizeof(Priority) / sizeof(Priority[0]);
+	MCP2515_Frame_t Frame;
+	uint8_t Received = 0x00;
+	uint8_t Last[MCP2515_PRIO_HIGHEST + 0x01];
+	bool Low = false;
+	bool Ordered = true;
+
+	memset(Last, 0x00, sizeof(Last));
+	memset(&Frame, 0x00, sizeof(Frame));
+	Test_Init(true, false, TEST_BITRATE, MCP2515_CLOCK);
+
+	// The first three frames are loaded into the transmit buffers immediately
+	cli();
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		Frame.ID = i + 0x01;
+		MCP2515_Enqueue(&Frame, Priority[i]);
+	}
+	sei();
+
+	while((Received < Count) && (Model_GetTime() < TEST_TIMEOUT))
+	{
+		if(!MCP2515_Dequeue(&Frame))
+		{
+			Model_Idle(TEST_IDLE);
+			continue;
+		}
+
+		uint8_t Index = Frame.ID - 0x01;
+		MCP2515_MessagePriority_t Level = Priority[Index];
+
+		// Same priority in order of the queue
+		if(Frame.ID <= Last[Level])
+		{
+			Ordered = false;
+		}
+
+		Last[Level] = Frame.ID;
+
+		// The queued frames with a high priority are sent first
+		if(Index >= 0x03)
+		{
+			if((Level >= MCP2515_PRIO_HIGH) && Low)
+			{
+				Ordered = false;
+			}
+
+			Low |= (Level <= MCP2515_PRIO_LOW);
+		}
+
+		Received++;
+	}
+
+	bool Passed = (Received == Count) && Ordered;
+
+	printf("%-26s %s  %5u frames  %s\n", Name, Passed ? "OK  " : "FAIL", Received, Ordered ? "ordered" : "wrong order");
+
+	return Passed;
+}
+
+/** @brief		Use the transmit queue while a message is prepared with #MCP2515_PrepareMessage. The queue must not use
+ *				the prepared buffer.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_Prepare(const char* Name)
+{
+	uint8_t Data[MCP2515_MAX_DATABYTES] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+	CAN_Message_t Message = {
+		.Type = MCP2515_STANDARD_DATA,
+		.ID = 0x7AA,
+		.Length = MCP2515_MAX_DATABYTES,
+		.pData = Data,
+	};
+	MCP2515_Frame_t Frame;
+	MCP2515_Frame_t Expected;
+	uint8_t Prepared = 0x00;
+	uint8_t Queued = 0x00;
+	uint8_t Wrong = 0x00;
+
+	Test_Init(true, false, TEST_BITRATE, MCP2515_CLOCK);
+
+	cli();
+	bool Loaded = MCP2515_PrepareMessage(&Message, MCP2515_PRIO_HIGHEST) == MCP2515_NO_ERROR;
+	for(uint8_t i = 0x00; i < 0x03; i++)
+	{
+		Test_GetFrame(0x08 + i, &Frame);
+		MCP2515_Enqueue(&Frame, MCP2515_PRIO_LOW);
+	}
+
+	MCP2515_RequestTransmission(MCP2515_TX0);
+	sei();
+
+	Test_Wait(10000000);
+
+	while(MCP2515_Dequeue(&Frame))
+	{
+		if(Frame.ID == Message.ID)
+		{
+			Prepared++;
+			Wrong += (Frame.Length != Message.Length) || memcmp(Frame.Data, Data, Message.Length);
+		}
+		else
+		{
+			Test_GetFrame(0x08 + Queued++, &Expected);
+			Wrong += !Test_Compare(&Frame, &Expected);
+		}
+	}
+
+	bool Passed = Loaded && (Prepared == 0x01) && (Queued == 0x03) && !Wrong;
+
+	printf("%-26s %s  %5u prepared  %u queued  %u wrong\n", Name, Passed ? "OK  " : "FAIL", Prepared, Queued, Wrong);
+
+	return Passed;
+}
+
+/** @brief		Install the transmit and the receive callback with #MCP2515_InstallCallback.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_Callbacks(const char* Name)
+{
+	MCP2515_Config_t Config = {
+		.Source = MCP2515_TX_INTERRUPT,
+		.RxCallback = Test_RxCallback,
+		.TxCallback = Test_TxCallback,
+	};
+	MCP2515_Frame_t Frame;
+
+	Test_Init(false, false, TEST_BITRATE, MCP2515_CLOCK);
+
+	// Only the transmit callback is installed and only the own frames are on the bus
+	MCP2515_InstallCallback(&Config);
+	for(uint8_t i = 0x00; i < 0x08; i++)
+	{
+		Test_GetFrame(i, &Frame);
+		MCP2515_Enqueue(&Frame, MCP2515_PRIO_LOW);
+	}
+
+	Test_Wait(10000000);
+	uint32_t Transmit = _TxCallbacks;
+	bool Separated = !_RxCallbacks;
+
+	// Receive frames of other nodes with both callbacks
+	Config.Source = MCP2515_RX_INTERRUPT;
+	MCP2515_InstallCallback(&Config);
+	for(uint8_t i = 0x00; i < 0x08; i++)
+	{
+		Test_GetFrame(i, &Frame);
+		Model_Inject(&Frame, Model_GetTime());
+	}
+
+	Test_Wait(10000000);
+	Separated &= (_TxCallbacks == Transmit);
+
+	bool Passed = Transmit && _RxCallbacks && Separated;
+
+	printf("%-26s %s  %5u transmit callbacks  %u receive callbacks\n", Name, Passed ? "OK  " : "FAIL", _TxCallbacks,
+		   _RxCallbacks);
+
+	return Passed;
+}
+
+/** @brief		Receive more frames than the receive FIFO can store without reading the FIFO.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_SoftwareOverflow(const char* Name)
+{
+	const uint8_t Count = 64;
+	MCP2515_Frame_t Frame;
+	MCP2515_Frame_t Expected;
+	MCP2515_RxStatistics_t Statistics;
+	uint8_t Received = 0x00;
+	uint8_t Wrong = 0x00;
+
+	Test_Init(false, false, TEST_BITRATE, MCP2515_CLOCK);
+
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		Test_GetFrame(i, &Frame);
+		Model_Inject(&Frame, 0x00);
+	}
+
+	Test_Wait(100000000);
+	MCP2515_GetRxStatistics(&Statistics);
+
+	// The FIFO keeps the oldest frames
+	while(MCP2515_Dequeue(&Frame))
+	{
+		Test_GetFrame(Received++, &Expected);
+		Wrong += !Test_Compare(&Frame, &Expected);
+	}
+
+	bool Passed = (Received == (MCP2515_RX_FIFO_SIZE - 0x01)) && (Statistics.Frames == Received) &&
+				  (Statistics.SoftwareOverflows == (Count - Received)) && !Model_GetStatistics()->Overflows && !Wrong;
+
+	printf("%-26s %s  %5u frames  %u software overflows  %u wrong\n", Name, Passed ? "OK  " : "FAIL", Received,
+		   Statistics.SoftwareOverflows, Wrong);
+
+	return Passed;
+}
+
+/** @brief		Receive frames while the interrupts are disabled. Both receive buffers are used with the rollover mode
+ *				and the driver has to read receive buffer 0 first.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_HardwareOverflow(const char* Name)
+{
+	const uint8_t Count = 8;
+	MCP2515_Frame_t Frame;
+	MCP2515_Frame_t Expected;
+	MCP2515_RxStatistics_t Statistics;
+	uint8_t Received = 0x00;
+	uint8_t Wrong = 0x00;
+
+	Test_Init(false, true, TEST_BITRATE, MCP2515_CLOCK);
+
+	cli();
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		Test_GetFrame(i, &Frame);
+		Model_Inject(&Frame, 0x00);
+	}
+
+	Test_Wait(10000000);
+	sei();
+	Test_Wait(1000000);
+
+	MCP2515_GetRxStatistics(&Statistics);
+	while(MCP2515_Dequeue(&Frame))
+	{
+		Test_GetFrame(Received++, &Expected);
+		Wrong += !Test_Compare(&Frame, &Expected);
+	}
+
+	uint32_t Lost = Model_GetStatistics()->Overflows;
+	bool Passed = (Received == 0x02) && (Lost == (Count - 0x02)) && Statistics.HardwareOverflows &&
+				  !(Model_ReadRegister(0x2D) & 0xC0) && !Wrong;
+
+	printf("%-26s %s  %5u frames  %u lost  %u hardware overflows  %u wrong\n", Name, Passed ? "OK  " : "FAIL", Received,
+		   Lost, Statistics.HardwareOverflows, Wrong);
+
+	return Passed;
+}
+
+/** @brief			Check if an identifier is part of the identifier ranges.
+ *  @param ID		Identifier
+ *  @param Ranges	Pointer to list of identifier ranges
+ *  @param Count	Number of identifier ranges
+ *  @return			#true if the identifier is wanted
+ */
+static bool Test_IsWanted(const uint32_t ID, const MCP2515_IDRange_t* Ranges, const uint8_t Count)
+{
+	for(uint8_t i = 0x00; i < Count; i++)
+	{
+		if((ID >= Ranges[i].Start) && (ID <= Ranges[i].End))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** @brief				Program a filter plan and send identifiers to the CAN controller. All wanted identifiers have to be
+ *						received. When all identifiers are sent, the number of received identifiers has to match the plan.
+ *  @param Name			Name of the test
+ *  @param Ranges		Pointer to list of identifier ranges
+ *  @param Count		Number of identifier ranges
+ *  @param UseExtended	#true for extended identifiers
+ *  @param First		First identifier of the test
+ *  @param Total		Number of identifiers of the test
+ *  @return				#true when the test is passed
+ */
+static bool Test_Filter(const char* Name, const MCP2515_IDRange_t* Ranges, const uint8_t Count, const bool UseExtended,
+						const uint32_t First, const uint32_t Total)
+{
+	MCP2515_FilterPlan_t Plan;
+	MCP2515_Frame_t Frame;
+	uint32_t Sent = 0x00;
+	uint32_t Wanted = 0x00;
+	uint32_t Received = 0x00;
+	uint32_t Accepted = 0x00;
+
+	Test_Init(false, false, TEST_BITRATE, MCP2515_CLOCK);
+
+	bool Planned = MCP2515_PlanFilters(Ranges, Count, UseExtended, &Plan) == MCP2515_NO_ERROR;
+
+	memset(&Frame, 0x00, sizeof(Frame));
+	Frame.Type = UseExtended ? MCP2515_EXTENDED_DATA : MCP2515_STANDARD_DATA;
+
+	for(uint32_t i = 0x00; i < Total; i++)
+	{
+		Wanted += Test_IsWanted(First + i, Ranges, Count);
+	}
+
+	while(Model_GetTime() < TEST_TIMEOUT)
+	{
+		if((Sent < Total) && (Model_GetPending() < MODEL_REMOTE_FRAMES))
+		{
+			Frame.ID = First + Sent++;
+			Model_Inject(&Frame, Model_GetTime());
+		}
+		else if(MCP2515_Dequeue(&Frame))
+		{
+			Accepted++;
+			Received += Test_IsWanted(Frame.ID, Ranges, Count);
+		}
+		else if((Sent == Total) && !Model_GetPending())
+		{
+			break;
+		}
+		else
+		{
+			Model_Idle(TEST_IDLE);
+		}
+	}
+
+	Test_Wait(1000000);
+	while(MCP2515_Dequeue(&Frame))
+	{
+		Accepted++;
+		Received += Test_IsWanted(Frame.ID, Ranges, Count);
+	}
+
+	bool Passed = Planned && (Received == Wanted);
+
+	// All standard identifiers are sent, so the accepted identifiers have to match the plan
+	if(!UseExtended)
+	{
+		Passed &= (Accepted == Plan.Accepted) && (Plan.Wanted == Wanted);
+	}
+
+	printf("%-26s %s  %5u wanted  %u received  %u accepted  %u.%u %% false accepts\n", Name, Passed ? "OK  " : "FAIL",
+		   Wanted, Received, Accepted, Plan.FalseAcceptRatio / 10, Plan.FalseAcceptRatio % 10);
+
+	return Passed;
+}
+
+/** @brief		Filter plan for standard identifiers.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_StandardFilter(const char* Name)
+{
+	const MCP2515_IDRange_t Ranges[] = {
+		{ .Start = 0x100, .End = 0x10F },
+		{ .Start = 0x120, .End = 0x123 },
+		{ .Start = 0x181, .End = 0x181 },
+		{ .Start = 0x7F0, .End = 0x7FF },
+	};
+
+	return Test_Filter(Name, Ranges, sizeof(Ranges) / sizeof(Ranges[0]), false, 0x00, 0x800);
+}
+
+/** @brief		Filter plan for overlapping and unsorted standard identifiers.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_OverlappingFilter(const char* Name)
+{
+	const MCP2515_IDRange_t Ranges[] = {
+		{ .Start = 0x120, .End = 0x12F },
+		{ .Start = 0x100, .End = 0x123 },
+		{ .Start = 0x110, .End = 0x117 },
+		{ .Start = 0x130, .End = 0x130 },
+		{ .Start = 0x124, .End = 0x124 },
+	};
+
+	return Test_Filter(Name, Ranges, sizeof(Ranges) / sizeof(Ranges[0]), false, 0x00, 0x800);
+}
+
+/** @brief		Filter plan for extended identifiers.
+ *  @param Name	Name of the test
+ *  @return		#true when the test is passed
+ */
+static bool Test_ExtendedFilter(const char* Name)
+{
+	const MCP2515_IDRange_t Ranges[] = {
+		{ .Start = 0x18FEF100, .End = 0x18FEF1FF },
+		{ .Start = 0x0CF00400, .End = 0x0CF00403 },
+	};
+
+	return Test_Filter(Name, Ranges, sizeof(Ranges) / sizeof(Ranges[0]), true, 0x0CF00000, 0x800);
+}
+
+/** @brief				Run a benchmark. The loop back benchmark keeps the transmit queue full and the receive benchmark
+ *						sends frames of other nodes with the given bus load.
+ *  @param Benchmark	Pointer to benchmark
+ *  @return				#true when the benchmark is finished
+ */
+static bool Test_Benchmark(const Test_Benchmark_t* Benchmark)
+{
+	MCP2515_Frame_t Frame;
+	MCP2515_RxStatistics_t Statistics;
+	uint32_t Sent = 0x00;
+	uint32_t Received = 0x00;
+	uint64_t Last = 0x00;
+
+	Test_Init(Benchmark->LoopBack, true, Benchmark->Bitrate, Benchmark->SPIClock);
+	Model_ResetStatistics();
+
+	memset(&Frame, 0x00, sizeof(Frame));
+	Frame.Type = Benchmark->Type;
+	Frame.Length = Benchmark->Length;
+
+	// Bits of a frame without stuff bits
+	uint32_t Bits = (((Frame.Type == MCP2515_EXTENDED_DATA) || (Frame.Type == MCP2515_EXTENDED_REMOTE)) ? 67 : 47) +
+					(Frame.Length << 0x03);
+	uint64_t Interval = Benchmark->Load ? ((uint64_t)Bits * 100000000000ULL) / ((uint64_t)Benchmark->Bitrate * Benchmark->Load) : 0x00;
+
+	while(Model_GetTime() < TEST_TIMEOUT)
+	{
+		Frame.ID = Sent & 0x7FF;
+
+		if((Sent < TEST_BENCHMARK_FRAMES) && Benchmark->LoopBack && (MCP2515_Enqueue(&Frame, MCP2515_PRIO_LOW) == MCP2515_NO_ERROR))
+		{
+			Sent++;
+		}
+		else if((Sent < TEST_BENCHMARK_FRAMES) && !Benchmark->LoopBack && (Model_GetPending() < MODEL_REMOTE_FRAMES))
+		{
+			Model_Inject(&Frame, Sent++ * Interval);
+		}
+		else if(MCP2515_Dequeue(&Frame))
+		{
+			Received++;
+			Last = Model_GetTime();
+		}
+		else if((Sent == TEST_BENCHMARK_FRAMES) && !Model_GetPending() && ((Model_GetTime() - Last) > 10000000))
+		{
+			break;
+		}
+		else
+		{
+			Model_Idle(TEST_IDLE);
+		}
+	}
+
+	MCP2515_GetRxStatistics(&Statistics);
+
+	const Model_Statistics_t* Model = Model_GetStatistics();
+	uint32_t Lost = Statistics.SoftwareOverflows + Model->Overflows;
+
+	printf("%-26s %8.0f frames/s  %5.1f SPI bytes/frame  %4.2f interrupts/frame  %u lost\n", Benchmark->Name,
+		   (double)Received * 1e9 / (double)Last, (double)Model->SPIBytes / Received, (double)Model->Interrupts / Received,
+		   Lost);
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const Test_Case_t Cases[] = {
+		{ "Loop back", Test_Loopback },
+		{ "Priorities", Test_Priorities },
+		{ "Prepare and queue", Test_Prepare },
+		{ "Callbacks", Test_Callbacks },
+		{ "Software overflow", Test_SoftwareOverflow },
+		{ "Hardware overflow", Test_HardwareOverflow },
+		{ "Standard filter", Test_StandardFilter },
+		{ "Overlapping filter", Test_OverlappingFilter },
+		{ "Extended filter", Test_ExtendedFilter },
+	};
+
+	const Test_Benchmark_t Benchmarks[] = {
+		{ "Loop back 0 bytes", true, 1000000, MCP2515_CLOCK, MCP2515_STANDARD_DATA, 0, 0 },
+		{ "Loop back 8 bytes", true, 1000000, MCP2515_CLOCK, MCP2515_STANDARD_DATA, 8, 0 },
+		{ "Loop back 8 bytes ext.", true, 1000000, MCP2515_CLOCK, MCP2515_EXTENDED_DATA, 8, 0 },
+		{ "Receive 50 % @ 1 MHz SPI", false, 1000000, 1000000, MCP2515_STANDARD_DATA, 8, 50 },
+		{ "Receive 100 % @ 1 MHz SPI", false, 1000000, 1000000, MCP2515_STANDARD_DATA, 8, 100 },
+		{ "Receive 100 % @ 10 MHz SPI", false, 1000000, MCP2515_CLOCK, MCP2515_STANDARD_DATA, 8, 100 },
+	};
+
+	bool Passed = true;
+	int Status;
+
+	if((argc > 1) && !strcmp(argv[1], "-b"))
+	{
+		for(uint8_t i = 0x00; i < (sizeof(Benchmarks) / sizeof(Benchmarks[0])); i++)
+		{
+			fflush(stdout);
+			pid_t Process = fork();
+			if(Process == 0)
+			{
+				exit(Test_Benchmark(&Benchmarks[i]) ? 0 : 1);
+			}
+
+			waitpid(Process, &Status, 0);
+		}
+
+		return 0;
+	}
+
+	// The driver keeps its state in static variables, so each test runs in a new process
+	for(uint8_t i = 0x00; i < (sizeof(Cases) / sizeof(Cases[0])); i++)
+	{
+		fflush(stdout);
+		pid_t Process = fork();
+		if(Process == 0)
+		{
+			exit(Cases[i].Run(Cases[i].Name) ? 0 : 1);
+		}
+
+		waitpid(Process, &Status, 0);
+		Passed &= WIFEXITED(Status) && (WEXITSTATUS(Status) == 0);
+	}
+
+	return Passed ? 0 : 1;
+}
\ No newline at end of file